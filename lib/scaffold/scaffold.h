@@ -1,5 +1,14 @@
 
 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
 void sysinit(void); 
 void libinit(void);
 void init(void);
+
+#ifdef __cplusplus
+}
+#endif /* extern "C" */
@@ -0,0 +1,93 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file alias.c
+ * @brief Register aliases
+ *
+ */
+
+#include <string.h>
+#include "alias.h"
+
+#if UCDM_ALIAS_ENABLE
+
+ucdm_alias_t ucdm_alias[UCDM_ALIAS_MAX_COUNT];
+uint8_t ucdm_alias_count;
+
+void _ucdm_alias_init(void){
+    memset(&ucdm_alias, 0, sizeof(ucdm_alias));
+    ucdm_alias_count = 0;
+}
+
+uint16_t _ucdm_alias_run(ucdm_addr_t addr, uint16_t count, ucdm_addr_t * caddr){
+    uint32_t end = (uint32_t)addr + count;
+    for (uint8_t i=0; i < ucdm_alias_count; i++){
+        ucdm_alias_t * alias = &ucdm_alias[i];
+        if ((ucdm_addr_t)(addr - alias->saddr) < alias->count){
+            uint32_t aend = (uint32_t)alias->saddr + alias->count;
+            *caddr = (ucdm_addr_t)(addr + alias->offset);
+            return ((aend < end) ? aend : end) - addr;
+        }
+        if (alias->saddr > addr && alias->saddr < end){
+            end = alias->saddr;
+        }
+    }
+    *caddr = addr;
+    return end - addr;
+}
+
+static inline uint8_t _ucdm_alias_overlap(uint32_t a, uint32_t acount, 
+                                          uint32_t b, uint32_t bcount){
+    return (a < b + bcount) && (b < a + acount);
+}
+
+HAL_BASE_t ucdm_install_alias(ucdm_addr_t saddr, ucdm_addr_t count, ucdm_addr_t caddr){
+    if ((uint32_t)saddr + count > UCDM_MAX_REGISTERS || 
+            (uint32_t)caddr + count > UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    if (!count || _ucdm_alias_overlap(saddr, count, caddr, count)){
+        return 2;
+    }
+    // Canonical ranges may be shared between aliases, but nothing may 
+    // resolve onto an alias.
+    for (uint8_t i=0; i < ucdm_alias_count; i++){
+        uint32_t asaddr = ucdm_alias[i].saddr;
+        uint32_t acaddr = (ucdm_addr_t)(asaddr + ucdm_alias[i].offset);
+        uint32_t acount = ucdm_alias[i].count;
+        if (_ucdm_alias_overlap(saddr, count, asaddr, acount) || 
+                _ucdm_alias_overlap(saddr, count, acaddr, acount) || 
+                _ucdm_alias_overlap(caddr, count, asaddr, acount)){
+            return 2;
+        }
+    }
+    if (ucdm_alias_count >= UCDM_ALIAS_MAX_COUNT){
+        return 3;
+    }
+    ucdm_alias[ucdm_alias_count].saddr = saddr;
+    ucdm_alias[ucdm_alias_count].count = count;
+    ucdm_alias[ucdm_alias_count].offset = (ucdm_addr_t)(caddr - saddr);
+    ucdm_alias_count++;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,122 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file alias.h
+ * @brief Register aliases
+ * 
+ * Devices often expose the same value at several addresses, for instance 
+ * to keep a legacy register map alongside a new one. Without aliases, the 
+ * redirections and handlers of every such register have to be configured 
+ * once for each address, and a write through one address does not run 
+ * the handlers configured on the other. 
+ * 
+ * An alias maps a range of register addresses onto a canonical range of 
+ * the same length. Protocol accesses to an alias address are resolved to 
+ * the canonical register before anything else is done, with a bounds 
+ * check and an add per installed alias. Everything else, including the 
+ * access type, redirection, validation, post-write handlers, statistics, 
+ * diagnostics and trace records, then follows the canonical register. 
+ * Only the canonical registers need to be configured. Any configuration 
+ * of the alias addresses themselves is shadowed by the alias. 
+ * 
+ * Bulk accesses and range permission checks spanning alias and ordinary 
+ * addresses are split into runs of consecutive canonical registers, so 
+ * that block functions and views on the canonical range are used as 
+ * usual. 
+ * 
+ * Alias ranges may not overlap each other, their own canonical range, or 
+ * the canonical range of another alias, so that resolution never needs 
+ * more than one step. Accesses made from within UCDM subsystems using 
+ * _ucdm_get_register, _ucdm_set_register and _ucdm_write_bit are also 
+ * resolved. Up to APP_UCDM_ALIAS_MAX_COUNT aliases can be installed. 
+ */
+
+#ifndef UCDM_ALIAS_H
+#define UCDM_ALIAS_H
+
+#include "ucdm.h"
+
+#if UCDM_ALIAS_ENABLE
+
+typedef struct UCDM_ALIAS_t{
+    ucdm_addr_t saddr;
+    ucdm_addr_t count;
+    // Canonical address less alias address, modulo the address width.
+    ucdm_addr_t offset;
+} ucdm_alias_t;
+
+extern ucdm_alias_t ucdm_alias[];
+extern uint8_t ucdm_alias_count;
+
+void _ucdm_alias_init(void);
+
+/**
+ * \brief Resolve a register address to its canonical register.
+ * 
+ * @param addr Address/identifier of the register.
+ * @return The canonical register, or addr if it is not an alias.
+ */
+static inline ucdm_addr_t _ucdm_alias_resolve(ucdm_addr_t addr){
+    for (uint8_t i=0; i < ucdm_alias_count; i++){
+        if ((ucdm_addr_t)(addr - ucdm_alias[i].saddr) < ucdm_alias[i].count){
+            return (ucdm_addr_t)(addr + ucdm_alias[i].offset);
+        }
+    }
+    return addr;
+}
+
+/**
+ * \brief Resolve a bit address to the corresponding bit of its 
+ *        canonical register.
+ */
+static inline ucdm_addrb_t _ucdm_alias_resolve_bit(ucdm_addrb_t addrb){
+    if (addrb >= UCDM_MAX_BITS){
+        return addrb;
+    }
+    return ((ucdm_addrb_t)_ucdm_alias_resolve(addrb >> 4) << 4) | (addrb & 15);
+}
+
+/**
+ * \brief Get the leading run of a range of registers which resolves to 
+ *        consecutive canonical registers.
+ * 
+ * @param addr Address/identifier of the first register of the range.
+ * @param count Number of registers in the range, at least 1.
+ * @param caddr Pointer to where the first canonical register of the run 
+ *              should be stored.
+ * @return Number of registers in the run.
+ */
+uint16_t _ucdm_alias_run(ucdm_addr_t addr, uint16_t count, ucdm_addr_t * caddr);
+
+/**
+ * \brief Install an alias for a range of registers.
+ * 
+ * @param saddr Address/identifier of the first register of the alias.
+ * @param count Number of registers in the alias.
+ * @param caddr Address/identifier of the first canonical register.
+ * @return 0 for success, 1 for either range out of range, 2 for a bad 
+ *         count or overlapping ranges, 3 if no free slots.
+ */
+HAL_BASE_t ucdm_install_alias(ucdm_addr_t saddr, ucdm_addr_t count, ucdm_addr_t caddr);
+
+#endif
+#endif
@@ -0,0 +1,366 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file async.c
+ * @brief Asynchronous completion for slow function registers
+ *
+ */
+
+#include "async.h"
+#include "trace.h"
+#include "diag.h"
+#include "alias.h"
+
+#if UCDM_ASYNC_ENABLE
+
+// Slot states
+#define UCDM_ASYNC_SLOT_FREE        0x00
+#define UCDM_ASYNC_SLOT_PENDING     0x01
+#define UCDM_ASYNC_SLOT_DONE        0x02
+
+// Slot flags
+// The start function has not returned yet. Completion is left to the caller.
+#define UCDM_ASYNC_FLAG_STARTING    0x01
+// Started by the synchronous API. Nobody waits for the result.
+#define UCDM_ASYNC_FLAG_DETACHED    0x02
+
+typedef struct UCDM_ASYNC_SLOT_t{
+    uint8_t state;
+    uint8_t flags;
+    uint8_t generation;
+    HAL_BASE_t status;
+    uint16_t value;
+    ucdm_async_t * reg;
+    ucdm_async_cb_t cb;
+    void * ctx;
+} ucdm_async_slot_t;
+
+ucdm_async_t ucdm_asyncs[UCDM_ASYNC_MAX_COUNT];
+uint8_t ucdm_async_count;
+
+static ucdm_async_slot_t ucdm_async_slots[UCDM_ASYNC_MAX_PENDING];
+
+void _ucdm_async_init(void){
+    ucdm_async_count = 0;
+    for (uint8_t i=0; i < UCDM_ASYNC_MAX_PENDING; i++){
+        ucdm_async_slots[i].state = UCDM_ASYNC_SLOT_FREE;
+    }
+}
+
+static ucdm_async_t * _ucdm_async_find(ucdm_addr_t addr, uint8_t type){
+    for (uint8_t i=0; i < ucdm_async_count; i++){
+        if (ucdm_asyncs[i].addr == addr && ucdm_asyncs[i].type == type){
+            return &ucdm_asyncs[i];
+        }
+    }
+    return NULL;
+}
+
+static ucdm_async_t * _ucdm_async_create(ucdm_addr_t addr, uint8_t type, HAL_BASE_t * rval){
+    if (addr >= UCDM_MAX_REGISTERS){
+        *rval = 1;
+        return NULL;
+    }
+    ucdm_async_t * reg = _ucdm_async_find(addr, type);
+    if (reg){
+        *rval = 0;
+        return reg;
+    }
+    if (ucdm_async_count >= UCDM_ASYNC_MAX_COUNT){
+        *rval = 2;
+        return NULL;
+    }
+    reg = &ucdm_asyncs[ucdm_async_count++];
+    reg->addr = addr;
+    reg->type = type;
+    reg->last = 0xFFFF;
+    *rval = 0;
+    return reg;
+}
+
+static inline ucdm_async_token_t _ucdm_async_token(uint8_t idx){
+    return ((ucdm_async_token_t)ucdm_async_slots[idx].generation << 8) | idx;
+}
+
+static ucdm_async_slot_t * _ucdm_async_slot(ucdm_async_token_t token){
+    uint8_t idx = token & 0xFF;
+    if (idx >= UCDM_ASYNC_MAX_PENDING){
+        return NULL;
+    }
+    ucdm_async_slot_t * slot = &ucdm_async_slots[idx];
+    if (slot->state == UCDM_ASYNC_SLOT_FREE || slot->generation != (token >> 8)){
+        return NULL;
+    }
+    return slot;
+}
+
+static uint8_t _ucdm_async_outstanding(ucdm_async_t * reg){
+    for (uint8_t i=0; i < UCDM_ASYNC_MAX_PENDING; i++){
+        if (ucdm_async_slots[i].state == UCDM_ASYNC_SLOT_PENDING && 
+                ucdm_async_slots[i].reg == reg){
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static HAL_BASE_t _ucdm_async_start(ucdm_async_t * reg, uint16_t value, uint8_t flags,
+                                    ucdm_async_cb_t cb, void * ctx, 
+                                    uint16_t * result, ucdm_async_token_t * token){
+    uint8_t idx;
+    for (idx=0; idx < UCDM_ASYNC_MAX_PENDING; idx++){
+        if (ucdm_async_slots[idx].state == UCDM_ASYNC_SLOT_FREE){
+            break;
+        }
+    }
+    if (idx == UCDM_ASYNC_MAX_PENDING){
+        return UCDM_ASYNC_BUSY;
+    }
+    ucdm_async_slot_t * slot = &ucdm_async_slots[idx];
+    slot->generation++;
+    if (!slot->generation){
+        slot->generation = 1;
+    }
+    slot->state = UCDM_ASYNC_SLOT_PENDING;
+    slot->flags = flags | UCDM_ASYNC_FLAG_STARTING;
+    slot->reg = reg;
+    slot->value = value;
+    slot->cb = cb;
+    slot->ctx = ctx;
+    
+    ucdm_async_token_t t = _ucdm_async_token(idx);
+    if (reg->type == UCDM_ASYNC_TYPE_READ){
+        reg->target.rfunc(reg->addr, t);
+    } else {
+        reg->target.wfunc(reg->addr, value, t);
+    }
+    slot->flags &= ~UCDM_ASYNC_FLAG_STARTING;
+    
+    if (slot->state == UCDM_ASYNC_SLOT_PENDING){
+        *token = t;
+        return UCDM_ASYNC_PENDING;
+    }
+    // Completed from within the start function
+    HAL_BASE_t status = slot->status;
+    if (result){
+        *result = slot->value;
+    }
+    slot->state = UCDM_ASYNC_SLOT_FREE;
+    return status;
+}
+
+static uint16_t _ucdm_async_read_last(ucdm_addr_t addr){
+    // Synchronous reads get the last completed value, and refresh it in 
+    // the background.
+    ucdm_async_token_t token;
+    ucdm_async_t * reg = _ucdm_async_find(addr, UCDM_ASYNC_TYPE_READ);
+    if (!reg){
+        return 0xFFFF;
+    }
+    if (!_ucdm_async_outstanding(reg)){
+        _ucdm_async_start(reg, 0, UCDM_ASYNC_FLAG_DETACHED, NULL, NULL, NULL, &token);
+    }
+    return reg->last;
+}
+
+static void _ucdm_async_write_detached(ucdm_addr_t addr, uint16_t value){
+    ucdm_async_token_t token;
+    ucdm_async_t * reg = _ucdm_async_find(addr, UCDM_ASYNC_TYPE_WRITE);
+    if (!reg){
+        return;
+    }
+    if (_ucdm_async_start(reg, value, UCDM_ASYNC_FLAG_DETACHED, NULL, NULL, NULL, &token) == UCDM_ASYNC_BUSY){
+        #if UCDM_ENABLE_DIAGNOSTICS
+        _ucdm_diag_exception(UCDM_EXCEPTION_DEVICE_FAILURE);
+        #endif
+    }
+}
+
+HAL_BASE_t ucdm_redirect_regr_async(ucdm_addr_t addr, ucdm_async_rfunc_t target){
+    HAL_BASE_t rval;
+    ucdm_async_t * reg = _ucdm_async_create(addr, UCDM_ASYNC_TYPE_READ, &rval);
+    if (!reg){
+        return rval;
+    }
+    reg->target.rfunc = target;
+    return ucdm_redirect_regr_func(addr, &_ucdm_async_read_last);
+}
+
+HAL_BASE_t ucdm_redirect_regw_async(ucdm_addr_t addr, ucdm_async_wfunc_t target){
+    HAL_BASE_t rval;
+    ucdm_async_t * reg = _ucdm_async_create(addr, UCDM_ASYNC_TYPE_WRITE, &rval);
+    if (!reg){
+        return rval;
+    }
+    reg->target.wfunc = target;
+    return ucdm_redirect_regw_func(addr, &_ucdm_async_write_detached);
+}
+
+HAL_BASE_t ucdm_get_register_async(ucdm_addr_t addr, uint16_t * value, 
+                                   ucdm_async_cb_t cb, void * ctx, 
+                                   ucdm_async_token_t * token){
+    #if UCDM_ALIAS_ENABLE
+    addr = _ucdm_alias_resolve(addr);
+    #endif
+    if (addr >= UCDM_MAX_REGISTERS || !(ucdm_acctype[addr] & UCDM_AT_READ_MASK)){
+        // Let the synchronous path account for the rejected access.
+        ucdm_get_register(addr);
+        return UCDM_ASYNC_REJECTED;
+    }
+    if ((ucdm_acctype[addr] & UCDM_AT_READ_MASK) != UCDM_AT_READ_FUNC ||
+            ucdm_register[addr].rfunc != &_ucdm_async_read_last){
+        *value = ucdm_get_register(addr);
+        return UCDM_ASYNC_OK;
+    }
+    ucdm_async_t * reg = _ucdm_async_find(addr, UCDM_ASYNC_TYPE_READ);
+    HAL_BASE_t rval = _ucdm_async_start(reg, 0, 0, cb, ctx, value, token);
+    #if UCDM_ENABLE_DIAGNOSTICS
+    uint16_t exceptions = _ucdm_diag_message_begin();
+    _ucdm_diag_read(0);
+    if (rval == UCDM_ASYNC_FAILED || rval == UCDM_ASYNC_BUSY){
+        _ucdm_diag_exception(UCDM_EXCEPTION_DEVICE_FAILURE);
+    }
+    _ucdm_diag_message_end(exceptions);
+    #endif
+    #if UCDM_TRACE_ENABLE
+    // The value is only set once the read has completed.
+    if (rval == UCDM_ASYNC_OK || rval == UCDM_ASYNC_FAILED){
+        _ucdm_trace_record(UCDM_TRACE_OP_REGR, addr, *value, rval);
+    }
+    #endif
+    return rval;
+}
+
+HAL_BASE_t ucdm_set_register_async(ucdm_addr_t addr, uint16_t value, 
+                                   ucdm_async_cb_t cb, void * ctx, 
+                                   ucdm_async_token_t * token){
+    #if UCDM_ALIAS_ENABLE
+    addr = _ucdm_alias_resolve(addr);
+    #endif
+    if (addr >= UCDM_MAX_REGISTERS || !(ucdm_acctype[addr] & UCDM_AT_REGW_TYPE_MASK)){
+        // Let the synchronous path account for the rejected access.
+        ucdm_set_register(addr, value);
+        return UCDM_ASYNC_REJECTED;
+    }
+    if ((ucdm_acctype[addr] & UCDM_AT_REGW_TYPE_MASK) != UCDM_AT_REGW_TYPE_FUNC ||
+            ucdm_register[addr].wfunc != &_ucdm_async_write_detached){
+        switch (ucdm_set_register(addr, value)){
+            case 0:
+                return UCDM_ASYNC_OK;
+            case 3:
+                return UCDM_ASYNC_FAILED;
+            default:
+                return UCDM_ASYNC_REJECTED;
+        }
+    }
+    ucdm_async_t * reg = _ucdm_async_find(addr, UCDM_ASYNC_TYPE_WRITE);
+    HAL_BASE_t rval = _ucdm_async_start(reg, value, 0, cb, ctx, NULL, token);
+    if (rval == UCDM_ASYNC_OK){
+        _ucdm_async_post_write(addr, value);
+    }
+    #if UCDM_ENABLE_DIAGNOSTICS
+    uint16_t exceptions = _ucdm_diag_message_begin();
+    _ucdm_diag_write((rval == UCDM_ASYNC_FAILED || rval == UCDM_ASYNC_BUSY) ? 
+                     UCDM_EXCEPTION_DEVICE_FAILURE : 0);
+    _ucdm_diag_message_end(exceptions);
+    #endif
+    #if UCDM_TRACE_ENABLE
+    if (rval != UCDM_ASYNC_PENDING){
+        _ucdm_trace_record(UCDM_TRACE_OP_REGW, addr, value, rval);
+    }
+    #endif
+    return rval;
+}
+
+HAL_BASE_t ucdm_async_complete(ucdm_async_token_t token, uint16_t value, HAL_BASE_t status){
+    ucdm_async_slot_t * slot = _ucdm_async_slot(token);
+    if (!slot || slot->state != UCDM_ASYNC_SLOT_PENDING){
+        return 1;
+    }
+    ucdm_async_t * reg = slot->reg;
+    status = status ? UCDM_ASYNC_FAILED : UCDM_ASYNC_OK;
+    if (reg->type == UCDM_ASYNC_TYPE_READ){
+        if (status == UCDM_ASYNC_OK){
+            reg->last = value;
+        }
+        slot->value = value;
+    }
+    slot->status = status;
+    slot->state = UCDM_ASYNC_SLOT_DONE;
+    
+    if (slot->flags & UCDM_ASYNC_FLAG_STARTING){
+        // _ucdm_async_start returns the result to its caller directly.
+        return 0;
+    }
+    if (slot->flags & UCDM_ASYNC_FLAG_DETACHED){
+        slot->state = UCDM_ASYNC_SLOT_FREE;
+        return 0;
+    }
+    
+    if (reg->type == UCDM_ASYNC_TYPE_WRITE && status == UCDM_ASYNC_OK){
+        _ucdm_async_post_write(reg->addr, slot->value);
+    }
+    #if UCDM_ENABLE_DIAGNOSTICS
+    if (status == UCDM_ASYNC_FAILED){
+        ucdm_diag_exception(UCDM_EXCEPTION_DEVICE_FAILURE);
+    }
+    #endif
+    #if UCDM_TRACE_ENABLE
+    _ucdm_trace_record(reg->type == UCDM_ASYNC_TYPE_READ ? UCDM_TRACE_OP_REGR : UCDM_TRACE_OP_REGW, 
+                       reg->addr, slot->value, status);
+    #endif
+    
+    if (slot->cb){
+        // Release the slot first, so that the callback can start another 
+        // access using it.
+        ucdm_async_cb_t cb = slot->cb;
+        void * ctx = slot->ctx;
+        uint16_t result = slot->value;
+        slot->state = UCDM_ASYNC_SLOT_FREE;
+        cb(token, reg->addr, result, status, ctx);
+    }
+    return 0;
+}
+
+HAL_BASE_t ucdm_async_poll(ucdm_async_token_t token, uint16_t * value){
+    ucdm_async_slot_t * slot = _ucdm_async_slot(token);
+    if (!slot){
+        return UCDM_ASYNC_REJECTED;
+    }
+    if (slot->state == UCDM_ASYNC_SLOT_PENDING){
+        return UCDM_ASYNC_PENDING;
+    }
+    *value = slot->value;
+    slot->state = UCDM_ASYNC_SLOT_FREE;
+    return slot->status;
+}
+
+HAL_BASE_t ucdm_async_cancel(ucdm_async_token_t token){
+    ucdm_async_slot_t * slot = _ucdm_async_slot(token);
+    if (!slot){
+        return 1;
+    }
+    slot->state = UCDM_ASYNC_SLOT_FREE;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,256 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file async.h
+ * @brief Asynchronous completion for slow function registers
+ * 
+ * Function registers which proxy another device, such as a downstream 
+ * MODBUS slave on a gateway, can take a long time to complete. Since 
+ * ucdm_get_register and ucdm_set_register are synchronous, a protocol 
+ * front-end serving such a register is blocked until the downstream 
+ * transaction completes, and every other request queues up behind it. 
+ * 
+ * An asynchronous register is installed with ucdm_redirect_regr_async or 
+ * ucdm_redirect_regw_async. Its start function is called with the 
+ * register address and a completion token. It starts the operation and 
+ * returns immediately. When the operation finishes, the application calls 
+ * ucdm_async_complete with the token, the value read, and a status. 
+ * 
+ * Protocol front-ends access registers using ucdm_get_register_async and 
+ * ucdm_set_register_async. Accesses to ordinary registers, and accesses 
+ * whose start function completes the token before returning, complete 
+ * immediately. Otherwise, they return UCDM_ASYNC_PENDING along with the 
+ * token, and the front-end can go on serving other requests. The result 
+ * is delivered to the callback given when the access was made. If no 
+ * callback is given, the front-end polls for the result instead using 
+ * ucdm_async_poll. Outstanding accesses can be abandoned, for instance 
+ * on a protocol timeout, using ucdm_async_cancel. Tokens carry a 
+ * generation count, so completing or polling a token which has been 
+ * cancelled or already completed is detected and ignored. 
+ * 
+ * Asynchronous registers remain accessible through the synchronous API. 
+ * A synchronous read returns the value of the last completed read, and 
+ * starts a refresh in the background if none is outstanding. A synchronous 
+ * write starts the write in the background and returns immediately. 
+ * 
+ * Post-write handlers of an asynchronous write register run when the 
+ * write completes successfully. For writes made through the synchronous 
+ * API, they run when the write is started, as they would for any other 
+ * function register. 
+ * 
+ * As with the rest of UCDM, none of this is thread safe. Tokens should be 
+ * completed from the same thread of control which accesses UCDM, such as 
+ * the event loop of the protocol front-end. Callbacks are called from 
+ * within ucdm_async_complete. 
+ * 
+ * Since each register holds a single function redirection, an asynchronous 
+ * register is either read or written asynchronously, but not both. Up to 
+ * APP_UCDM_ASYNC_MAX_COUNT asynchronous registers can be installed, and 
+ * up to APP_UCDM_ASYNC_MAX_PENDING accesses can be outstanding at a time. 
+ * 
+ * On native builds compiled as C++20, async.hpp provides awaitables for 
+ * use from coroutines. 
+ */
+
+#ifndef UCDM_ASYNC_H
+#define UCDM_ASYNC_H
+
+#include "ucdm.h"
+
+#if UCDM_ASYNC_ENABLE
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @name UCDM Asynchronous Access Results
+ */
+/**@{*/
+/** The access completed successfully */
+#define UCDM_ASYNC_OK               0
+/** The register is out of range or does not permit the access */
+#define UCDM_ASYNC_REJECTED         1
+/** The access is outstanding, and will complete later */
+#define UCDM_ASYNC_PENDING          2
+/** No free slot to track the access. Try again later */
+#define UCDM_ASYNC_BUSY             3
+/** The access completed with a failure */
+#define UCDM_ASYNC_FAILED           4
+/**@}*/
+
+/** 
+ * \brief Completion token. 
+ * 
+ * The low byte identifies the pending slot and the high byte is the 
+ * generation of the slot. Valid tokens are never 0. 
+ */
+typedef uint16_t ucdm_async_token_t;
+
+/**
+ * \brief Asynchronous read start function.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param token Token to complete the read with.
+ */
+typedef void (*ucdm_async_rfunc_t)(ucdm_addr_t addr, ucdm_async_token_t token);
+
+/**
+ * \brief Asynchronous write start function.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param value Value being written.
+ * @param token Token to complete the write with.
+ */
+typedef void (*ucdm_async_wfunc_t)(ucdm_addr_t addr, uint16_t value, ucdm_async_token_t token);
+
+/**
+ * \brief Completion callback.
+ * 
+ * @param token Token of the completed access.
+ * @param addr Address/identifier of the register.
+ * @param value Value read, or value written.
+ * @param status UCDM_ASYNC_OK or UCDM_ASYNC_FAILED.
+ * @param ctx Context pointer given when the access was made.
+ */
+typedef void (*ucdm_async_cb_t)(ucdm_async_token_t token, ucdm_addr_t addr, 
+                                uint16_t value, HAL_BASE_t status, void * ctx);
+
+#define UCDM_ASYNC_TYPE_READ        0x00
+#define UCDM_ASYNC_TYPE_WRITE       0x01
+
+typedef struct UCDM_ASYNC_t{
+    ucdm_addr_t addr;
+    uint8_t type;
+    uint16_t last;
+    union {
+        ucdm_async_rfunc_t rfunc;
+        ucdm_async_wfunc_t wfunc;
+    } target;
+} ucdm_async_t;
+
+void _ucdm_async_init(void);
+
+void _ucdm_async_post_write(ucdm_addr_t addr, uint16_t value);
+
+/**
+ * \brief Redirect register reads to an asynchronous read function.
+ * 
+ * Like ucdm_redirect_regr_func, this disables writes to the register.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param target Asynchronous read start function.
+ * @return 0 for success, 1 for register out of range, 2 if no free slots.
+ */
+HAL_BASE_t ucdm_redirect_regr_async(ucdm_addr_t addr, ucdm_async_rfunc_t target);
+
+/**
+ * \brief Redirect register writes to an asynchronous write function.
+ * 
+ * Like ucdm_redirect_regw_func, this disables reads of the register.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param target Asynchronous write start function.
+ * @return 0 for success, 1 for register out of range, 2 if no free slots.
+ */
+HAL_BASE_t ucdm_redirect_regw_async(ucdm_addr_t addr, ucdm_async_wfunc_t target);
+
+/**
+ * \brief Read a register, without blocking on asynchronous registers.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param value Pointer to where the value should be stored, if the read 
+ *              completes immediately.
+ * @param cb Callback to deliver the result of a pending read to, or NULL 
+ *           to poll for it with ucdm_async_poll.
+ * @param ctx Context pointer passed to the callback.
+ * @param token Pointer to where the token of a pending read should be 
+ *              stored.
+ * @return UCDM_ASYNC_OK, UCDM_ASYNC_REJECTED, UCDM_ASYNC_PENDING, 
+ *         UCDM_ASYNC_BUSY or UCDM_ASYNC_FAILED.
+ */
+HAL_BASE_t ucdm_get_register_async(ucdm_addr_t addr, uint16_t * value, 
+                                   ucdm_async_cb_t cb, void * ctx, 
+                                   ucdm_async_token_t * token);
+
+/**
+ * \brief Write a register, without blocking on asynchronous registers.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param value Value to write.
+ * @param cb Callback to deliver the result of a pending write to, or NULL 
+ *           to poll for it with ucdm_async_poll.
+ * @param ctx Context pointer passed to the callback.
+ * @param token Pointer to where the token of a pending write should be 
+ *              stored.
+ * @return UCDM_ASYNC_OK, UCDM_ASYNC_REJECTED, UCDM_ASYNC_PENDING, 
+ *         UCDM_ASYNC_BUSY or UCDM_ASYNC_FAILED.
+ */
+HAL_BASE_t ucdm_set_register_async(ucdm_addr_t addr, uint16_t value, 
+                                   ucdm_async_cb_t cb, void * ctx, 
+                                   ucdm_async_token_t * token);
+
+/**
+ * \brief Complete an outstanding asynchronous access.
+ * 
+ * Called by the application when the operation started by an asynchronous 
+ * start function finishes. May be called from within the start function 
+ * itself. 
+ * 
+ * @param token Token given to the start function.
+ * @param value Value read. Ignored for writes.
+ * @param status 0 for success, non-zero for failure.
+ * @return 0 for success, 1 if the token is not outstanding.
+ */
+HAL_BASE_t ucdm_async_complete(ucdm_async_token_t token, uint16_t value, HAL_BASE_t status);
+
+/**
+ * \brief Poll for the result of an access made without a callback.
+ * 
+ * The token is released once a result other than UCDM_ASYNC_PENDING is 
+ * returned. 
+ * 
+ * @param token Token of the access.
+ * @param value Pointer to where the value read should be stored.
+ * @return UCDM_ASYNC_PENDING, UCDM_ASYNC_OK, UCDM_ASYNC_FAILED, or 
+ *         UCDM_ASYNC_REJECTED if the token is not outstanding.
+ */
+HAL_BASE_t ucdm_async_poll(ucdm_async_token_t token, uint16_t * value);
+
+/**
+ * \brief Abandon an outstanding access.
+ * 
+ * The callback will not be called, and a later completion of the token 
+ * is ignored. 
+ * 
+ * @param token Token of the access.
+ * @return 0 for success, 1 if the token is not outstanding.
+ */
+HAL_BASE_t ucdm_async_cancel(ucdm_async_token_t token);
+
+#ifdef __cplusplus
+}
+#endif /* extern "C" */
+
+#endif
+#endif
@@ -0,0 +1,143 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file async.hpp
+ * @brief C++20 coroutine awaitables for asynchronous register access
+ *
+ * On native builds compiled as C++20, asynchronous register accesses can 
+ * be awaited from a coroutine instead of being completed through a 
+ * callback. The coroutine is suspended while the access is pending, and 
+ * is resumed from within ucdm_async_complete. Accesses which complete 
+ * immediately do not suspend the coroutine at all.
+ *
+ * Usage :
+ *
+ * @code
+ * task serve_read(request_t req){
+ *     ucdm::async_result r = co_await ucdm::async_read(req.addr);
+ *     if (r.status == UCDM_ASYNC_OK){
+ *         respond(req, r.value);
+ *     } else {
+ *         respond_exception(req, r.status);
+ *     }
+ * }
+ * @endcode
+ *
+ * The coroutine type itself, and the scheduling of coroutines, are left 
+ * to the application. The awaitable must not be destroyed while the 
+ * access is pending, which holds as long as the awaiting coroutine is 
+ * not destroyed while suspended. If it has to be, cancel the access 
+ * first using ucdm_async_cancel with the token of the awaitable.
+ *
+ * See async.h for the underlying C interface.
+ */
+
+#ifndef UCDM_ASYNC_HPP
+#define UCDM_ASYNC_HPP
+
+#include "async.h"
+
+#if UCDM_ASYNC_ENABLE && defined(PIO_NATIVE) && __cplusplus >= 202002L
+
+#include <coroutine>
+
+namespace ucdm {
+
+/**
+ * \brief Result of an awaited access.
+ */
+struct async_result {
+    /** UCDM_ASYNC_OK, UCDM_ASYNC_REJECTED, UCDM_ASYNC_BUSY or UCDM_ASYNC_FAILED */
+    HAL_BASE_t status;
+    /** Value read, or value written */
+    uint16_t value;
+};
+
+namespace detail {
+
+class async_awaitable {
+public:
+    async_awaitable(const async_awaitable &) = delete;
+    async_awaitable & operator=(const async_awaitable &) = delete;
+
+    void await_suspend(std::coroutine_handle<> h) noexcept { handle = h; }
+    async_result await_resume() const noexcept { return result; }
+
+    /** \brief Token of the pending access, or 0 if it did not suspend. */
+    ucdm_async_token_t token() const noexcept { return tok; }
+
+protected:
+    async_awaitable(ucdm_addr_t addr, uint16_t value) noexcept
+        : addr(addr), result{UCDM_ASYNC_OK, value}, tok(0) {}
+
+    bool ready(HAL_BASE_t rval) noexcept {
+        if (rval == UCDM_ASYNC_PENDING){
+            return false;
+        }
+        result.status = rval;
+        return true;
+    }
+
+    static void complete(ucdm_async_token_t, ucdm_addr_t, uint16_t value,
+                         HAL_BASE_t status, void * ctx){
+        async_awaitable * self = static_cast<async_awaitable *>(ctx);
+        self->result.status = status;
+        self->result.value = value;
+        self->handle.resume();
+    }
+
+    ucdm_addr_t addr;
+    async_result result;
+    ucdm_async_token_t tok;
+    std::coroutine_handle<> handle;
+};
+
+}
+
+/**
+ * \brief Awaitable reading a register.
+ */
+class async_read : public detail::async_awaitable {
+public:
+    explicit async_read(ucdm_addr_t addr) noexcept : async_awaitable(addr, 0xFFFF) {}
+
+    bool await_ready() noexcept {
+        return ready(ucdm_get_register_async(addr, &result.value, &complete, this, &tok));
+    }
+};
+
+/**
+ * \brief Awaitable writing a register.
+ */
+class async_write : public detail::async_awaitable {
+public:
+    async_write(ucdm_addr_t addr, uint16_t value) noexcept : async_awaitable(addr, value) {}
+
+    bool await_ready() noexcept {
+        return ready(ucdm_set_register_async(addr, result.value, &complete, this, &tok));
+    }
+};
+
+}
+
+#endif
+#endif
@@ -0,0 +1,168 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file block.c
+ * @brief Block read and write functions covering a range of registers
+ *
+ */
+
+#include "block.h"
+
+#if UCDM_BLOCK_ENABLE
+
+ucdm_block_t ucdm_blocks[UCDM_BLOCK_MAX_COUNT];
+uint8_t ucdm_block_count;
+
+void _ucdm_block_init(void){
+    ucdm_block_count = 0;
+}
+
+static ucdm_block_t * _ucdm_block_find(ucdm_addr_t addr, uint8_t type){
+    for (uint8_t i=0; i < ucdm_block_count; i++){
+        if (ucdm_blocks[i].type == type && addr >= ucdm_blocks[i].saddr &&
+                addr < ucdm_blocks[i].saddr + ucdm_blocks[i].count){
+            return &ucdm_blocks[i];
+        }
+    }
+    return NULL;
+}
+
+static uint8_t _ucdm_block_overlaps(ucdm_addr_t saddr, uint8_t count, uint8_t type){
+    // Check whether the range overlaps an installed block of the same type.
+    for (uint8_t i=0; i < ucdm_block_count; i++){
+        if (ucdm_blocks[i].type == type && 
+                (uint32_t)saddr < (uint32_t)ucdm_blocks[i].saddr + ucdm_blocks[i].count &&
+                (uint32_t)ucdm_blocks[i].saddr < (uint32_t)saddr + count){
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static ucdm_block_t * _ucdm_block_create(ucdm_addr_t saddr, uint8_t count, uint8_t type, HAL_BASE_t * rval){
+    if (!count){
+        *rval = 2;
+        return NULL;
+    }
+    if ((uint32_t)saddr + count > UCDM_MAX_REGISTERS){
+        *rval = 1;
+        return NULL;
+    }
+    if (_ucdm_block_overlaps(saddr, count, type)){
+        *rval = 4;
+        return NULL;
+    }
+    if (ucdm_block_count >= UCDM_BLOCK_MAX_COUNT){
+        *rval = 3;
+        return NULL;
+    }
+    ucdm_block_t * block = &ucdm_blocks[ucdm_block_count++];
+    block->saddr = saddr;
+    block->count = count;
+    block->type = type;
+    *rval = 0;
+    return block;
+}
+
+static uint16_t _ucdm_block_read_word(ucdm_addr_t addr){
+    uint16_t value = 0xFFFF;
+    ucdm_block_t * block = _ucdm_block_find(addr, UCDM_BLOCK_TYPE_READ);
+    if (block){
+        block->target.rfunc(block->saddr, addr - block->saddr, 1, &value);
+    }
+    return value;
+}
+
+static void _ucdm_block_write_word(ucdm_addr_t addr, uint16_t value){
+    ucdm_block_t * block = _ucdm_block_find(addr, UCDM_BLOCK_TYPE_WRITE);
+    if (block){
+        block->target.wfunc(block->saddr, addr - block->saddr, 1, &value);
+    }
+}
+
+uint8_t _ucdm_block_read(ucdm_addr_t addr, uint8_t count, uint16_t * out){
+    // Read as much of the requested range as falls within the block
+    // containing addr, and return the number of registers read. Returns 0
+    // if addr is not part of a block.
+    if ((ucdm_acctype[addr] & UCDM_AT_READ_MASK) != UCDM_AT_READ_FUNC ||
+            ucdm_register[addr].rfunc != &_ucdm_block_read_word){
+        return 0;
+    }
+    ucdm_block_t * block = _ucdm_block_find(addr, UCDM_BLOCK_TYPE_READ);
+    if (!block){
+        return 0;
+    }
+    uint8_t offset = addr - block->saddr;
+    if (count > block->count - offset){
+        count = block->count - offset;
+    }
+    block->target.rfunc(block->saddr, offset, count, out);
+    return count;
+}
+
+uint8_t _ucdm_block_write(ucdm_addr_t addr, uint8_t count, const uint16_t * values){
+    // Write as much of the given range as falls within the block containing
+    // addr, and return the number of registers written. Returns 0 if addr
+    // is not part of a block.
+    if ((ucdm_acctype[addr] & UCDM_AT_REGW_TYPE_MASK) != UCDM_AT_REGW_TYPE_FUNC ||
+            ucdm_register[addr].wfunc != &_ucdm_block_write_word){
+        return 0;
+    }
+    ucdm_block_t * block = _ucdm_block_find(addr, UCDM_BLOCK_TYPE_WRITE);
+    if (!block){
+        return 0;
+    }
+    uint8_t offset = addr - block->saddr;
+    if (count > block->count - offset){
+        count = block->count - offset;
+    }
+    block->target.wfunc(block->saddr, offset, count, values);
+    return count;
+}
+
+HAL_BASE_t ucdm_redirect_block_rfunc(ucdm_addr_t saddr, uint8_t count, ucdm_block_rfunc_t target){
+    HAL_BASE_t rval;
+    ucdm_block_t * block = _ucdm_block_create(saddr, count, UCDM_BLOCK_TYPE_READ, &rval);
+    if (!block){
+        return rval;
+    }
+    block->target.rfunc = target;
+    for (uint8_t i=0; i < count; i++){
+        ucdm_redirect_regr_func(saddr + i, &_ucdm_block_read_word);
+    }
+    return 0;
+}
+
+HAL_BASE_t ucdm_redirect_block_wfunc(ucdm_addr_t saddr, uint8_t count, ucdm_block_wfunc_t target){
+    HAL_BASE_t rval;
+    ucdm_block_t * block = _ucdm_block_create(saddr, count, UCDM_BLOCK_TYPE_WRITE, &rval);
+    if (!block){
+        return rval;
+    }
+    block->target.wfunc = target;
+    for (uint8_t i=0; i < count; i++){
+        ucdm_redirect_regw_func(saddr + i, &_ucdm_block_write_word);
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,136 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file block.h
+ * @brief Block read and write functions covering a range of registers
+ * 
+ * Function-read registers installed with ucdm_redirect_regr_func are read 
+ * one register at a time, and the read function is called once for each 
+ * register. Where a range of registers is computed from a single source, 
+ * such as a status structure, this means the source is recomputed for 
+ * every register of a bulk read. 
+ * 
+ * A block read function is installed once for a whole range of registers 
+ * using ucdm_redirect_block_rfunc. It is called with the first register 
+ * of the block, and the offset and number of registers requested, and 
+ * fills in the values of the requested sub-range in a single call. 
+ * 
+ * Bulk reads made with ucdm_get_registers call the block function once 
+ * for the part of the requested range which falls within the block. 
+ * Single register reads made with ucdm_get_register call it with a count 
+ * of 1. 
+ * 
+ * Block registers are function-read registers as far as the rest of UCDM 
+ * is concerned. Single register reads of them go through the read cache, 
+ * if one is installed for the register, but bulk reads do not. 
+ * 
+ * Block write functions are the write counterpart. A block write function 
+ * installed using ucdm_redirect_block_wfunc receives the whole contiguous 
+ * sub-range of the block written by a bulk write made with 
+ * ucdm_set_registers, with the values, in a single call. The application 
+ * can therefore validate and apply a configuration block as a unit rather 
+ * than guessing when the last register of it has arrived. Single register 
+ * writes made with ucdm_set_register call it with a count of 1. Post-write 
+ * handlers and report-by-exception checks for the registers of the block 
+ * are run after the block write function returns. 
+ * 
+ * Since each register holds a single function redirection, a range can 
+ * have either a block read function or a block write function, but not 
+ * both. The block table holds APP_UCDM_BLOCK_MAX_COUNT blocks of either 
+ * kind. 
+ */
+
+#ifndef UCDM_BLOCK_H
+#define UCDM_BLOCK_H
+
+#include "ucdm.h"
+
+#if UCDM_BLOCK_ENABLE
+
+/**
+ * \brief Block read function.
+ * 
+ * @param saddr First register of the block.
+ * @param offset Offset within the block of the first register requested.
+ * @param count Number of registers requested.
+ * @param out Array of count words to be filled in.
+ */
+typedef void (*ucdm_block_rfunc_t)(ucdm_addr_t saddr, uint8_t offset, uint8_t count, uint16_t * out);
+
+/**
+ * \brief Block write function.
+ * 
+ * @param saddr First register of the block.
+ * @param offset Offset within the block of the first register written.
+ * @param count Number of registers written.
+ * @param values Array of count values written.
+ */
+typedef void (*ucdm_block_wfunc_t)(ucdm_addr_t saddr, uint8_t offset, uint8_t count, const uint16_t * values);
+
+#define UCDM_BLOCK_TYPE_READ        0x00
+#define UCDM_BLOCK_TYPE_WRITE       0x01
+
+typedef struct UCDM_BLOCK_t{
+    ucdm_addr_t saddr;
+    uint8_t count;
+    uint8_t type;
+    union {
+        ucdm_block_rfunc_t rfunc;
+        ucdm_block_wfunc_t wfunc;
+    } target;
+} ucdm_block_t;
+
+void _ucdm_block_init(void);
+
+uint8_t _ucdm_block_read(ucdm_addr_t addr, uint8_t count, uint16_t * out);
+
+uint8_t _ucdm_block_write(ucdm_addr_t addr, uint8_t count, const uint16_t * values);
+
+/**
+ * \brief Redirect register reads on a range of registers to a block read function.
+ * 
+ * Like ucdm_redirect_regr_func, this disables writes to the registers. 
+ * The range may not overlap an installed block read range.
+ * 
+ * @param saddr Address/identifier of the first register.
+ * @param count Number of registers in the block.
+ * @param target Block read function.
+ * @return 0 for success, 1 for register out of range, 2 for bad count, 
+ *         3 if no free slots, 4 if it overlaps an installed block.
+ */
+HAL_BASE_t ucdm_redirect_block_rfunc(ucdm_addr_t saddr, uint8_t count, ucdm_block_rfunc_t target);
+
+/**
+ * \brief Redirect register writes on a range of registers to a block write function.
+ * 
+ * The range may not overlap an installed block write range.
+ * 
+ * @param saddr Address/identifier of the first register.
+ * @param count Number of registers in the block.
+ * @param target Block write function.
+ * @return 0 for success, 1 for register out of range, 2 for bad count, 
+ *         3 if no free slots, 4 if it overlaps an installed block.
+ */
+HAL_BASE_t ucdm_redirect_block_wfunc(ucdm_addr_t saddr, uint8_t count, ucdm_block_wfunc_t target);
+
+#endif
+#endif
@@ -0,0 +1,105 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file cache.c
+ * @brief Time-to-live read cache for function-read registers
+ *
+ */
+
+#include "cache.h"
+
+#if UCDM_CACHE_ENABLE
+
+ucdm_cache_entry_t ucdm_cache_entries[UCDM_CACHE_MAX_COUNT];
+uint8_t ucdm_cache_count;
+
+hashmap_t ucdm_cache_map = {0};
+hashmap_entry_t ucdm_cache_table[UCDM_CACHE_MAX_COUNT];
+
+uint32_t ucdm_cache_hits;
+uint32_t ucdm_cache_misses;
+
+void _ucdm_cache_init(void){
+    ucdm_cache_count = 0;
+    ucdm_cache_reset_stats();
+    hashmap_init(&ucdm_cache_map, &ucdm_cache_table[0], UCDM_CACHE_MAX_COUNT);
+}
+
+void ucdm_cache_reset_stats(void){
+    ucdm_cache_hits = 0;
+    ucdm_cache_misses = 0;
+}
+
+HAL_BASE_t ucdm_cache_install(ucdm_addr_t addr, ucdm_tick_t ttl){
+    if (addr >= UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    ucdm_cache_entry_t * entry;
+    hashmap_entry_t * hentry = hashmap_get(&ucdm_cache_map, addr);
+    if (hentry){
+        entry = (ucdm_cache_entry_t *)hentry->ptr;
+    } else {
+        if (ucdm_cache_count >= UCDM_CACHE_MAX_COUNT){
+            return 2;
+        }
+        entry = &ucdm_cache_entries[ucdm_cache_count++];
+        entry->addr = addr;
+        hashmap_insert(&ucdm_cache_map, addr, (void *)entry, 0);
+    }
+    entry->ttl = ttl;
+    entry->valid = 0;
+    return 0;
+}
+
+void ucdm_cache_invalidate(ucdm_addr_t addr){
+    hashmap_entry_t * hentry = hashmap_get(&ucdm_cache_map, addr);
+    if (hentry){
+        ((ucdm_cache_entry_t *)hentry->ptr)->valid = 0;
+    }
+}
+
+void ucdm_cache_invalidate_all(void){
+    for (uint8_t i=0; i < ucdm_cache_count; i++){
+        ucdm_cache_entries[i].valid = 0;
+    }
+}
+
+uint16_t _ucdm_cache_read(ucdm_addr_t addr){
+    // Called in place of the read function for function-read registers.
+    hashmap_entry_t * hentry = hashmap_get(&ucdm_cache_map, addr);
+    if (!hentry){
+        return (ucdm_register[addr].rfunc)(addr);
+    }
+    ucdm_cache_entry_t * entry = (ucdm_cache_entry_t *)hentry->ptr;
+    ucdm_tick_t now = ucdm_tick();
+    if (entry->valid && (ucdm_tick_t)(now - entry->stamp) < entry->ttl){
+        ucdm_cache_hits++;
+        return entry->value;
+    }
+    ucdm_cache_misses++;
+    entry->value = (ucdm_register[addr].rfunc)(addr);
+    entry->stamp = now;
+    entry->valid = 1;
+    return entry->value;
+}
+
+#endif
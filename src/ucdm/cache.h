@@ -0,0 +1,110 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file cache.h
+ * @brief Time-to-live read cache for function-read registers
+ * 
+ * Registers redirected to functions using ucdm_redirect_regr_func often 
+ * front costly operations, such as ADC conversions, sensor reads over a 
+ * slow bus, or computed statistics. A master polling a block of such 
+ * registers causes every read function to be executed on every poll. 
+ * 
+ * Function-read registers installed into the cache have the value 
+ * returned by their read function retained for a configurable number of 
+ * ticks. Reads within that time return the retained value without 
+ * calling the read function. The first read after the time has elapsed 
+ * calls the read function and refreshes the retained value. 
+ * 
+ * The application can force the next read to call the read function by 
+ * invalidating the register, for instance when it knows the underlying 
+ * quantity has changed. 
+ * 
+ * The cache only affects registers whose read type is 
+ * UCDM_AT_READ_FUNC. Plain and pointer-redirected registers are already 
+ * cheap to read and are never cached. 
+ * 
+ * The number of cached registers is set by APP_UCDM_CACHE_MAX_COUNT. 
+ * Hit and miss counters are maintained to help tune the TTLs.
+ */
+
+#ifndef UCDM_CACHE_H
+#define UCDM_CACHE_H
+
+#include "ucdm.h"
+
+#if UCDM_CACHE_ENABLE
+
+#include <ds/hashmap.h>
+#include "tick.h"
+
+typedef struct UCDM_CACHE_ENTRY_t{
+    ucdm_addr_t addr;
+    uint8_t valid;
+    uint16_t value;
+    ucdm_tick_t ttl;
+    ucdm_tick_t stamp;
+} ucdm_cache_entry_t;
+
+void _ucdm_cache_init(void);
+
+uint16_t _ucdm_cache_read(ucdm_addr_t addr);
+
+/**
+ * \brief Cache the values returned by a function-read register.
+ * 
+ * Installing a register which is already cached updates its TTL and 
+ * invalidates it.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param ttl Number of ticks for which a value read is retained.
+ * @return 0 for success, 1 for register out of range, 2 if no free slots.
+ */
+HAL_BASE_t ucdm_cache_install(ucdm_addr_t addr, ucdm_tick_t ttl);
+
+/**
+ * \brief Invalidate the cached value of a register.
+ * 
+ * The next read of the register will call its read function. Has no 
+ * effect on registers which are not cached.
+ * 
+ * @param addr Address/identifier of the register.
+ */
+void ucdm_cache_invalidate(ucdm_addr_t addr);
+
+/**
+ * \brief Invalidate the cached values of all registers.
+ */
+void ucdm_cache_invalidate_all(void);
+
+/**
+ * \brief Clear the hit and miss counters.
+ */
+void ucdm_cache_reset_stats(void);
+
+/** \brief Number of reads served from the cache. */
+extern uint32_t ucdm_cache_hits;
+
+/** \brief Number of reads of cached registers which called the read function. */
+extern uint32_t ucdm_cache_misses;
+
+#endif
+#endif
@@ -49,6 +49,32 @@
     #define UCDM_ENABLE_DESCRIPTORS     1
 #endif
 
+#ifdef APP_ENABLE_UCDM_DIAGNOSTICS
+    #define UCDM_ENABLE_DIAGNOSTICS     APP_ENABLE_UCDM_DIAGNOSTICS
+#else
+    #define UCDM_ENABLE_DIAGNOSTICS     1
+#endif
+
+#ifdef APP_ENABLE_UCDM_CONST_CONFIG
+    #define UCDM_CONST_CONFIG           APP_ENABLE_UCDM_CONST_CONFIG
+#else
+    #define UCDM_CONST_CONFIG           0
+#endif
+
+#ifdef APP_UCDM_CONST_DATA_COUNT
+    #define UCDM_CONST_DATA_COUNT       APP_UCDM_CONST_DATA_COUNT
+#else
+    #define UCDM_CONST_DATA_COUNT       1
+#endif
+
+#ifdef APP_ENABLE_UCDM_PERM_BITMAPS
+    #define UCDM_ENABLE_PERM_BITMAPS    APP_ENABLE_UCDM_PERM_BITMAPS
+#elif UCDM_CONST_CONFIG
+    #define UCDM_ENABLE_PERM_BITMAPS    0
+#else
+    #define UCDM_ENABLE_PERM_BITMAPS    1
+#endif
+
 #ifndef UCDM_LIBVERSION_DESCRIPTOR
 #ifdef APP_ENABLE_LIBVERSION_DESCRIPTORS
     #define UCDM_LIBVERSION_DESCRIPTOR  APP_ENABLE_LIBVERSION_DESCRIPTORS
@@ -70,6 +96,13 @@
     #define UCDM_SPAN_MAX_LENGTH        4
 #endif
 
+#ifdef APP_UCDM_SPAN_TIMEOUT
+    #define UCDM_SPAN_TIMEOUT           APP_UCDM_SPAN_TIMEOUT
+#else
+    // Ticks after which incomplete span writes are dropped. 0 to disable.
+    #define UCDM_SPAN_TIMEOUT           0
+#endif
+
 #ifndef UCDM_SPAN_ENABLE
     #if UCDM_SPAN_MAX_COUNT
         #define UCDM_SPAN_ENABLE        1
@@ -78,6 +111,307 @@
     #endif
 #endif        
 
+#ifdef APP_UCDM_RBE_MAX_COUNT
+    #define UCDM_RBE_MAX_COUNT          APP_UCDM_RBE_MAX_COUNT
+#else
+    #define UCDM_RBE_MAX_COUNT          0
+#endif
+
+#ifdef APP_UCDM_RBE_QUEUE_LENGTH
+    #define UCDM_RBE_QUEUE_LENGTH       APP_UCDM_RBE_QUEUE_LENGTH
+#else
+    #define UCDM_RBE_QUEUE_LENGTH       UCDM_RBE_MAX_COUNT
+#endif
+
+#ifndef UCDM_RBE_ENABLE
+    #if UCDM_RBE_MAX_COUNT
+        #define UCDM_RBE_ENABLE         1
+    #else
+        #define UCDM_RBE_ENABLE         0
+    #endif
+#endif
+
+#ifdef APP_UCDM_SAMPLER_MAX_CHANNELS
+    #define UCDM_SAMPLER_MAX_CHANNELS   APP_UCDM_SAMPLER_MAX_CHANNELS
+#else
+    #define UCDM_SAMPLER_MAX_CHANNELS   0
+#endif
+
+#ifdef APP_UCDM_SAMPLER_DEPTH
+    #define UCDM_SAMPLER_DEPTH          APP_UCDM_SAMPLER_DEPTH
+#else
+    #define UCDM_SAMPLER_DEPTH          16
+#endif
+
+#ifdef APP_UCDM_SAMPLER_FIFO_WINDOW
+    #define UCDM_SAMPLER_FIFO_WINDOW    APP_UCDM_SAMPLER_FIFO_WINDOW
+#else
+    // MODBUS FC24 returns at most 31 registers per read
+    #define UCDM_SAMPLER_FIFO_WINDOW    31
+#endif
+
+#ifndef UCDM_SAMPLER_ENABLE
+    #if UCDM_SAMPLER_MAX_CHANNELS
+        #define UCDM_SAMPLER_ENABLE     1
+    #else
+        #define UCDM_SAMPLER_ENABLE     0
+    #endif
+#endif
+
+#ifdef APP_UCDM_TRACE_DEPTH
+    #define UCDM_TRACE_DEPTH            APP_UCDM_TRACE_DEPTH
+#else
+    #define UCDM_TRACE_DEPTH            0
+#endif
+
+#ifndef UCDM_TRACE_ENABLE
+    #if UCDM_TRACE_DEPTH
+        #define UCDM_TRACE_ENABLE       1
+    #else
+        #define UCDM_TRACE_ENABLE       0
+    #endif
+#endif
+
+#ifdef APP_UCDM_HSTATS_MAX_HANDLERS
+    #define UCDM_HSTATS_MAX_HANDLERS    APP_UCDM_HSTATS_MAX_HANDLERS
+#else
+    #define UCDM_HSTATS_MAX_HANDLERS    0
+#endif
+
+#ifdef APP_UCDM_HSTATS_BUCKETS
+    #define UCDM_HSTATS_BUCKETS         APP_UCDM_HSTATS_BUCKETS
+#else
+    #define UCDM_HSTATS_BUCKETS         16
+#endif
+
+#ifndef UCDM_HSTATS_ENABLE
+    #if UCDM_HSTATS_MAX_HANDLERS && UCDM_ENABLE_HANDLERS
+        #define UCDM_HSTATS_ENABLE      1
+    #else
+        #define UCDM_HSTATS_ENABLE      0
+    #endif
+#endif
+
+#ifdef APP_UCDM_HANDLER_BUDGET
+    #define UCDM_HANDLER_BUDGET         APP_UCDM_HANDLER_BUDGET
+#else
+    // Ticks a handler may take before being deferred. 0 to disable.
+    #define UCDM_HANDLER_BUDGET         0
+#endif
+
+#ifdef APP_UCDM_DEFER_MAX_HANDLERS
+    #define UCDM_DEFER_MAX_HANDLERS     APP_UCDM_DEFER_MAX_HANDLERS
+#else
+    #define UCDM_DEFER_MAX_HANDLERS     8
+#endif
+
+#ifdef APP_UCDM_DEFER_QUEUE_LENGTH
+    #define UCDM_DEFER_QUEUE_LENGTH     APP_UCDM_DEFER_QUEUE_LENGTH
+#else
+    #define UCDM_DEFER_QUEUE_LENGTH     8
+#endif
+
+#ifdef APP_UCDM_DEFER_RECOVERY
+    #define UCDM_DEFER_RECOVERY         APP_UCDM_DEFER_RECOVERY
+#else
+    // Consecutive runs within budget before a handler is run inline again
+    #define UCDM_DEFER_RECOVERY         4
+#endif
+
+#ifdef APP_UCDM_DEFER_PRIORITIES
+    #define UCDM_DEFER_PRIORITIES       APP_UCDM_DEFER_PRIORITIES
+#else
+    #define UCDM_DEFER_PRIORITIES       3
+#endif
+
+#ifdef APP_UCDM_DEFER_POLL_BUDGET
+    #define UCDM_DEFER_POLL_BUDGET      APP_UCDM_DEFER_POLL_BUDGET
+#else
+    // Ticks a single ucdm_defer_poll may run for. 0 for no limit.
+    #define UCDM_DEFER_POLL_BUDGET      0
+#endif
+
+#ifndef UCDM_DEFER_ENABLE
+    #if UCDM_HANDLER_BUDGET && UCDM_ENABLE_HANDLERS
+        #define UCDM_DEFER_ENABLE       1
+    #else
+        #define UCDM_DEFER_ENABLE       0
+    #endif
+#endif
 
+#ifdef APP_UCDM_CACHE_MAX_COUNT
+    #define UCDM_CACHE_MAX_COUNT        APP_UCDM_CACHE_MAX_COUNT
+#else
+    #define UCDM_CACHE_MAX_COUNT        0
 #endif
 
+#ifndef UCDM_CACHE_ENABLE
+    #if UCDM_CACHE_MAX_COUNT
+        #define UCDM_CACHE_ENABLE       1
+    #else
+        #define UCDM_CACHE_ENABLE       0
+    #endif
+#endif
+
+#ifdef APP_UCDM_BLOCK_MAX_COUNT
+    #define UCDM_BLOCK_MAX_COUNT        APP_UCDM_BLOCK_MAX_COUNT
+#else
+    #define UCDM_BLOCK_MAX_COUNT        0
+#endif
+
+#ifndef UCDM_BLOCK_ENABLE
+    #if UCDM_BLOCK_MAX_COUNT
+        #define UCDM_BLOCK_ENABLE       1
+    #else
+        #define UCDM_BLOCK_ENABLE       0
+    #endif
+#endif
+
+#ifdef APP_ENABLE_UCDM_SHM
+    #define UCDM_SHM_ENABLE             APP_ENABLE_UCDM_SHM
+#else
+    #define UCDM_SHM_ENABLE             0
+#endif
+
+#ifdef APP_ENABLE_UCDM_DEVMAP
+    #define UCDM_DEVMAP_ENABLE          APP_ENABLE_UCDM_DEVMAP
+#else
+    #define UCDM_DEVMAP_ENABLE          0
+#endif
+
+#ifdef APP_UCDM_DEVMAP_MAX_DESCRIPTORS
+    #define UCDM_DEVMAP_MAX_DESCRIPTORS APP_UCDM_DEVMAP_MAX_DESCRIPTORS
+#else
+    #define UCDM_DEVMAP_MAX_DESCRIPTORS 4
+#endif
+
+#ifdef APP_UCDM_DEVMAP_FILE_BUFFER
+    #define UCDM_DEVMAP_FILE_BUFFER     APP_UCDM_DEVMAP_FILE_BUFFER
+#else
+    // Largest device map image file which can be loaded on native builds
+    #define UCDM_DEVMAP_FILE_BUFFER     4096
+#endif
+
+#ifdef APP_ENABLE_UCDM_DELTA
+    #define UCDM_DELTA_ENABLE           APP_ENABLE_UCDM_DELTA
+#else
+    #define UCDM_DELTA_ENABLE           0
+#endif
+
+#ifdef APP_UCDM_ASYNC_MAX_COUNT
+    #define UCDM_ASYNC_MAX_COUNT        APP_UCDM_ASYNC_MAX_COUNT
+#else
+    #define UCDM_ASYNC_MAX_COUNT        0
+#endif
+
+#ifdef APP_UCDM_ASYNC_MAX_PENDING
+    #define UCDM_ASYNC_MAX_PENDING      APP_UCDM_ASYNC_MAX_PENDING
+#else
+    #define UCDM_ASYNC_MAX_PENDING      4
+#endif
+
+#ifndef UCDM_ASYNC_ENABLE
+    #if UCDM_ASYNC_MAX_COUNT
+        #define UCDM_ASYNC_ENABLE       1
+    #else
+        #define UCDM_ASYNC_ENABLE       0
+    #endif
+#endif
+
+#ifdef APP_UCDM_REPL_BATCH
+    #define UCDM_REPL_BATCH             APP_UCDM_REPL_BATCH
+#else
+    #define UCDM_REPL_BATCH             0
+#endif
+
+#ifdef APP_UCDM_REPL_SNAPSHOT_INTERVAL
+    #define UCDM_REPL_SNAPSHOT_INTERVAL APP_UCDM_REPL_SNAPSHOT_INTERVAL
+#else
+    // Delta frames between periodic snapshots. 0 to only resync on request.
+    #define UCDM_REPL_SNAPSHOT_INTERVAL 0
+#endif
+
+#ifndef UCDM_REPL_ENABLE
+    #if UCDM_REPL_BATCH
+        #define UCDM_REPL_ENABLE        1
+    #else
+        #define UCDM_REPL_ENABLE        0
+    #endif
+#endif
+
+#ifdef APP_UCDM_VIEW_MAX_COUNT
+    #define UCDM_VIEW_MAX_COUNT         APP_UCDM_VIEW_MAX_COUNT
+#else
+    #define UCDM_VIEW_MAX_COUNT         0
+#endif
+
+#ifndef UCDM_VIEW_ENABLE
+    #if UCDM_VIEW_MAX_COUNT
+        #define UCDM_VIEW_ENABLE        1
+    #else
+        #define UCDM_VIEW_ENABLE        0
+    #endif
+#endif
+
+#ifdef APP_UCDM_MAX_HANDLERS
+    #define UCDM_MAX_HANDLERS           APP_UCDM_MAX_HANDLERS
+#else
+    #define UCDM_MAX_HANDLERS           0
+#endif
+
+#ifndef UCDM_HPOOL_ENABLE
+    #if UCDM_MAX_HANDLERS && UCDM_ENABLE_HANDLERS
+        #define UCDM_HPOOL_ENABLE       1
+    #else
+        #define UCDM_HPOOL_ENABLE       0
+    #endif
+#endif
+
+#if UCDM_MAX_HANDLERS > 255
+    #error "The UCDM handler pool can hold at most 255 handlers"
+#endif
+
+#ifdef APP_UCDM_HPOOL_MAX_CHAIN
+    #define UCDM_HPOOL_MAX_CHAIN        APP_UCDM_HPOOL_MAX_CHAIN
+#elif UCDM_MAX_HANDLERS < 4
+    #define UCDM_HPOOL_MAX_CHAIN        UCDM_MAX_HANDLERS
+#else
+    #define UCDM_HPOOL_MAX_CHAIN        4
+#endif
+
+#if UCDM_HPOOL_ENABLE && (UCDM_HPOOL_MAX_CHAIN < 1 || UCDM_HPOOL_MAX_CHAIN > UCDM_MAX_HANDLERS)
+    #error "The UCDM handler chain limit must be between 1 and the handler pool size"
+#endif
+
+#ifdef APP_UCDM_ALIAS_MAX_COUNT
+    #define UCDM_ALIAS_MAX_COUNT        APP_UCDM_ALIAS_MAX_COUNT
+#else
+    #define UCDM_ALIAS_MAX_COUNT        0
+#endif
+
+#ifndef UCDM_ALIAS_ENABLE
+    #if UCDM_ALIAS_MAX_COUNT
+        #define UCDM_ALIAS_ENABLE       1
+    #else
+        #define UCDM_ALIAS_ENABLE       0
+    #endif
+#endif
+
+#if UCDM_CONST_CONFIG && (UCDM_SPAN_ENABLE || UCDM_SAMPLER_ENABLE || \
+        UCDM_BLOCK_ENABLE || UCDM_DEVMAP_ENABLE || UCDM_ASYNC_ENABLE || \
+        UCDM_VIEW_ENABLE)
+    #error "UCDM modules which redirect registers at runtime can't be used with a const configuration"
+#endif
+
+#ifndef UCDM_TICK_ENABLE
+    #if UCDM_SAMPLER_ENABLE || UCDM_TRACE_ENABLE || UCDM_HSTATS_ENABLE || \
+            UCDM_DEFER_ENABLE || UCDM_CACHE_ENABLE || \
+            (UCDM_SPAN_ENABLE && UCDM_SPAN_TIMEOUT)
+        #define UCDM_TICK_ENABLE        1
+    #else
+        #define UCDM_TICK_ENABLE        0
+    #endif
+#endif
+
+
+#endif
@@ -0,0 +1,233 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file defer.c
+ * @brief Time-budgeted execution of post-write handlers
+ *
+ */
+
+#include <string.h>
+#include "defer.h"
+#include "hstats.h"
+
+#if UCDM_DEFER_ENABLE
+
+ucdm_defer_state_t ucdm_defer_states[UCDM_DEFER_MAX_HANDLERS];
+uint8_t ucdm_defer_nstates;
+
+ucdm_defer_ring_t ucdm_defer_rings[UCDM_DEFER_PRIORITIES];
+
+// Entries at the head of each ring which the running poll pass will still 
+// execute. Zero outside of ucdm_defer_poll.
+static uint8_t ucdm_defer_snapshot[UCDM_DEFER_PRIORITIES];
+
+void _ucdm_defer_init(void){
+    ucdm_defer_nstates = 0;
+    for (uint8_t p=0; p < UCDM_DEFER_PRIORITIES; p++){
+        ucdm_defer_rings[p].head = 0;
+        ucdm_defer_rings[p].count = 0;
+        ucdm_defer_snapshot[p] = 0;
+    }
+}
+
+static ucdm_defer_state_t * _ucdm_defer_find(void * handler){
+    for (uint8_t i=0; i < ucdm_defer_nstates; i++){
+        if (ucdm_defer_states[i].handler == handler){
+            return &ucdm_defer_states[i];
+        }
+    }
+    return NULL;
+}
+
+static ucdm_defer_state_t * _ucdm_defer_create(void * handler){
+    if (ucdm_defer_nstates >= UCDM_DEFER_MAX_HANDLERS){
+        return NULL;
+    }
+    ucdm_defer_state_t * state = &ucdm_defer_states[ucdm_defer_nstates++];
+    state->handler = handler;
+    state->deferred = 0;
+    state->fast_runs = 0;
+    state->priority = 0;
+    return state;
+}
+
+uint8_t ucdm_defer_is_deferred(void * handler){
+    ucdm_defer_state_t * state = _ucdm_defer_find(handler);
+    return state ? state->deferred : 0;
+}
+
+HAL_BASE_t ucdm_defer_set_priority(void * handler, uint8_t priority){
+    if (priority >= UCDM_DEFER_PRIORITIES){
+        return 1;
+    }
+    ucdm_defer_state_t * state = _ucdm_defer_find(handler);
+    if (!state){
+        state = _ucdm_defer_create(handler);
+        if (!state){
+            return 2;
+        }
+    }
+    state->priority = priority;
+    return 0;
+}
+
+uint8_t _ucdm_defer_handler(uint8_t type, void * handler, ucdm_addr_t addr, uint16_t mask){
+    ucdm_defer_state_t * state = _ucdm_defer_find(handler);
+    if (!state || !state->deferred){
+        return 0;
+    }
+    ucdm_defer_ring_t * ring = &ucdm_defer_rings[state->priority];
+    if (ring->count >= UCDM_DEFER_QUEUE_LENGTH){
+        return 0;
+    }
+    uint8_t tail = ring->head + ring->count;
+    if (tail >= UCDM_DEFER_QUEUE_LENGTH){
+        tail -= UCDM_DEFER_QUEUE_LENGTH;
+    }
+    ucdm_defer_entry_t * entry = &ring->entries[tail];
+    entry->type = type;
+    entry->handler = handler;
+    entry->addr = addr;
+    entry->mask = mask;
+    ring->count++;
+    return 1;
+}
+
+void _ucdm_defer_replace(uint8_t type, void * handler, ucdm_addr_t addr, void * replacement){
+    for (uint8_t p=0; p < UCDM_DEFER_PRIORITIES; p++){
+        ucdm_defer_ring_t * ring = &ucdm_defer_rings[p];
+        // Entries which are kept are compacted towards the head, in order.
+        uint8_t kept = 0;
+        uint8_t dropped = 0;
+        for (uint8_t i=0; i < ring->count; i++){
+            uint8_t src = ring->head + i;
+            if (src >= UCDM_DEFER_QUEUE_LENGTH){
+                src -= UCDM_DEFER_QUEUE_LENGTH;
+            }
+            ucdm_defer_entry_t * entry = &ring->entries[src];
+            if (entry->type == type && entry->handler == handler && entry->addr == addr){
+                if (!replacement){
+                    if (i < ucdm_defer_snapshot[p]){
+                        dropped++;
+                    }
+                    continue;
+                }
+                entry->handler = replacement;
+            }
+            uint8_t dst = ring->head + kept;
+            if (dst >= UCDM_DEFER_QUEUE_LENGTH){
+                dst -= UCDM_DEFER_QUEUE_LENGTH;
+            }
+            ring->entries[dst] = *entry;
+            kept++;
+        }
+        ring->count = kept;
+        // A poll pass in progress does not run the dropped entries.
+        ucdm_defer_snapshot[p] -= dropped;
+    }
+}
+
+void _ucdm_defer_account(void * handler, ucdm_tick_t elapsed){
+    ucdm_defer_state_t * state = _ucdm_defer_find(handler);
+    if (elapsed > UCDM_HANDLER_BUDGET){
+        if (!state){
+            state = _ucdm_defer_create(handler);
+            if (!state){
+                return;
+            }
+        }
+        state->deferred = 1;
+        state->fast_runs = 0;
+    } else if (state && state->deferred){
+        state->fast_runs++;
+        if (state->fast_runs >= UCDM_DEFER_RECOVERY){
+            state->deferred = 0;
+        }
+    }
+}
+
+uint8_t ucdm_defer_poll(void){
+    uint8_t executed = 0;
+    ucdm_defer_entry_t entry;
+    ucdm_defer_ring_t * ring;
+    #if UCDM_DEFER_POLL_BUDGET
+    ucdm_tick_t pass_start = ucdm_tick();
+    #endif
+    ucdm_tick_t start, elapsed;
+    // Only drain what is queued now. Handlers which write registers may 
+    // queue further work, which is left for the next pass. Handlers which 
+    // remove pool handlers shrink the snapshot through _ucdm_defer_replace.
+    uint8_t * n = &ucdm_defer_snapshot[0];
+    for (uint8_t p=0; p < UCDM_DEFER_PRIORITIES; p++){
+        n[p] = ucdm_defer_rings[p].count;
+    }
+    uint8_t p = UCDM_DEFER_PRIORITIES;
+    while (p--){
+        ring = &ucdm_defer_rings[p];
+        while (n[p]){
+            #if UCDM_DEFER_POLL_BUDGET
+            if (executed && (ucdm_tick() - pass_start) >= UCDM_DEFER_POLL_BUDGET){
+                memset(n, 0, UCDM_DEFER_PRIORITIES);
+                return executed;
+            }
+            #endif
+            n[p]--;
+            entry = ring->entries[ring->head];
+            ring->head++;
+            if (ring->head == UCDM_DEFER_QUEUE_LENGTH){
+                ring->head = 0;
+            }
+            ring->count--;
+
+            start = ucdm_tick();
+            if (entry.type == UCDM_DEFER_TYPE_BW){
+                ((ucdm_bw_handler_t)(entry.handler))(entry.addr, entry.mask);
+            } else {
+                ((ucdm_rw_handler_t)(entry.handler))(entry.addr);
+            }
+            elapsed = ucdm_tick() - start;
+            #if UCDM_HSTATS_ENABLE
+            _ucdm_hstats_record(entry.handler, entry.addr, elapsed);
+            #endif
+            _ucdm_defer_account(entry.handler, elapsed);
+            executed++;
+        }
+    }
+    return executed;
+}
+
+uint8_t ucdm_defer_pending(void){
+    uint8_t count = 0;
+    for (uint8_t p=0; p < UCDM_DEFER_PRIORITIES; p++){
+        count += ucdm_defer_rings[p].count;
+    }
+    return count;
+}
+
+uint8_t ucdm_defer_pending_class(uint8_t priority){
+    if (priority >= UCDM_DEFER_PRIORITIES){
+        return 0;
+    }
+    return ucdm_defer_rings[priority].count;
+}
+
+#endif
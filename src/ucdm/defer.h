@@ -0,0 +1,161 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file defer.h
+ * @brief Time-budgeted execution of post-write handlers
+ * 
+ * Post-write handlers are normally executed inline, from within 
+ * ucdm_set_register, ucdm_set_bit or ucdm_clear_bit, and therefore 
+ * within the protocol's response time. When APP_UCDM_HANDLER_BUDGET is 
+ * set, every handler execution is timed using ucdm_tick. A handler which 
+ * takes longer than the budget is switched to deferred execution. 
+ * Subsequent invocations of that handler are queued instead, and are 
+ * executed when the application calls ucdm_defer_poll from its main loop. 
+ * 
+ * Deferred executions continue to be timed. Once a deferred handler has 
+ * completed APP_UCDM_DEFER_RECOVERY consecutive executions within the 
+ * budget, it is switched back to inline execution. 
+ * 
+ * Handlers are identified by their function pointer, and state is kept 
+ * for up to APP_UCDM_DEFER_MAX_HANDLERS distinct handlers. A handler takes 
+ * a slot once it is first found to be slow, or when it is assigned a 
+ * priority class, even if it is never slow. The table should therefore be 
+ * sized for the handlers with a priority class plus the handlers expected 
+ * to be slow. Handlers which don't fit in the table are always executed 
+ * inline, and priority classes can't be assigned once it is full. The queue holds up 
+ * to APP_UCDM_DEFER_QUEUE_LENGTH pending executions. If the queue is 
+ * full, the handler is executed inline rather than dropped. 
+ * 
+ * Note that a deferred handler runs after the write which triggered it 
+ * has already been acknowledged, and may see register content written 
+ * after that. Handlers which can't tolerate this should be kept fast. 
+ * 
+ * Handlers can be assigned one of APP_UCDM_DEFER_PRIORITIES priority 
+ * classes, either when they are installed using 
+ * ucdm_install_regw_handler_prio or ucdm_install_bitw_handler_prio, or 
+ * later using ucdm_defer_set_priority. Class 0 is the lowest, and is the 
+ * class of handlers which have not been assigned one. Each class has its 
+ * own queue of APP_UCDM_DEFER_QUEUE_LENGTH entries, and ucdm_defer_poll 
+ * drains the queues highest class first. This way, the reaction to an 
+ * emergency stop coil is not stuck behind a burst of bulk configuration 
+ * writes which happen to have slow handlers. 
+ * 
+ * If APP_UCDM_DEFER_POLL_BUDGET is set, ucdm_defer_poll stops starting 
+ * new handlers once it has been running for that many ticks, and leaves 
+ * the remaining work for the next call. At least one handler is executed 
+ * on each call, so that the queues always make progress. 
+ */
+
+#ifndef UCDM_DEFER_H
+#define UCDM_DEFER_H
+
+#include "ucdm.h"
+
+#if UCDM_DEFER_ENABLE
+
+#include "tick.h"
+
+#define UCDM_DEFER_TYPE_RW          0x00
+#define UCDM_DEFER_TYPE_BW          0x01
+
+typedef struct UCDM_DEFER_STATE_t{
+    void * handler;
+    uint8_t deferred;
+    uint8_t fast_runs;
+    uint8_t priority;
+} ucdm_defer_state_t;
+
+typedef struct UCDM_DEFER_ENTRY_t{
+    void * handler;
+    ucdm_addr_t addr;
+    uint16_t mask;
+    uint8_t type;
+} ucdm_defer_entry_t;
+
+typedef struct UCDM_DEFER_RING_t{
+    ucdm_defer_entry_t entries[UCDM_DEFER_QUEUE_LENGTH];
+    uint8_t head;
+    uint8_t count;
+} ucdm_defer_ring_t;
+
+void _ucdm_defer_init(void);
+
+/**
+ * Queue the handler for deferred execution, if it has been deferred.
+ * Returns 1 if the handler was queued and should not be executed inline.
+ */
+uint8_t _ucdm_defer_handler(uint8_t type, void * handler, ucdm_addr_t addr, uint16_t mask);
+
+/**
+ * Account for a handler execution, switching the handler between inline 
+ * and deferred execution as needed.
+ */
+void _ucdm_defer_account(void * handler, ucdm_tick_t elapsed);
+
+/**
+ * Retarget the queued executions of a handler on a register to another 
+ * handler, or drop them if replacement is NULL. Used when handlers are 
+ * replaced or removed.
+ */
+void _ucdm_defer_replace(uint8_t type, void * handler, ucdm_addr_t addr, void * replacement);
+
+/** 
+ * \brief Execute queued handlers, highest priority class first.
+ * 
+ * Should be called periodically from the application's main loop.
+ * 
+ * @return Number of handlers executed.
+ */
+uint8_t ucdm_defer_poll(void);
+
+/** 
+ * \brief Number of handler executions waiting in all the queues.
+ */
+uint8_t ucdm_defer_pending(void);
+
+/** 
+ * \brief Number of handler executions waiting in the queue of a priority class.
+ * 
+ * @param priority The priority class.
+ */
+uint8_t ucdm_defer_pending_class(uint8_t priority);
+
+/** 
+ * \brief Assign a priority class to a handler.
+ * 
+ * @param handler The handler function.
+ * @param priority The priority class, 0 being the lowest.
+ * @return 0 for success, 1 for bad priority class, 2 if the handler 
+ *         table is full.
+ */
+HAL_BASE_t ucdm_defer_set_priority(void * handler, uint8_t priority);
+
+/** 
+ * \brief Check whether a handler is currently being deferred.
+ * 
+ * @param handler The handler function.
+ * @return 1 if the handler is deferred, 0 if it is executed inline.
+ */
+uint8_t ucdm_defer_is_deferred(void * handler);
+
+#endif
+#endif
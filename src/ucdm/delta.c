@@ -0,0 +1,198 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file delta.c
+ * @brief Delta-compressed register snapshot encoding
+ *
+ */
+
+#include "delta.h"
+
+#if UCDM_DELTA_ENABLE
+
+typedef struct UCDM_DELTA_WRITER_t{
+    uint8_t * buf;
+    uint32_t maxlen;
+    uint32_t pos;
+} ucdm_delta_writer_t;
+
+static inline void _ucdm_delta_put_varint(ucdm_delta_writer_t * w, uint32_t value){
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        if (value){
+            byte |= 0x80;
+        }
+        if (w->pos < w->maxlen){
+            w->buf[w->pos] = byte;
+        }
+        w->pos++;
+    } while (value);
+}
+
+static inline uint8_t _ucdm_delta_varint_length(uint32_t value){
+    uint8_t len = 1;
+    while (value >>= 7){
+        len++;
+    }
+    return len;
+}
+
+static inline uint16_t _ucdm_delta_zigzag(uint16_t prev, uint16_t curr){
+    int16_t diff = (int16_t)(curr - prev);
+    return ((uint16_t)diff << 1) ^ (uint16_t)(diff >> 15);
+}
+
+static inline uint16_t _ucdm_delta_unzigzag(uint16_t prev, uint16_t zz){
+    return prev + ((zz >> 1) ^ (uint16_t)(-(zz & 1)));
+}
+
+uint32_t ucdm_delta_encode(const uint16_t * prev, const uint16_t * curr, uint16_t count,
+                           uint8_t * target, uint32_t maxlen){
+    ucdm_delta_writer_t w = {target, maxlen, 0};
+    uint16_t i = 0, start;
+    _ucdm_delta_put_varint(&w, count);
+    while (i < count){
+        start = i;
+        if (curr[i] == prev[i]){
+            while (i < count && curr[i] == prev[i]){
+                i++;
+            }
+            _ucdm_delta_put_varint(&w, ((uint32_t)(i - start) << 2) | UCDM_DELTA_RUN_SKIP);
+            continue;
+        }
+        // Extend the literal run until two consecutive unchanged registers, 
+        // or the end of the snapshot.
+        uint32_t diff_len = 0, xor_len = 0;
+        while (i < count){
+            if (curr[i] == prev[i] && (i + 1 >= count || curr[i + 1] == prev[i + 1])){
+                break;
+            }
+            diff_len += _ucdm_delta_varint_length(_ucdm_delta_zigzag(prev[i], curr[i]));
+            xor_len += _ucdm_delta_varint_length(prev[i] ^ curr[i]);
+            i++;
+        }
+        uint8_t kind = (xor_len < diff_len) ? UCDM_DELTA_RUN_XOR : UCDM_DELTA_RUN_DIFF;
+        _ucdm_delta_put_varint(&w, ((uint32_t)(i - start) << 2) | kind);
+        for (uint16_t j=start; j < i; j++){
+            _ucdm_delta_put_varint(&w, (kind == UCDM_DELTA_RUN_XOR) ? 
+                                   (uint16_t)(prev[j] ^ curr[j]) : 
+                                   _ucdm_delta_zigzag(prev[j], curr[j]));
+        }
+    }
+    return (w.pos > maxlen) ? 0 : w.pos;
+}
+
+static uint8_t _ucdm_delta_get_varint(const uint8_t ** p, const uint8_t * end, uint32_t * value){
+    uint32_t result = 0;
+    for (uint8_t shift=0; shift < 32; shift += 7){
+        if (*p >= end){
+            return 1;
+        }
+        uint8_t byte = *(*p)++;
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)){
+            *value = result;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static HAL_BASE_t _ucdm_delta_walk(const uint8_t * delta, uint32_t len, 
+                                   uint16_t * snapshot, uint16_t count, uint8_t apply){
+    // Walk the delta, and apply it to the snapshot only if apply is set. 
+    // The delta is checked in full with apply clear before it is applied, 
+    // so that a malformed delta leaves the snapshot as it was.
+    const uint8_t * p = delta;
+    const uint8_t * end = delta + len;
+    uint32_t value, n, i = 0;
+    if (_ucdm_delta_get_varint(&p, end, &value)){
+        return 1;
+    }
+    if (value != count){
+        return 2;
+    }
+    while (i < count){
+        if (_ucdm_delta_get_varint(&p, end, &value)){
+            return 1;
+        }
+        n = value >> 2;
+        if (!n || n > count - i){
+            return 1;
+        }
+        switch (value & 0x03){
+            case UCDM_DELTA_RUN_SKIP:
+                i += n;
+                break;
+            case UCDM_DELTA_RUN_DIFF:
+                for (; n; n--, i++){
+                    if (_ucdm_delta_get_varint(&p, end, &value) || value > 0xFFFF){
+                        return 1;
+                    }
+                    if (apply){
+                        snapshot[i] = _ucdm_delta_unzigzag(snapshot[i], value);
+                    }
+                }
+                break;
+            case UCDM_DELTA_RUN_XOR:
+                for (; n; n--, i++){
+                    if (_ucdm_delta_get_varint(&p, end, &value) || value > 0xFFFF){
+                        return 1;
+                    }
+                    if (apply){
+                        snapshot[i] ^= value;
+                    }
+                }
+                break;
+            default:
+                return 1;
+        }
+    }
+    return (p == end) ? 0 : 1;
+}
+
+HAL_BASE_t ucdm_delta_decode(const uint8_t * delta, uint32_t len, 
+                             uint16_t * snapshot, uint16_t count){
+    HAL_BASE_t rval = _ucdm_delta_walk(delta, len, snapshot, count, 0);
+    if (rval){
+        return rval;
+    }
+    return _ucdm_delta_walk(delta, len, snapshot, count, 1);
+}
+
+HAL_BASE_t ucdm_delta_capture(ucdm_addr_t saddr, uint16_t count, uint16_t * target){
+    if ((uint32_t)saddr + count > UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    for (uint16_t i=0; i < count; i++){
+        uint8_t regr_type = ucdm_acctype[saddr + i] & UCDM_AT_READ_MASK;
+        if (regr_type == UCDM_AT_READ_NORM || regr_type == UCDM_AT_READ_PTR){
+            target[i] = _ucdm_get_register(saddr + i);
+        } else {
+            target[i] = 0xFFFF;
+        }
+    }
+    return 0;
+}
+
+#endif
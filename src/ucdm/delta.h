@@ -0,0 +1,122 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file delta.h
+ * @brief Delta-compressed register snapshot encoding
+ * 
+ * Register map snapshots taken at intervals, for streaming to a host or 
+ * for logging, usually differ in only a few registers. Encoding each 
+ * snapshot as a delta against the previous one is much more compact than 
+ * storing it in full. 
+ * 
+ * A delta is a sequence of LEB128 varints. The first is the number of 
+ * registers in the snapshot. It is followed by runs, each of which starts 
+ * with a header varint of (length << 2) | kind : 
+ * 
+ *  - UCDM_DELTA_RUN_SKIP : length registers which are unchanged. 
+ *  - UCDM_DELTA_RUN_DIFF : length registers, each followed by a varint 
+ *    of the zigzag encoded difference from the previous value. Suits 
+ *    measurements and counters which change by small amounts. 
+ *  - UCDM_DELTA_RUN_XOR : length registers, each followed by a varint 
+ *    of the previous value XOR the new value. Suits status and flag 
+ *    registers in which a few low bits change. 
+ * 
+ * The encoder chooses whichever of the two literal kinds is shorter for 
+ * each run. An isolated unchanged register between changed ones is 
+ * carried in the literal run rather than breaking it up. The runs cover 
+ * the snapshot exactly. 
+ * 
+ * The encoder and decoder work on snapshots held by the caller as arrays 
+ * of register values, and write to caller-provided buffers. Nothing is 
+ * allocated. ucdm_delta_capture fills in a snapshot of the live register 
+ * map. 
+ * 
+ * This is enabled by setting APP_ENABLE_UCDM_DELTA.
+ */
+
+#ifndef UCDM_DELTA_H
+#define UCDM_DELTA_H
+
+#include "ucdm.h"
+
+#if UCDM_DELTA_ENABLE
+
+/**
+ * @name UCDM Delta Run Kinds
+ */
+/**@{*/
+#define UCDM_DELTA_RUN_SKIP         0x00
+#define UCDM_DELTA_RUN_DIFF         0x01
+#define UCDM_DELTA_RUN_XOR          0x02
+/**@}*/
+
+/** 
+ * \brief Upper bound on the length of the delta of a snapshot of count registers.
+ */
+#define UCDM_DELTA_MAX_LENGTH(count)    (3 + 6 * (uint32_t)(count))
+
+/**
+ * \brief Encode a snapshot as a delta against a previous snapshot.
+ * 
+ * @param prev The previous snapshot.
+ * @param curr The current snapshot.
+ * @param count Number of registers in the snapshots.
+ * @param target Buffer to write the delta into.
+ * @param maxlen Size of the buffer.
+ * @return Length of the delta, or 0 if it does not fit in the buffer.
+ */
+uint32_t ucdm_delta_encode(const uint16_t * prev, const uint16_t * curr, uint16_t count,
+                           uint8_t * target, uint32_t maxlen);
+
+/**
+ * \brief Apply a delta to a snapshot.
+ * 
+ * The snapshot is updated in place, from the previous snapshot the delta 
+ * was encoded against to the current one. The whole delta is checked 
+ * before the snapshot is changed, so that the snapshot is left unchanged 
+ * if an error is returned. 
+ * 
+ * @param delta The delta.
+ * @param len Length of the delta.
+ * @param snapshot The snapshot to update.
+ * @param count Number of registers in the snapshot.
+ * @return 0 for success, 1 for a malformed delta, 2 if the delta is for 
+ *         a snapshot of a different size.
+ */
+HAL_BASE_t ucdm_delta_decode(const uint8_t * delta, uint32_t len, 
+                             uint16_t * snapshot, uint16_t count);
+
+/**
+ * \brief Take a snapshot of a range of the live register map.
+ * 
+ * Plain and pointer-read registers are captured. Other registers, whose 
+ * reads may be expensive or have side effects, are captured as 0xFFFF. 
+ * 
+ * @param saddr Address/identifier of the first register.
+ * @param count Number of registers.
+ * @param target Array of count words to be filled in.
+ * @return 0 for success, 1 for register out of range.
+ */
+HAL_BASE_t ucdm_delta_capture(ucdm_addr_t saddr, uint16_t count, uint16_t * target);
+
+#endif
+#endif
@@ -0,0 +1,576 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file devmap.c
+ * @brief Binary device map images
+ *
+ */
+
+#include <string.h>
+#include "devmap.h"
+#include "span.h"
+#include "descriptor.h"
+
+#if UCDM_DEVMAP_ENABLE
+
+#ifdef PIO_NATIVE
+#include <stdio.h>
+#endif
+
+// Access type bits which belong to handlers rather than to the map.
+#define UCDM_DEVMAP_AT_HF           (UCDM_AT_REGW_HF | UCDM_AT_BITW_HF)
+
+#define UCDM_DEVMAP_DATA_MAX_WORDS  126
+
+#if UCDM_ENABLE_DESCRIPTORS
+descriptor_custom_t ucdm_devmap_descriptors[UCDM_DEVMAP_MAX_DESCRIPTORS];
+uint8_t ucdm_devmap_descriptor_count = 0;
+#endif
+
+static inline uint16_t _ucdm_devmap_rd16(const uint8_t * p){
+    return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+
+static inline uint32_t _ucdm_devmap_rd32(const uint8_t * p){
+    return (uint32_t)_ucdm_devmap_rd16(p) | ((uint32_t)_ucdm_devmap_rd16(p + 2) << 16);
+}
+
+static uint16_t _ucdm_devmap_crc(const uint8_t * data, uint32_t len){
+    // CRC-16/CCITT-FALSE
+    uint16_t crc = 0xFFFF;
+    while (len--){
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i=0; i < 8; i++){
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void _ucdm_devmap_bind(ucdm_addr_t addr, uint8_t acctype,
+                              const ucdm_devmap_binding_t * binding, uint32_t offset){
+    uint8_t regr_type = acctype & UCDM_AT_READ_MASK;
+    uint8_t regw_type = acctype & UCDM_AT_REGW_TYPE_MASK;
+    if (regr_type == UCDM_AT_READ_PTR || regw_type == UCDM_AT_REGW_TYPE_PTR){
+        ucdm_register[addr].ptr = binding->ptr + offset;
+    } else if (regr_type == UCDM_AT_READ_FUNC){
+        ucdm_register[addr].rfunc = binding->rfunc;
+    } else if (regw_type == UCDM_AT_REGW_TYPE_FUNC){
+        ucdm_register[addr].wfunc = binding->wfunc;
+    }
+}
+
+static void _ucdm_devmap_unbind(ucdm_addr_t addr, uint8_t acctype){
+    // Leave no stale target behind a register the image does not bind.
+    uint8_t regr_type = acctype & UCDM_AT_READ_MASK;
+    uint8_t regw_type = acctype & UCDM_AT_REGW_TYPE_MASK;
+    if (regr_type == UCDM_AT_READ_PTR || regw_type == UCDM_AT_REGW_TYPE_PTR){
+        ucdm_register[addr].ptr = NULL;
+    } else if (regr_type == UCDM_AT_READ_FUNC){
+        ucdm_register[addr].rfunc = NULL;
+    } else if (regw_type == UCDM_AT_REGW_TYPE_FUNC){
+        ucdm_register[addr].wfunc = NULL;
+    }
+}
+
+static uint8_t _ucdm_devmap_in_span(ucdm_addr_t addr){
+    #if UCDM_SPAN_ENABLE
+    for (uint8_t i=0; i < ucdm_span_count; i++){
+        if (addr >= ucdm_spans[i].saddr && addr < ucdm_spans[i].saddr + ucdm_spans[i].len / 2){
+            return 1;
+        }
+    }
+    #endif
+    return 0;
+}
+
+static uint8_t _ucdm_devmap_has_target(uint8_t acctype){
+    uint8_t regr_type = acctype & UCDM_AT_READ_MASK;
+    uint8_t regw_type = acctype & UCDM_AT_REGW_TYPE_MASK;
+    return regr_type == UCDM_AT_READ_PTR || regr_type == UCDM_AT_READ_FUNC ||
+           regw_type == UCDM_AT_REGW_TYPE_PTR || regw_type == UCDM_AT_REGW_TYPE_FUNC;
+}
+
+static uint8_t _ucdm_devmap_data_acctype(uint8_t acctype){
+    // Plain registers, whose content lives in the register table.
+    uint8_t regr_type = acctype & UCDM_AT_READ_MASK;
+    uint8_t regw_type = acctype & UCDM_AT_REGW_TYPE_MASK;
+    return !_ucdm_devmap_has_target(acctype) &&
+           (regr_type == UCDM_AT_READ_NORM || regw_type == UCDM_AT_REGW_TYPE_NORMAL);
+}
+
+static uint8_t _ucdm_devmap_pending_acctype(const uint8_t * rec, const uint8_t * end, ucdm_addr_t addr){
+    // Access type a register will have once the range records between rec
+    // and end are applied. Used to check records against the configuration
+    // before any of it is applied.
+    uint8_t acctype = ucdm_acctype[addr] & ~UCDM_DEVMAP_AT_HF;
+    while (rec < end){
+        if (rec[0] == UCDM_DEVMAP_REC_RANGE){
+            ucdm_addr_t saddr = _ucdm_devmap_rd16(rec + 2);
+            if (addr >= saddr && (uint32_t)addr < (uint32_t)saddr + _ucdm_devmap_rd16(rec + 4)){
+                acctype = rec[6] & ~UCDM_DEVMAP_AT_HF;
+            }
+        }
+        rec += 2 + rec[1];
+    }
+    return acctype;
+}
+
+static HAL_BASE_t _ucdm_devmap_load_range(const uint8_t * p, uint8_t plen,
+                                          const ucdm_devmap_binding_t * bindings, uint8_t nbindings,
+                                          uint8_t apply){
+    if (plen != 8){
+        return 3;
+    }
+    ucdm_addr_t saddr = _ucdm_devmap_rd16(p);
+    uint16_t count = _ucdm_devmap_rd16(p + 2);
+    uint8_t acctype = p[4] & ~UCDM_DEVMAP_AT_HF;
+    uint8_t bind = p[5];
+    uint16_t offset = _ucdm_devmap_rd16(p + 6);
+    if ((uint32_t)_ucdm_devmap_rd16(p) + count > UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    if (bind != UCDM_DEVMAP_UNBOUND && bind >= nbindings){
+        return 3;
+    }
+    if (!apply){
+        return 0;
+    }
+    for (uint16_t i=0; i < count; i++){
+        ucdm_acctype[saddr + i] = acctype | (ucdm_acctype[saddr + i] & UCDM_DEVMAP_AT_HF);
+        _ucdm_perm_update(saddr + i);
+        if (bind != UCDM_DEVMAP_UNBOUND){
+            _ucdm_devmap_bind(saddr + i, acctype, &bindings[bind], (uint32_t)offset + i);
+        } else {
+            _ucdm_devmap_unbind(saddr + i, acctype);
+        }
+    }
+    return 0;
+}
+
+static HAL_BASE_t _ucdm_devmap_load_data(const uint8_t * p, uint8_t plen,
+                                         const uint8_t * records, uint8_t apply){
+    if (plen < 2 || plen % 2){
+        return 3;
+    }
+    uint8_t count = (plen - 2) / 2;
+    if ((uint32_t)_ucdm_devmap_rd16(p) + count > UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    ucdm_addr_t saddr = _ucdm_devmap_rd16(p);
+    if (!apply){
+        // Only plain registers have content of their own. Writing the 
+        // data field of any other register would clobber its target.
+        for (uint8_t i=0; i < count; i++){
+            if (!_ucdm_devmap_data_acctype(_ucdm_devmap_pending_acctype(records, p - 2, saddr + i))){
+                return 3;
+            }
+        }
+        return 0;
+    }
+    for (uint8_t i=0; i < count; i++){
+        ucdm_register[saddr + i].data = _ucdm_devmap_rd16(p + 2 + 2 * i);
+    }
+    return 0;
+}
+
+static HAL_BASE_t _ucdm_devmap_load_span(const uint8_t * p, uint8_t plen,
+                                         const ucdm_devmap_binding_t * bindings, uint8_t nbindings,
+                                         const uint8_t * records, uint8_t apply){
+    if (plen != 6 || p[5] >= nbindings){
+        return 3;
+    }
+    #if UCDM_SPAN_ENABLE
+    HAL_BASE_t rval;
+    ucdm_addr_t saddr = _ucdm_devmap_rd16(p);
+    if (!apply){
+        if (p[2] < 4 || p[2] % 2 || p[2] / 2 > UCDM_SPAN_MAX_LENGTH){
+            return 3;
+        }
+        if ((uint32_t)saddr + p[2] / 2 > UCDM_MAX_REGISTERS){
+            return 1;
+        }
+        // The span may not overlap an installed span or an earlier span 
+        // in the image.
+        for (uint8_t i=0; i < p[2] / 2; i++){
+            if (_ucdm_devmap_in_span(saddr + i)){
+                return 4;
+            }
+        }
+        for (const uint8_t * rec = records; rec < p - 2; rec += 2 + rec[1]){
+            if (rec[0] == UCDM_DEVMAP_REC_SPAN && 
+                    saddr < _ucdm_devmap_rd16(rec + 2) + rec[4] / 2 && 
+                    _ucdm_devmap_rd16(rec + 2) < saddr + p[2] / 2){
+                return 4;
+            }
+        }
+        return 0;
+    }
+    if (p[3] == UCDM_SPAN_TYPE_WRITE){
+        rval = ucdm_redirect_spanw_func(saddr, p[2], bindings[p[5]].spanw);
+    } else {
+        rval = ucdm_redirect_spanr_buf(saddr, bindings[p[5]].buf, p[2]);
+    }
+    if (rval){
+        return (rval == 1) ? 1 : 4;
+    }
+    ucdm_set_span_order(saddr, p[4]);
+    return 0;
+    #else
+    return 4;
+    #endif
+}
+
+static HAL_BASE_t _ucdm_devmap_load_desc(const uint8_t * p, uint8_t plen, uint8_t apply){
+    if (plen < 1){
+        return 3;
+    }
+    #if UCDM_ENABLE_DESCRIPTORS
+    if (!apply){
+        return 0;
+    }
+    descriptor_custom_t node = {NULL, p[0], (uint8_t)(plen - 1),
+                                DESCRIPTOR_ACCTYPE_PTR, {(void *)(p + 1)}};
+    descriptor_custom_t * dptr = &ucdm_devmap_descriptors[ucdm_devmap_descriptor_count++];
+    memcpy((void *)dptr, &node, sizeof(descriptor_custom_t));
+    descriptor_install(dptr);
+    return 0;
+    #else
+    return 4;
+    #endif
+}
+
+static HAL_BASE_t _ucdm_devmap_walk(const uint8_t * records, const uint8_t * end,
+                                    const ucdm_devmap_binding_t * bindings, uint8_t nbindings,
+                                    uint8_t apply){
+    const uint8_t * rec = records;
+    HAL_BASE_t rval;
+    #if UCDM_SPAN_ENABLE
+    uint8_t nspans = 0;
+    #endif
+    #if UCDM_ENABLE_DESCRIPTORS
+    uint8_t ndescs = 0;
+    #endif
+    while (rec < end){
+        if (end - rec < 2 || end - rec - 2 < rec[1]){
+            return 3;
+        }
+        switch (rec[0]){
+            case UCDM_DEVMAP_REC_RANGE:
+                rval = _ucdm_devmap_load_range(rec + 2, rec[1], bindings, nbindings, apply);
+                break;
+            case UCDM_DEVMAP_REC_DATA:
+                rval = _ucdm_devmap_load_data(rec + 2, rec[1], records, apply);
+                break;
+            case UCDM_DEVMAP_REC_SPAN:
+                rval = _ucdm_devmap_load_span(rec + 2, rec[1], bindings, nbindings, records, apply);
+                #if UCDM_SPAN_ENABLE
+                nspans++;
+                #endif
+                break;
+            case UCDM_DEVMAP_REC_DESC:
+                rval = _ucdm_devmap_load_desc(rec + 2, rec[1], apply);
+                #if UCDM_ENABLE_DESCRIPTORS
+                ndescs++;
+                #endif
+                break;
+            default:
+                // Unknown record types are skipped.
+                rval = 0;
+                break;
+        }
+        if (rval){
+            return rval;
+        }
+        rec += 2 + rec[1];
+    }
+    #if UCDM_SPAN_ENABLE
+    if (nspans > UCDM_SPAN_MAX_COUNT - ucdm_span_count){
+        return 4;
+    }
+    #endif
+    #if UCDM_ENABLE_DESCRIPTORS
+    if (ndescs > UCDM_DEVMAP_MAX_DESCRIPTORS - ucdm_devmap_descriptor_count){
+        return 4;
+    }
+    #endif
+    return 0;
+}
+
+HAL_BASE_t ucdm_devmap_load(const uint8_t * image, uint32_t len,
+                            const ucdm_devmap_binding_t * bindings, uint8_t nbindings){
+    if (len < UCDM_DEVMAP_HEADER_LENGTH ||
+            _ucdm_devmap_rd32(image) != UCDM_DEVMAP_MAGIC ||
+            image[4] != UCDM_DEVMAP_VERSION){
+        return 2;
+    }
+    uint32_t rlen = _ucdm_devmap_rd32(image + 8);
+    const uint8_t * rec = image + UCDM_DEVMAP_HEADER_LENGTH;
+    if (rlen > len - UCDM_DEVMAP_HEADER_LENGTH ||
+            _ucdm_devmap_crc(rec, rlen) != _ucdm_devmap_rd16(image + 12)){
+        return 2;
+    }
+    // Records are checked against the configuration they would produce 
+    // before any of them are applied, so that a bad image leaves the live 
+    // configuration untouched.
+    HAL_BASE_t rval = _ucdm_devmap_walk(rec, rec + rlen, bindings, nbindings, 0);
+    if (rval){
+        return rval;
+    }
+    return _ucdm_devmap_walk(rec, rec + rlen, bindings, nbindings, 1);
+}
+
+typedef struct UCDM_DEVMAP_WRITER_t{
+    uint8_t * buf;
+    uint32_t maxlen;
+    uint32_t pos;
+} ucdm_devmap_writer_t;
+
+static void _ucdm_devmap_put8(ucdm_devmap_writer_t * w, uint8_t value){
+    if (w->pos < w->maxlen){
+        w->buf[w->pos] = value;
+    }
+    w->pos++;
+}
+
+static void _ucdm_devmap_put16(ucdm_devmap_writer_t * w, uint16_t value){
+    _ucdm_devmap_put8(w, value & 0xFF);
+    _ucdm_devmap_put8(w, value >> 8);
+}
+
+static void _ucdm_devmap_put32(ucdm_devmap_writer_t * w, uint32_t value){
+    _ucdm_devmap_put16(w, value & 0xFFFF);
+    _ucdm_devmap_put16(w, value >> 16);
+}
+
+static uint8_t _ucdm_devmap_find_binding(ucdm_addr_t addr, uint8_t acctype, uint16_t * offset,
+                                         const ucdm_devmap_binding_t * bindings, uint8_t nbindings){
+    // Find the binding for the target of a register. Pointer targets are
+    // matched to the closest binding at or below them, since the binding
+    // usually points to the start of an array of which the register is
+    // one word.
+    uint8_t regr_type = acctype & UCDM_AT_READ_MASK;
+    uint8_t regw_type = acctype & UCDM_AT_REGW_TYPE_MASK;
+    uint8_t bind = UCDM_DEVMAP_UNBOUND;
+    *offset = 0;
+    if (regr_type == UCDM_AT_READ_PTR || regw_type == UCDM_AT_REGW_TYPE_PTR){
+        uint16_t * ptr = ucdm_register[addr].ptr;
+        for (uint8_t i=0; i < nbindings; i++){
+            if (bindings[i].ptr && ptr >= bindings[i].ptr && ptr - bindings[i].ptr <= 0xFFFF &&
+                    (bind == UCDM_DEVMAP_UNBOUND || bindings[i].ptr > bindings[bind].ptr)){
+                bind = i;
+            }
+        }
+        if (bind != UCDM_DEVMAP_UNBOUND){
+            *offset = ptr - bindings[bind].ptr;
+        }
+    } else if (regr_type == UCDM_AT_READ_FUNC){
+        for (uint8_t i=0; i < nbindings && bind == UCDM_DEVMAP_UNBOUND; i++){
+            if (bindings[i].rfunc == ucdm_register[addr].rfunc){
+                bind = i;
+            }
+        }
+    } else if (regw_type == UCDM_AT_REGW_TYPE_FUNC){
+        for (uint8_t i=0; i < nbindings && bind == UCDM_DEVMAP_UNBOUND; i++){
+            if (bindings[i].wfunc == ucdm_register[addr].wfunc){
+                bind = i;
+            }
+        }
+    }
+    return bind;
+}
+
+static void _ucdm_devmap_export_ranges(ucdm_devmap_writer_t * w,
+                                       const ucdm_devmap_binding_t * bindings, uint8_t nbindings){
+    uint32_t addr = 0;
+    while (addr < UCDM_MAX_REGISTERS){
+        uint8_t acctype = ucdm_acctype[addr] & ~UCDM_DEVMAP_AT_HF;
+        if (!acctype || _ucdm_devmap_in_span(addr)){
+            addr++;
+            continue;
+        }
+        uint16_t offset, noffset;
+        uint8_t bind = _ucdm_devmap_find_binding(addr, acctype, &offset, bindings, nbindings);
+        uint16_t count = 1;
+        while (addr + count < UCDM_MAX_REGISTERS && count < 0xFFFF){
+            ucdm_addr_t next = addr + count;
+            if ((ucdm_acctype[next] & ~UCDM_DEVMAP_AT_HF) != acctype || _ucdm_devmap_in_span(next)){
+                break;
+            }
+            if (_ucdm_devmap_find_binding(next, acctype, &noffset, bindings, nbindings) != bind){
+                break;
+            }
+            if (bind != UCDM_DEVMAP_UNBOUND && noffset != (uint16_t)(offset + count) &&
+                    ((acctype & UCDM_AT_READ_MASK) == UCDM_AT_READ_PTR ||
+                     (acctype & UCDM_AT_REGW_TYPE_MASK) == UCDM_AT_REGW_TYPE_PTR)){
+                // Pointer targets must be consecutive words of the binding
+                break;
+            }
+            count++;
+        }
+        _ucdm_devmap_put8(w, UCDM_DEVMAP_REC_RANGE);
+        _ucdm_devmap_put8(w, 8);
+        _ucdm_devmap_put16(w, addr);
+        _ucdm_devmap_put16(w, count);
+        _ucdm_devmap_put8(w, acctype);
+        _ucdm_devmap_put8(w, bind);
+        _ucdm_devmap_put16(w, offset);
+        addr += count;
+    }
+}
+
+static uint8_t _ucdm_devmap_has_data(ucdm_addr_t addr){
+    return _ucdm_devmap_data_acctype(ucdm_acctype[addr]);
+}
+
+static void _ucdm_devmap_export_data(ucdm_devmap_writer_t * w){
+    uint32_t addr = 0;
+    while (addr < UCDM_MAX_REGISTERS){
+        if (!_ucdm_devmap_has_data(addr) || _ucdm_devmap_in_span(addr)){
+            addr++;
+            continue;
+        }
+        uint8_t count = 1;
+        while (addr + count < UCDM_MAX_REGISTERS && count < UCDM_DEVMAP_DATA_MAX_WORDS &&
+                _ucdm_devmap_has_data(addr + count) && !_ucdm_devmap_in_span(addr + count)){
+            count++;
+        }
+        _ucdm_devmap_put8(w, UCDM_DEVMAP_REC_DATA);
+        _ucdm_devmap_put8(w, 2 + 2 * count);
+        _ucdm_devmap_put16(w, addr);
+        for (uint8_t i=0; i < count; i++){
+            _ucdm_devmap_put16(w, ucdm_register[addr + i].data);
+        }
+        addr += count;
+    }
+}
+
+static void _ucdm_devmap_export_spans(ucdm_devmap_writer_t * w,
+                                      const ucdm_devmap_binding_t * bindings, uint8_t nbindings){
+    #if UCDM_SPAN_ENABLE
+    for (uint8_t i=0; i < ucdm_span_count; i++){
+        ucdm_span_t * span = &ucdm_spans[i];
+        uint8_t bind = UCDM_DEVMAP_UNBOUND;
+        for (uint8_t j=0; j < nbindings && bind == UCDM_DEVMAP_UNBOUND; j++){
+            if ((span->type == UCDM_SPAN_TYPE_WRITE) ?
+                    (bindings[j].spanw == span->target.wfunc) :
+                    (bindings[j].buf == span->target.buf)){
+                bind = j;
+            }
+        }
+        _ucdm_devmap_put8(w, UCDM_DEVMAP_REC_SPAN);
+        _ucdm_devmap_put8(w, 6);
+        _ucdm_devmap_put16(w, span->saddr);
+        _ucdm_devmap_put8(w, span->len);
+        _ucdm_devmap_put8(w, span->type);
+        _ucdm_devmap_put8(w, span->order);
+        _ucdm_devmap_put8(w, bind);
+    }
+    #endif
+}
+
+#if UCDM_ENABLE_DESCRIPTORS
+static HAL_BASE_t _ucdm_devmap_export_desc(ucdm_devmap_writer_t * w, descriptor_custom_t * dptr){
+    // The list is walked from the tail, so that descriptors are installed
+    // in their original order when the image is loaded.
+    uint8_t content[255];
+    if (!dptr){
+        return 0;
+    }
+    if (_ucdm_devmap_export_desc(w, dptr->next)){
+        return 1;
+    }
+    uint8_t len = descriptor_read(dptr, &content[0]);
+    if (len > 254){
+        // The tag and content must fit in the record's length byte
+        return 1;
+    }
+    _ucdm_devmap_put8(w, UCDM_DEVMAP_REC_DESC);
+    _ucdm_devmap_put8(w, 1 + len);
+    _ucdm_devmap_put8(w, dptr->tag);
+    for (uint8_t i=0; i < len; i++){
+        _ucdm_devmap_put8(w, content[i]);
+    }
+    return 0;
+}
+#endif
+
+uint32_t ucdm_devmap_export(uint8_t * target, uint32_t maxlen,
+                            const ucdm_devmap_binding_t * bindings, uint8_t nbindings){
+    ucdm_devmap_writer_t w = {target, maxlen, UCDM_DEVMAP_HEADER_LENGTH};
+    _ucdm_devmap_export_ranges(&w, bindings, nbindings);
+    _ucdm_devmap_export_data(&w);
+    _ucdm_devmap_export_spans(&w, bindings, nbindings);
+    #if UCDM_ENABLE_DESCRIPTORS
+    if (_ucdm_devmap_export_desc(&w, descriptor_custom_root)){
+        return 0;
+    }
+    #endif
+    if (w.pos > maxlen){
+        return 0;
+    }
+    uint32_t len = w.pos;
+    w.pos = 0;
+    _ucdm_devmap_put32(&w, UCDM_DEVMAP_MAGIC);
+    _ucdm_devmap_put8(&w, UCDM_DEVMAP_VERSION);
+    _ucdm_devmap_put8(&w, 0);
+    _ucdm_devmap_put16(&w, UCDM_MAX_REGISTERS);
+    _ucdm_devmap_put32(&w, len - UCDM_DEVMAP_HEADER_LENGTH);
+    _ucdm_devmap_put16(&w, _ucdm_devmap_crc(target + UCDM_DEVMAP_HEADER_LENGTH,
+                                            len - UCDM_DEVMAP_HEADER_LENGTH));
+    return len;
+}
+
+#ifdef PIO_NATIVE
+
+uint8_t ucdm_devmap_file_buffer[UCDM_DEVMAP_FILE_BUFFER];
+
+HAL_BASE_t ucdm_devmap_load_file(const char * path,
+                                 const ucdm_devmap_binding_t * bindings, uint8_t nbindings){
+    FILE * f = fopen(path, "rb");
+    if (!f){
+        return 2;
+    }
+    size_t len = fread(ucdm_devmap_file_buffer, 1, UCDM_DEVMAP_FILE_BUFFER, f);
+    fclose(f);
+    return ucdm_devmap_load(ucdm_devmap_file_buffer, len, bindings, nbindings);
+}
+
+HAL_BASE_t ucdm_devmap_export_file(const char * path,
+                                   const ucdm_devmap_binding_t * bindings, uint8_t nbindings){
+    uint8_t image[UCDM_DEVMAP_FILE_BUFFER];
+    uint32_t len = ucdm_devmap_export(image, UCDM_DEVMAP_FILE_BUFFER, bindings, nbindings);
+    if (!len){
+        return 2;
+    }
+    FILE * f = fopen(path, "wb");
+    if (!f){
+        return 2;
+    }
+    size_t written = fwrite(image, 1, len, f);
+    fclose(f);
+    return (written == len) ? 0 : 2;
+}
+
+#endif
+
+#endif
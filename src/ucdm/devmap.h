@@ -0,0 +1,169 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file devmap.h
+ * @brief Binary device map images
+ *
+ * A device map image is a compact, versioned binary description of the
+ * UCDM configuration of a device. It can be built into a flash section or,
+ * on native builds, loaded from a file, and is applied at startup with a
+ * single call to ucdm_devmap_load instead of a long sequence of ucdm_*
+ * configuration calls. ucdm_devmap_export produces an image from the live
+ * configuration, so images can be generated by running the existing
+ * configuration code once, on the target or natively.
+ *
+ * All multi-byte fields are little endian. The image starts with a
+ * 14 byte header :
+ *
+ *  - magic (4 bytes) : UCDM_DEVMAP_MAGIC
+ *  - version (1 byte) : UCDM_DEVMAP_VERSION
+ *  - flags (1 byte) : reserved, 0
+ *  - nregs (2 bytes) : UCDM_MAX_REGISTERS of the exporting build
+ *  - rlen (4 bytes) : length of the record section following the header
+ *  - crc (2 bytes) : CRC-16/CCITT-FALSE of the record section
+ *
+ * The header is followed by a sequence of records, each of which is a
+ * type byte, a payload length byte, and the payload :
+ *
+ *  - UCDM_DEVMAP_REC_RANGE : saddr (2), count (2), acctype (1), bind (1),
+ *    offset (2). A run of registers sharing an access type. If bind is
+ *    not UCDM_DEVMAP_UNBOUND, pointer-redirected registers are pointed to
+ *    consecutive words starting offset words after the bound pointer, and
+ *    function-redirected registers to the bound function.
+ *  - UCDM_DEVMAP_REC_DATA : saddr (2), followed by the initial content
+ *    of consecutive plain registers.
+ *  - UCDM_DEVMAP_REC_SPAN : saddr (2), len (1), type (1), order (1),
+ *    bind (1). A read span on a bound buffer or a write span on a bound
+ *    function.
+ *  - UCDM_DEVMAP_REC_DESC : tag (1), followed by the descriptor content.
+ *
+ * Pointers and functions can't be stored in an image. Instead, the
+ * application passes a table of bindings to both the exporter and the
+ * loader, and the image refers to entries in it by index. The exporter
+ * emits UCDM_DEVMAP_UNBOUND for targets which are not in the table, and
+ * the loader leaves those registers with a NULL target. Post-write
+ * handlers are not part of the image, and must be installed by the
+ * application after loading it. Block functions are not supported.
+ *
+ * Descriptors loaded from an image point into the image itself, which
+ * must therefore remain in memory. Up to APP_UCDM_DEVMAP_MAX_DESCRIPTORS
+ * descriptors can be loaded. A descriptor loaded from an image shadows
+ * any existing descriptor with the same tag.
+ *
+ * This is enabled by setting APP_ENABLE_UCDM_DEVMAP.
+ */
+
+#ifndef UCDM_DEVMAP_H
+#define UCDM_DEVMAP_H
+
+#include "ucdm.h"
+
+#if UCDM_DEVMAP_ENABLE
+
+/** Magic number identifying a device map image, "UCMP" */
+#define UCDM_DEVMAP_MAGIC           0x504D4355
+/** Version of the image format */
+#define UCDM_DEVMAP_VERSION         1
+/** Length of the image header */
+#define UCDM_DEVMAP_HEADER_LENGTH   14
+/** Bind index for targets not in the binding table */
+#define UCDM_DEVMAP_UNBOUND         0xFF
+
+/**
+ * @name UCDM Device Map Record Types
+ */
+/**@{*/
+#define UCDM_DEVMAP_REC_RANGE       0x01
+#define UCDM_DEVMAP_REC_DATA        0x02
+#define UCDM_DEVMAP_REC_SPAN        0x03
+#define UCDM_DEVMAP_REC_DESC        0x04
+/**@}*/
+
+/**
+ * \brief Pointer or function a device map image can refer to.
+ */
+typedef union UCDM_DEVMAP_BINDING_t{
+    uint16_t * ptr;
+    uint16_t (*rfunc)(ucdm_addr_t);
+    void (*wfunc)(ucdm_addr_t, uint16_t);
+    void * buf;
+    void (*spanw)(ucdm_addr_t, void *);
+} ucdm_devmap_binding_t;
+
+/**
+ * \brief Apply a device map image to the live configuration.
+ *
+ * The image is applied on top of the current configuration, and would
+ * normally be loaded right after ucdm_init. The header, checksum and every
+ * record are verified before anything is applied, so an image which is 
+ * rejected leaves the configuration unchanged. Data records may only 
+ * address plain registers.
+ *
+ * @param image The image.
+ * @param len Length of the image in bytes.
+ * @param bindings Table of pointers and functions referred to by the image.
+ * @param nbindings Number of entries in the binding table.
+ * @return 0 for success, 1 for register out of range, 2 for bad header,
+ *         version or checksum, 3 for a malformed record or bad binding,
+ *         4 if a span or descriptor could not be installed.
+ */
+HAL_BASE_t ucdm_devmap_load(const uint8_t * image, uint32_t len,
+                            const ucdm_devmap_binding_t * bindings, uint8_t nbindings);
+
+/**
+ * \brief Write the live configuration out as a device map image.
+ *
+ * @param target Buffer to write the image into.
+ * @param maxlen Size of the buffer.
+ * @param bindings Table of pointers and functions to refer to by index.
+ * @param nbindings Number of entries in the binding table.
+ * @return Length of the image, or 0 if it does not fit in the buffer or
+ *         a descriptor is too long to fit in a record.
+ */
+uint32_t ucdm_devmap_export(uint8_t * target, uint32_t maxlen,
+                            const ucdm_devmap_binding_t * bindings, uint8_t nbindings);
+
+#ifdef PIO_NATIVE
+
+/**
+ * \brief Load a device map image from a file.
+ *
+ * The image is read into a static buffer of APP_UCDM_DEVMAP_FILE_BUFFER
+ * bytes, which descriptors loaded from it continue to point into.
+ *
+ * @return As for ucdm_devmap_load, or 2 if the file could not be read.
+ */
+HAL_BASE_t ucdm_devmap_load_file(const char * path,
+                                 const ucdm_devmap_binding_t * bindings, uint8_t nbindings);
+
+/**
+ * \brief Export the live configuration to a device map image file.
+ *
+ * @return 0 for success, 2 if the image could not be written.
+ */
+HAL_BASE_t ucdm_devmap_export_file(const char * path,
+                                   const ucdm_devmap_binding_t * bindings, uint8_t nbindings);
+
+#endif
+
+#endif
+#endif
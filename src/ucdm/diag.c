@@ -0,0 +1,67 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file diag.c
+ * @brief MODBUS style diagnostic counters
+ *
+ */
+
+#include <string.h>
+#include "diag.h"
+
+#if UCDM_ENABLE_DIAGNOSTICS
+
+ucdm_diag_t ucdm_diag;
+
+void _ucdm_diag_init(void){
+    ucdm_diag_clear();
+}
+
+void ucdm_diag_clear(void){
+    memset(&ucdm_diag, 0, sizeof(ucdm_diag_t));
+    ucdm_diagnostic_register = 0;
+    ucdm_exception_status &= ~(UCDM_EXST_READ_REJECTED | UCDM_EXST_WRITE_REJECTED);
+}
+
+HAL_BASE_t ucdm_diag_fc08(uint16_t subfunction, uint16_t * value){
+    switch (subfunction){
+        case 0x0002:
+            *value = ucdm_diagnostic_register;
+            break;
+        case 0x000A:
+            ucdm_diag_clear();
+            *value = 0;
+            break;
+        case 0x000B:
+        case 0x000E:
+            *value = ucdm_diag.messages;
+            break;
+        case 0x000D:
+            *value = ucdm_diag.exception_messages;
+            break;
+        default:
+            return 1;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,176 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file diag.h
+ * @brief MODBUS style diagnostic counters
+ *
+ * UCDM counts protocol accesses to the register map, rejected accesses,
+ * and post-write handler invocations, and classifies rejected accesses
+ * by the MODBUS exception code a slave would return for them. These are 
+ * counted per register, so that a bulk read of 10 registers counts 10 
+ * accesses. UCDM additionally counts messages, once per call to one of 
+ * the protocol access functions, such as ucdm_get_registers, and the 
+ * messages in which any access was rejected. A protocol implementation 
+ * which serves each request with one such call gets the MODBUS message 
+ * counts from these. Counters
+ * are 16 bits wide and wrap, as the MODBUS serial line counters do.
+ * Accesses made from within UCDM subsystems using _ucdm_get_register are
+ * not counted.
+ *
+ * ucdm_diag_fc08 maps the counters onto the MODBUS FC08 (Diagnostics)
+ * sub-functions, so that a MODBUS slave implementation can serve FC08
+ * directly from UCDM :
+ *
+ *  - 0x0002 Return Diagnostic Register : ucdm_diagnostic_register
+ *  - 0x000A Clear Counters and Diagnostic Register
+ *  - 0x000B Return Bus Message Count : messages
+ *  - 0x000D Return Bus Exception Error Count : messages with exceptions
+ *  - 0x000E Return Slave Message Count : messages
+ *
+ * ucdm_diagnostic_register belongs to the application. UCDM defines no
+ * bits in it and never sets any, it only returns it for sub-function
+ * 0x0002 and clears it for sub-function 0x000A. Conditions UCDM detects
+ * itself are reported through the counters and the latched exception
+ * status bits below.
+ *
+ * The remaining counters of the serial line specification concern
+ * framing and are not visible to UCDM. They are left to the protocol
+ * implementation.
+ *
+ * ucdm_exception_status is the MODBUS FC07 (Read Exception Status) byte.
+ * Bits 0 and 1 are the UCDM_EXST_KEEPALIVE_REQ and UCDM_EXST_TIMESYNC_REQ
+ * application requests. UCDM additionally latches UCDM_EXST_READ_REJECTED
+ * and UCDM_EXST_WRITE_REJECTED when an access is rejected. The latched
+ * bits are cleared along with the counters.
+ *
+ * Diagnostics can be compiled out by setting APP_ENABLE_UCDM_DIAGNOSTICS
+ * to 0.
+ */
+
+#ifndef UCDM_DIAG_H
+#define UCDM_DIAG_H
+
+#include "ucdm.h"
+
+#if UCDM_ENABLE_DIAGNOSTICS
+
+/**
+ * @name MODBUS Exception Codes
+ */
+/**@{*/
+#define UCDM_EXCEPTION_ILLEGAL_FUNCTION     0x01
+#define UCDM_EXCEPTION_ILLEGAL_ADDRESS      0x02
+#define UCDM_EXCEPTION_ILLEGAL_VALUE        0x03
+#define UCDM_EXCEPTION_DEVICE_FAILURE       0x04
+/** Number of exception codes counted individually */
+#define UCDM_EXCEPTION_CODES                4
+/**@}*/
+
+typedef struct UCDM_DIAG_t{
+    uint16_t messages;
+    uint16_t exception_messages;
+    uint16_t accesses;
+    uint16_t exceptions;
+    uint16_t rejected_reads;
+    uint16_t rejected_writes;
+    uint16_t handler_calls;
+    uint16_t exception_codes[UCDM_EXCEPTION_CODES];
+} ucdm_diag_t;
+
+/** \brief UCDM diagnostic counters. */
+extern ucdm_diag_t ucdm_diag;
+
+void _ucdm_diag_init(void);
+
+static inline void _ucdm_diag_exception(uint8_t code){
+    ucdm_diag.exceptions++;
+    if (code && code <= UCDM_EXCEPTION_CODES){
+        ucdm_diag.exception_codes[code - 1]++;
+    }
+}
+
+/**
+ * \brief Count an exception.
+ *
+ * Called by UCDM for rejected accesses. Protocol implementations can also
+ * call this for exceptions they raise themselves, such as illegal
+ * function or illegal data value, so that all exceptions are counted in
+ * one place. Each call also counts as a message with an exception.
+ *
+ * @param code MODBUS exception code.
+ */
+static inline void ucdm_diag_exception(uint8_t code){
+    _ucdm_diag_exception(code);
+    ucdm_diag.exception_messages++;
+}
+
+static inline void _ucdm_diag_read(uint8_t rejected){
+    ucdm_diag.accesses++;
+    if (rejected){
+        ucdm_diag.rejected_reads++;
+        ucdm_exception_status |= UCDM_EXST_READ_REJECTED;
+        _ucdm_diag_exception(UCDM_EXCEPTION_ILLEGAL_ADDRESS);
+    }
+}
+
+static inline void _ucdm_diag_write(uint8_t exception){
+    ucdm_diag.accesses++;
+    if (exception){
+        ucdm_diag.rejected_writes++;
+        ucdm_exception_status |= UCDM_EXST_WRITE_REJECTED;
+        _ucdm_diag_exception(exception);
+    }
+}
+
+static inline uint16_t _ucdm_diag_message_begin(void){
+    ucdm_diag.messages++;
+    return ucdm_diag.exceptions;
+}
+
+static inline void _ucdm_diag_message_end(uint16_t exceptions){
+    // exceptions is the count returned by _ucdm_diag_message_begin
+    if (ucdm_diag.exceptions != exceptions){
+        ucdm_diag.exception_messages++;
+    }
+}
+
+static inline void _ucdm_diag_handler(void){
+    ucdm_diag.handler_calls++;
+}
+
+/**
+ * \brief Serve a MODBUS FC08 diagnostics sub-function.
+ *
+ * @param subfunction The FC08 sub-function code.
+ * @param value Pointer to where the returned data field should be stored.
+ * @return 0 for success, 1 if the sub-function is not supported.
+ */
+HAL_BASE_t ucdm_diag_fc08(uint16_t subfunction, uint16_t * value);
+
+/**
+ * \brief Clear all counters, the diagnostic register and the latched
+ *        exception status bits.
+ */
+void ucdm_diag_clear(void);
+
+#endif
+#endif
@@ -0,0 +1,242 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file hpool.c
+ * @brief Library managed pool of post-write handlers
+ *
+ */
+
+#include <string.h>
+#include "hpool.h"
+#include "defer.h"
+
+#if UCDM_HPOOL_ENABLE
+
+ucdm_hpool_entry_t ucdm_hpool[UCDM_MAX_HANDLERS];
+uint8_t ucdm_hpool_count;
+
+void _ucdm_hpool_init(void){
+    memset(&ucdm_hpool, 0, sizeof(ucdm_hpool));
+    ucdm_hpool_count = 0;
+}
+
+static inline uint32_t _ucdm_hpool_key(ucdm_addr_t addr, uint8_t type){
+    return ((uint32_t)addr << 1) | type;
+}
+
+static uint8_t _ucdm_hpool_search(uint32_t key){
+    // Index of the first entry with a key not less than key.
+    uint8_t lo = 0;
+    uint8_t hi = ucdm_hpool_count;
+    while (lo < hi){
+        uint8_t mid = (lo + hi) / 2;
+        if (_ucdm_hpool_key(ucdm_hpool[mid].addr, ucdm_hpool[mid].type) < key){
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+ucdm_hpool_entry_t * _ucdm_hpool_find(ucdm_addr_t addr, uint8_t type){
+    uint8_t idx = _ucdm_hpool_search(_ucdm_hpool_key(addr, type));
+    if (idx < ucdm_hpool_count && ucdm_hpool[idx].addr == addr && 
+            ucdm_hpool[idx].type == type){
+        return &ucdm_hpool[idx];
+    }
+    return NULL;
+}
+
+uint8_t _ucdm_hpool_chain(ucdm_addr_t addr, uint8_t type, uint16_t mask, void ** handlers){
+    uint8_t count = 0;
+    for (ucdm_hpool_entry_t * entry = _ucdm_hpool_find(addr, type); 
+            entry; entry = _ucdm_hpool_next(entry)){
+        if (entry->handler && (entry->mask & mask)){
+            handlers[count++] = entry->handler;
+        }
+    }
+    return count;
+}
+
+static ucdm_hpool_entry_t * _ucdm_hpool_find_handler(ucdm_addr_t addr, uint8_t type, 
+                                                     void * handler){
+    ucdm_hpool_entry_t * entry = _ucdm_hpool_find(addr, type);
+    while (entry && entry->handler != handler){
+        entry = _ucdm_hpool_next(entry);
+    }
+    return entry;
+}
+
+static inline ucdm_acctype_t _ucdm_hpool_flag(uint8_t type){
+    return (type == UCDM_HPOOL_TYPE_RW) ? UCDM_AT_REGW_HF : UCDM_AT_BITW_HF;
+}
+
+static void _ucdm_hpool_delete(uint8_t idx, uint8_t count){
+    #if !UCDM_CONST_CONFIG
+    ucdm_addr_t addr = ucdm_hpool[idx].addr;
+    uint8_t type = ucdm_hpool[idx].type;
+    #endif
+    #if UCDM_DEFER_ENABLE
+    // Executions of the removed handlers which are still queued are dropped.
+    // The pool and defer entry types share their values.
+    for (uint8_t i=idx; i < idx + count; i++){
+        _ucdm_defer_replace(ucdm_hpool[i].type, ucdm_hpool[i].handler, ucdm_hpool[i].addr, NULL);
+    }
+    #endif
+    ucdm_hpool_count -= count;
+    memmove(&ucdm_hpool[idx], &ucdm_hpool[idx + count], 
+            (ucdm_hpool_count - idx) * sizeof(ucdm_hpool_entry_t));
+    #if !UCDM_CONST_CONFIG
+    avlt_t * tree = (type == UCDM_HPOOL_TYPE_RW) ? &ucdm_rwht : &ucdm_bwht;
+    if (!_ucdm_hpool_find(addr, type) && !avlt_find_node(tree, addr)){
+        ucdm_acctype[addr] &= ~_ucdm_hpool_flag(type);
+    }
+    #endif
+}
+
+static HAL_BASE_t _ucdm_hpool_install(ucdm_addr_t addr, uint8_t type, 
+                                      void * handler, uint16_t mask){
+    if (addr >= UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    if (_ucdm_hpool_find_handler(addr, type, handler)){
+        return 3;
+    }
+    if (ucdm_hpool_count >= UCDM_MAX_HANDLERS){
+        return 2;
+    }
+    uint8_t length = 0;
+    for (ucdm_hpool_entry_t * entry = _ucdm_hpool_find(addr, type); 
+            entry; entry = _ucdm_hpool_next(entry)){
+        length++;
+    }
+    if (length >= UCDM_HPOOL_MAX_CHAIN){
+        return 4;
+    }
+    // Insert after the last handler of the chain, to preserve the order 
+    // of installation.
+    uint8_t idx = _ucdm_hpool_search(_ucdm_hpool_key(addr, type) + 1);
+    memmove(&ucdm_hpool[idx + 1], &ucdm_hpool[idx], 
+            (ucdm_hpool_count - idx) * sizeof(ucdm_hpool_entry_t));
+    ucdm_hpool[idx].handler = handler;
+    ucdm_hpool[idx].addr = addr;
+    ucdm_hpool[idx].type = type;
+    ucdm_hpool[idx].mask = mask;
+    ucdm_hpool_count++;
+    #if !UCDM_CONST_CONFIG
+    ucdm_acctype[addr] |= _ucdm_hpool_flag(type);
+    #endif
+    return 0;
+}
+
+static HAL_BASE_t _ucdm_hpool_replace(ucdm_addr_t addr, uint8_t type, 
+                                      void * handler, void * replacement){
+    if (addr >= UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    ucdm_hpool_entry_t * entry = _ucdm_hpool_find_handler(addr, type, handler);
+    if (!entry){
+        return 2;
+    }
+    if (replacement != handler && _ucdm_hpool_find_handler(addr, type, replacement)){
+        return 3;
+    }
+    #if UCDM_DEFER_ENABLE
+    _ucdm_defer_replace(type, handler, addr, replacement);
+    #endif
+    entry->handler = replacement;
+    return 0;
+}
+
+static HAL_BASE_t _ucdm_hpool_remove(ucdm_addr_t addr, uint8_t type, void * handler){
+    if (addr >= UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    ucdm_hpool_entry_t * entry = _ucdm_hpool_find_handler(addr, type, handler);
+    if (!entry){
+        return 2;
+    }
+    _ucdm_hpool_delete(entry - ucdm_hpool, 1);
+    return 0;
+}
+
+static HAL_BASE_t _ucdm_hpool_uninstall(ucdm_addr_t addr, uint8_t type){
+    if (addr >= UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    ucdm_hpool_entry_t * entry = _ucdm_hpool_find(addr, type);
+    if (!entry){
+        return 2;
+    }
+    uint8_t idx = entry - ucdm_hpool;
+    uint8_t count = _ucdm_hpool_search(_ucdm_hpool_key(addr, type) + 1) - idx;
+    _ucdm_hpool_delete(idx, count);
+    return 0;
+}
+
+HAL_BASE_t ucdm_hpool_install_regw(ucdm_addr_t addr, ucdm_rw_handler_t handler){
+    return _ucdm_hpool_install(addr, UCDM_HPOOL_TYPE_RW, (void *)handler, 0xFFFF);
+}
+
+HAL_BASE_t ucdm_hpool_install_bitw(ucdm_addr_t addr, ucdm_bw_handler_t handler){
+    return _ucdm_hpool_install(addr, UCDM_HPOOL_TYPE_BW, (void *)handler, 0xFFFF);
+}
+
+HAL_BASE_t ucdm_hpool_install_bitw_mask(ucdm_addr_t addr, ucdm_bw_handler_t handler, 
+                                        uint16_t mask){
+    return _ucdm_hpool_install(addr, UCDM_HPOOL_TYPE_BW, (void *)handler, mask);
+}
+
+HAL_BASE_t ucdm_hpool_replace_regw(ucdm_addr_t addr, ucdm_rw_handler_t handler, 
+                                   ucdm_rw_handler_t replacement){
+    return _ucdm_hpool_replace(addr, UCDM_HPOOL_TYPE_RW, 
+                               (void *)handler, (void *)replacement);
+}
+
+HAL_BASE_t ucdm_hpool_replace_bitw(ucdm_addr_t addr, ucdm_bw_handler_t handler, 
+                                   ucdm_bw_handler_t replacement){
+    return _ucdm_hpool_replace(addr, UCDM_HPOOL_TYPE_BW, 
+                               (void *)handler, (void *)replacement);
+}
+
+HAL_BASE_t ucdm_hpool_remove_regw(ucdm_addr_t addr, ucdm_rw_handler_t handler){
+    return _ucdm_hpool_remove(addr, UCDM_HPOOL_TYPE_RW, (void *)handler);
+}
+
+HAL_BASE_t ucdm_hpool_remove_bitw(ucdm_addr_t addr, ucdm_bw_handler_t handler){
+    return _ucdm_hpool_remove(addr, UCDM_HPOOL_TYPE_BW, (void *)handler);
+}
+
+HAL_BASE_t ucdm_hpool_uninstall_regw(ucdm_addr_t addr){
+    return _ucdm_hpool_uninstall(addr, UCDM_HPOOL_TYPE_RW);
+}
+
+HAL_BASE_t ucdm_hpool_uninstall_bitw(ucdm_addr_t addr){
+    return _ucdm_hpool_uninstall(addr, UCDM_HPOOL_TYPE_BW);
+}
+
+uint8_t ucdm_hpool_free(void){
+    return UCDM_MAX_HANDLERS - ucdm_hpool_count;
+}
+
+#endif
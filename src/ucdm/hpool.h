@@ -0,0 +1,235 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file hpool.h
+ * @brief Library managed pool of post-write handlers
+ * 
+ * ucdm_install_regw_handler and ucdm_install_bitw_handler require the 
+ * application to provide a tree node for every handler it installs, and 
+ * allow only one handler of each type per register. The handler pool 
+ * provides the same post-write handlers without the caller providing 
+ * storage. Up to APP_UCDM_MAX_HANDLERS handlers can be installed from the 
+ * pool, and they can be removed or replaced at any time. 
+ * 
+ * Several pool handlers can be installed on the same register, so 
+ * that independent subsystems, such as persistence, logging and the 
+ * application itself, can all observe it. The handlers of a register 
+ * form a chain, and are called in the order in which they were installed. 
+ * A handler can be removed from a chain without affecting the others. 
+ * A chain can hold up to APP_UCDM_HPOOL_MAX_CHAIN handlers of each type, 
+ * 4 by default. The chain is copied onto the stack on every handled 
+ * write, so this should be kept to what the application needs. 
+ * 
+ * Bit write handlers can be installed with an interest mask, and are then 
+ * only called for writes to bits within the mask. A register packing 
+ * unrelated coils can have a handler for each subset of them, and a coil 
+ * write only runs the handlers interested in it. Bits outside the masks 
+ * of all the handlers of a register can be written without calling any 
+ * handler. 
+ * 
+ * Pool entries are kept contiguous and sorted by register address, so 
+ * the handlers of a chain are adjacent. A write costs a binary search for 
+ * the head of the chain, followed by a linear walk over it. Installing 
+ * and removing handlers shift the entries above the affected one, which 
+ * is cheap for the pool sizes this is intended for. 
+ * 
+ * Handlers may themselves install, remove or replace pool handlers. The 
+ * chain of a register is copied before its handlers are called, so such 
+ * changes take effect from the next write, and every handler of the 
+ * chain is called exactly once for the write in progress. 
+ * 
+ * Handlers from the pool are dispatched in the same way as handlers 
+ * installed with tree nodes, and are subject to diagnostics, statistics 
+ * and deferral. If a register has both, the handler from the tree node is 
+ * called first. Deferred executions of a pool handler which are still 
+ * queued when it is removed are dropped, also when it is removed by a 
+ * deferred handler during ucdm_defer_poll, and those of a replaced handler 
+ * are passed to its replacement. With a const configuration, the handler flags of the 
+ * registers must already be set in the const access type table. 
+ * 
+ * This is enabled by setting APP_UCDM_MAX_HANDLERS.
+ */
+
+#ifndef UCDM_HPOOL_H
+#define UCDM_HPOOL_H
+
+#include "ucdm.h"
+
+#if UCDM_HPOOL_ENABLE
+
+/**
+ * @name UCDM Handler Pool Entry Types
+ */
+/**@{*/
+#define UCDM_HPOOL_TYPE_RW          0x00
+#define UCDM_HPOOL_TYPE_BW          0x01
+/**@}*/
+
+typedef struct UCDM_HPOOL_ENTRY_t{
+    void * handler;
+    ucdm_addr_t addr;
+    uint8_t type;
+    uint16_t mask;
+} ucdm_hpool_entry_t;
+
+extern ucdm_hpool_entry_t ucdm_hpool[];
+extern uint8_t ucdm_hpool_count;
+
+void _ucdm_hpool_init(void);
+
+/**
+ * \brief Find the head of the chain of pool handlers of a type installed 
+ *        on a register.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param type UCDM_HPOOL_TYPE_RW or UCDM_HPOOL_TYPE_BW.
+ * @return The first pool entry of the chain, or NULL if there is none.
+ */
+ucdm_hpool_entry_t * _ucdm_hpool_find(ucdm_addr_t addr, uint8_t type);
+
+/**
+ * \brief Get the next entry of a chain of pool handlers.
+ * 
+ * @param entry An entry of the chain.
+ * @return The next entry of the chain, or NULL at the end of the chain.
+ */
+static inline ucdm_hpool_entry_t * _ucdm_hpool_next(ucdm_hpool_entry_t * entry){
+    ucdm_hpool_entry_t * next = entry + 1;
+    if (next < &ucdm_hpool[ucdm_hpool_count] && 
+            next->addr == entry->addr && next->type == entry->type){
+        return next;
+    }
+    return NULL;
+}
+
+/**
+ * \brief Copy the handlers of a chain which are interested in a write.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param type UCDM_HPOOL_TYPE_RW or UCDM_HPOOL_TYPE_BW.
+ * @param mask Bits being written, 0xFFFF for register writes.
+ * @param handlers Array of at least UCDM_HPOOL_MAX_CHAIN handlers to fill.
+ * @return The number of handlers copied.
+ */
+uint8_t _ucdm_hpool_chain(ucdm_addr_t addr, uint8_t type, uint16_t mask, void ** handlers);
+
+/** 
+ * \brief Install a Register Write Handler from the pool.
+ * 
+ * The handler is added to the end of the register's chain.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param handler Pointer to the handler function.
+ * @return 0 for success, 1 for register out of range, 2 if the pool is 
+ *         full, 3 if the handler is already installed on the register, 
+ *         4 if the register's chain is full.
+ */
+HAL_BASE_t ucdm_hpool_install_regw(ucdm_addr_t addr, ucdm_rw_handler_t handler);
+
+/** 
+ * \brief Install a Bit Write Handler from the pool.
+ * 
+ * The handler is called for writes to any bit of the register.
+ * 
+ * @see ucdm_hpool_install_regw
+ */
+HAL_BASE_t ucdm_hpool_install_bitw(ucdm_addr_t addr, ucdm_bw_handler_t handler);
+
+/** 
+ * \brief Install a Bit Write Handler from the pool with an interest mask.
+ * 
+ * @param addr Address/identifier of the register.
+ * @param handler Pointer to the handler function.
+ * @param mask Bits of the register the handler is to be called for.
+ * @return As for ucdm_hpool_install_regw.
+ */
+HAL_BASE_t ucdm_hpool_install_bitw_mask(ucdm_addr_t addr, ucdm_bw_handler_t handler, 
+                                        uint16_t mask);
+
+/** 
+ * \brief Replace a pool Register Write Handler of a register.
+ * 
+ * The new handler takes the place of the old one in the chain, and keeps 
+ * its interest mask, so this can not fail for lack of space. 
+ * 
+ * @param addr Address/identifier of the register.
+ * @param handler Pointer to the installed handler function.
+ * @param replacement Pointer to the new handler function.
+ * @return 0 for success, 1 for register out of range, 2 if the handler 
+ *         is not installed on the register, 3 if the replacement is.
+ */
+HAL_BASE_t ucdm_hpool_replace_regw(ucdm_addr_t addr, ucdm_rw_handler_t handler, 
+                                   ucdm_rw_handler_t replacement);
+
+/** 
+ * \brief Replace a pool Bit Write Handler of a register.
+ * 
+ * @see ucdm_hpool_replace_regw
+ */
+HAL_BASE_t ucdm_hpool_replace_bitw(ucdm_addr_t addr, ucdm_bw_handler_t handler, 
+                                   ucdm_bw_handler_t replacement);
+
+/** 
+ * \brief Remove one pool Register Write Handler from a register.
+ * 
+ * The other handlers of the register's chain remain installed, in the 
+ * same order. The register's handler flag is cleared when the last 
+ * handler is removed, unless a handler installed with a tree node 
+ * remains. 
+ * 
+ * @param addr Address/identifier of the register.
+ * @param handler Pointer to the handler function.
+ * @return 0 for success, 1 for register out of range, 2 if the handler 
+ *         is not installed on the register.
+ */
+HAL_BASE_t ucdm_hpool_remove_regw(ucdm_addr_t addr, ucdm_rw_handler_t handler);
+
+/** 
+ * \brief Remove one pool Bit Write Handler from a register.
+ * 
+ * @see ucdm_hpool_remove_regw
+ */
+HAL_BASE_t ucdm_hpool_remove_bitw(ucdm_addr_t addr, ucdm_bw_handler_t handler);
+
+/** 
+ * \brief Uninstall all pool Register Write Handlers of a register.
+ * 
+ * @param addr Address/identifier of the register.
+ * @return 0 for success, 1 for register out of range, 2 if no pool 
+ *         handler is installed on the register.
+ */
+HAL_BASE_t ucdm_hpool_uninstall_regw(ucdm_addr_t addr);
+
+/** 
+ * \brief Uninstall all pool Bit Write Handlers of a register.
+ * 
+ * @see ucdm_hpool_uninstall_regw
+ */
+HAL_BASE_t ucdm_hpool_uninstall_bitw(ucdm_addr_t addr);
+
+/** 
+ * \brief Get the number of free entries in the handler pool.
+ */
+uint8_t ucdm_hpool_free(void);
+
+#endif
+#endif
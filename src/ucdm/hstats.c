@@ -0,0 +1,112 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file hstats.c
+ * @brief Execution time statistics for post-write handlers
+ *
+ */
+
+#include <string.h>
+#include "hstats.h"
+
+#if UCDM_HSTATS_ENABLE
+
+ucdm_hstats_entry_t ucdm_hstats[UCDM_HSTATS_MAX_HANDLERS];
+uint8_t ucdm_hstats_count;
+
+void _ucdm_hstats_init(void){
+    ucdm_hstats_reset();
+}
+
+void ucdm_hstats_reset(void){
+    memset(&ucdm_hstats, 0, sizeof(ucdm_hstats));
+    ucdm_hstats_count = 0;
+}
+
+static inline uint8_t _ucdm_hstats_bucket(ucdm_tick_t elapsed){
+    uint8_t bucket;
+    if (!elapsed){
+        return 0;
+    }
+    // floor(log2(elapsed)) + 1
+    bucket = (8 * sizeof(unsigned long)) - __builtin_clzl((unsigned long)elapsed);
+    if (bucket >= UCDM_HSTATS_BUCKETS){
+        bucket = UCDM_HSTATS_BUCKETS - 1;
+    }
+    return bucket;
+}
+
+ucdm_hstats_entry_t * ucdm_hstats_find(void * handler){
+    for (uint8_t i=0; i < ucdm_hstats_count; i++){
+        if (ucdm_hstats[i].handler == handler){
+            return &ucdm_hstats[i];
+        }
+    }
+    return NULL;
+}
+
+void _ucdm_hstats_record(void * handler, ucdm_addr_t addr, ucdm_tick_t elapsed){
+    ucdm_hstats_entry_t * entry = ucdm_hstats_find(handler);
+    if (!entry){
+        if (ucdm_hstats_count >= UCDM_HSTATS_MAX_HANDLERS){
+            return;
+        }
+        entry = &ucdm_hstats[ucdm_hstats_count++];
+        entry->handler = handler;
+    }
+    entry->count++;
+    entry->total += elapsed;
+    if (elapsed >= entry->max){
+        entry->max = elapsed;
+        entry->addr = addr;
+    }
+    uint8_t bucket = _ucdm_hstats_bucket(elapsed);
+    if (entry->buckets[bucket] < 0xFFFF){
+        entry->buckets[bucket]++;
+    }
+}
+
+uint8_t ucdm_hstats_worst(ucdm_hstats_entry_t ** target, uint8_t n){
+    // Insertion sort into the target. n and the table are expected to be 
+    // small, and this is not called from any time critical path.
+    uint8_t found = 0;
+    uint8_t j;
+    for (uint8_t i=0; i < ucdm_hstats_count; i++){
+        ucdm_hstats_entry_t * entry = &ucdm_hstats[i];
+        j = found;
+        while (j && target[j-1]->max < entry->max){
+            if (j < n){
+                target[j] = target[j-1];
+            }
+            j--;
+        }
+        if (j < n){
+            target[j] = entry;
+            if (found < n){
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+#endif
@@ -0,0 +1,93 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file hstats.h
+ * @brief Execution time statistics for post-write handlers
+ * 
+ * When enabled, every invocation of a post-write handler from 
+ * ucdm_set_register, ucdm_set_bit or ucdm_clear_bit is timed using 
+ * ucdm_tick, and the execution time is recorded against the handler in 
+ * a histogram with log2 sized buckets. Bucket 0 counts executions which 
+ * took 0 ticks, and bucket n counts executions which took between 
+ * 2^(n-1) and 2^n - 1 ticks. The last bucket also absorbs everything 
+ * longer. 
+ * 
+ * The resolution of the measurement is that of the installed tick source. 
+ * On native builds, the default source counts microseconds. On MCUs, a 
+ * free running timer clocked at or near the core clock gives the most 
+ * useful results. 
+ * 
+ * Statistics are kept for up to APP_UCDM_HSTATS_MAX_HANDLERS distinct 
+ * handler functions. Handlers are identified by their function pointer, 
+ * so a handler installed on several registers accumulates a single 
+ * histogram. Handlers executed after the table is full are not recorded. 
+ * ucdm_hstats_worst can be used to find the handlers most likely to 
+ * blow a protocol response deadline. 
+ */
+
+#ifndef UCDM_HSTATS_H
+#define UCDM_HSTATS_H
+
+#include "ucdm.h"
+
+#if UCDM_HSTATS_ENABLE
+
+#include "tick.h"
+
+typedef struct UCDM_HSTATS_ENTRY_t{
+    void * handler;
+    ucdm_addr_t addr;
+    uint32_t count;
+    ucdm_tick_t max;
+    ucdm_tick_t total;
+    uint16_t buckets[UCDM_HSTATS_BUCKETS];
+} ucdm_hstats_entry_t;
+
+void _ucdm_hstats_init(void);
+
+void _ucdm_hstats_record(void * handler, ucdm_addr_t addr, ucdm_tick_t elapsed);
+
+/** 
+ * \brief Get the handlers with the longest worst case execution time.
+ * 
+ * @param target Array to fill with pointers to the statistics entries, 
+ *               in order of decreasing worst case execution time.
+ * @param n Maximum number of entries to return.
+ * @return Number of entries returned.
+ */
+uint8_t ucdm_hstats_worst(ucdm_hstats_entry_t ** target, uint8_t n);
+
+/** 
+ * \brief Get the statistics entry for a handler function.
+ * 
+ * @param handler The handler function.
+ * @return The statistics entry, or NULL if the handler has not executed.
+ */
+ucdm_hstats_entry_t * ucdm_hstats_find(void * handler);
+
+/** 
+ * \brief Clear all handler statistics.
+ */
+void ucdm_hstats_reset(void);
+
+#endif
+#endif
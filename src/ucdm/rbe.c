@@ -0,0 +1,158 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file rbe.c
+ * @brief Report-by-exception with per-register deadbands
+ *
+ */
+
+#include "rbe.h"
+
+#if UCDM_RBE_ENABLE
+
+ucdm_rbe_entry_t ucdm_rbe_entries[UCDM_RBE_MAX_COUNT];
+uint8_t ucdm_rbe_count;
+
+hashmap_t ucdm_rbe_map = {0};
+hashmap_entry_t ucdm_rbe_table[UCDM_RBE_MAX_COUNT];
+
+ucdm_rbe_entry_t * ucdm_rbe_queue[UCDM_RBE_QUEUE_LENGTH];
+uint16_t ucdm_rbe_queue_head;
+uint16_t ucdm_rbe_queue_count;
+uint16_t ucdm_rbe_overflow;
+
+void _ucdm_rbe_init(void){
+    ucdm_rbe_count = 0;
+    ucdm_rbe_queue_head = 0;
+    ucdm_rbe_queue_count = 0;
+    ucdm_rbe_overflow = 0;
+    hashmap_init(&ucdm_rbe_map, &ucdm_rbe_table[0], UCDM_RBE_MAX_COUNT);
+}
+
+HAL_BASE_t ucdm_rbe_install(ucdm_addr_t addr, uint8_t flags, uint16_t deadband){
+    if (addr >= UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    ucdm_rbe_entry_t * entry;
+    hashmap_entry_t * hentry = hashmap_get(&ucdm_rbe_map, addr);
+    if (hentry != NULL){
+        entry = (ucdm_rbe_entry_t *)hentry->ptr;
+    } else {
+        if (ucdm_rbe_count >= UCDM_RBE_MAX_COUNT){
+            return 2;
+        }
+        entry = &ucdm_rbe_entries[ucdm_rbe_count];
+        entry->addr = addr;
+        entry->queued = 0;
+        hashmap_insert(&ucdm_rbe_map, addr, (void *)entry, 0);
+        ucdm_rbe_count++;
+    }
+    entry->flags = flags;
+    entry->deadband = deadband;
+    entry->last = _ucdm_get_register(addr);
+    return 0;
+}
+
+static uint8_t _ucdm_rbe_exceeded(ucdm_rbe_entry_t * entry, uint16_t value){
+    uint16_t diff, ref;
+    if (entry->flags & UCDM_RBE_SIGNED){
+        int32_t sdiff = (int32_t)(int16_t)value - (int16_t)entry->last;
+        diff = (sdiff < 0) ? -sdiff : sdiff;
+        ref = ((int16_t)entry->last < 0) ? -(int32_t)(int16_t)entry->last : entry->last;
+    } else {
+        diff = (value > entry->last) ? value - entry->last : entry->last - value;
+        ref = entry->last;
+    }
+    if (!diff){
+        return 0;
+    }
+    if ((entry->flags & UCDM_RBE_DB_MASK) == UCDM_RBE_DB_PERCENT){
+        return ((uint32_t)diff * 100 > (uint32_t)entry->deadband * ref);
+    } 
+    return (diff > entry->deadband);
+}
+
+static void _ucdm_rbe_enqueue(ucdm_rbe_entry_t * entry){
+    if (ucdm_rbe_queue_count >= UCDM_RBE_QUEUE_LENGTH){
+        ucdm_rbe_overflow++;
+        return;
+    }
+    uint16_t tail = ucdm_rbe_queue_head + ucdm_rbe_queue_count;
+    if (tail >= UCDM_RBE_QUEUE_LENGTH){
+        tail -= UCDM_RBE_QUEUE_LENGTH;
+    }
+    ucdm_rbe_queue[tail] = entry;
+    ucdm_rbe_queue_count++;
+    entry->queued = 1;
+}
+
+static inline void _ucdm_rbe_check_entry(ucdm_rbe_entry_t * entry, uint16_t value){
+    if (!entry->queued && _ucdm_rbe_exceeded(entry, value)){
+        _ucdm_rbe_enqueue(entry);
+    }
+}
+
+void _ucdm_rbe_check(ucdm_addr_t addr, uint16_t value){
+    hashmap_entry_t * hentry = hashmap_get(&ucdm_rbe_map, addr);
+    if (hentry == NULL){
+        return;
+    }
+    _ucdm_rbe_check_entry((ucdm_rbe_entry_t *)hentry->ptr, value);
+}
+
+void ucdm_rbe_check(ucdm_addr_t addr){
+    if (addr >= UCDM_MAX_REGISTERS){
+        return;
+    }
+    _ucdm_rbe_check(addr, _ucdm_get_register(addr));
+}
+
+void ucdm_rbe_poll(void){
+    ucdm_rbe_entry_t * entry;
+    for (uint8_t i=0; i < ucdm_rbe_count; i++){
+        entry = &ucdm_rbe_entries[i];
+        _ucdm_rbe_check_entry(entry, _ucdm_get_register(entry->addr));
+    }
+}
+
+HAL_BASE_t ucdm_rbe_pop(ucdm_addr_t * addr, uint16_t * value){
+    if (!ucdm_rbe_queue_count){
+        return 1;
+    }
+    ucdm_rbe_entry_t * entry = ucdm_rbe_queue[ucdm_rbe_queue_head];
+    ucdm_rbe_queue_head++;
+    if (ucdm_rbe_queue_head >= UCDM_RBE_QUEUE_LENGTH){
+        ucdm_rbe_queue_head = 0;
+    }
+    ucdm_rbe_queue_count--;
+    entry->queued = 0;
+    entry->last = _ucdm_get_register(entry->addr);
+    *addr = entry->addr;
+    *value = entry->last;
+    return 0;
+}
+
+uint16_t ucdm_rbe_pending(void){
+    return ucdm_rbe_queue_count;
+}
+
+#endif
@@ -0,0 +1,132 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file rbe.h
+ * @brief Report-by-exception with per-register deadbands
+ *
+ * Registers registered with the report-by-exception (RBE) engine are
+ * compared against the value last reported for them whenever they are
+ * written via ucdm_set_register, or whenever the application signals an
+ * internal update using ucdm_rbe_check. Registers whose value has moved
+ * by more than the configured deadband are placed in a bounded report
+ * queue, from which a telemetry task can pull them using ucdm_rbe_pop.
+ *
+ * Registers which are redirected to pointers change without UCDM ever
+ * seeing the write. Applications can either call ucdm_rbe_check after
+ * updating the underlying variable, or call ucdm_rbe_poll periodically
+ * to scan all monitored registers.
+ *
+ * A register is only queued once, no matter how many times it changes
+ * before it is popped. The value reported is the value of the register
+ * at the time it is popped, and this becomes the new reference for the
+ * deadband.
+ *
+ * The number of monitored registers is set by APP_UCDM_RBE_MAX_COUNT, and
+ * the length of the report queue by APP_UCDM_RBE_QUEUE_LENGTH.
+ */
+
+#ifndef UCDM_RBE_H
+#define UCDM_RBE_H
+
+#include "ucdm.h"
+
+#if UCDM_RBE_ENABLE
+
+#include <ds/hashmap.h>
+
+/**
+ * @name UCDM RBE Deadband Type Definitions
+ */
+/**@{*/
+/** Mask for RBE deadband type */
+#define UCDM_RBE_DB_MASK            0x01
+/** Deadband is an absolute difference in register counts */
+#define UCDM_RBE_DB_ABSOLUTE        0x00
+/** Deadband is a percentage of the last reported value */
+#define UCDM_RBE_DB_PERCENT         0x01
+/** Register content should be interpreted as int16_t */
+#define UCDM_RBE_SIGNED             0x02
+/**@}*/
+
+typedef struct UCDM_RBE_ENTRY_t{
+    ucdm_addr_t addr;
+    uint8_t flags;
+    uint8_t queued;
+    uint16_t deadband;
+    uint16_t last;
+} ucdm_rbe_entry_t;
+
+void _ucdm_rbe_init(void);
+
+void _ucdm_rbe_check(ucdm_addr_t addr, uint16_t value);
+
+/**
+ * \brief Monitor a UCDM register for report-by-exception.
+ *
+ * The current value of the register is taken as the initial reference.
+ * Installing a register which is already monitored replaces its deadband
+ * configuration and reference in place, and does not use up a slot. A
+ * pending report for the register stays in the queue.
+ *
+ * @param addr Address/identifier of the register.
+ * @param flags Deadband type, optionally OR'd with UCDM_RBE_SIGNED.
+ * @param deadband Deadband, in register counts or in percent depending on
+ *                 the type. A deadband of 0 reports every change.
+ * @return 0 for success, 1 for register out of range, 2 if no free slots.
+ */
+HAL_BASE_t ucdm_rbe_install(ucdm_addr_t addr, uint8_t flags, uint16_t deadband);
+
+/**
+ * \brief Check a monitored register after an internal update.
+ *
+ * Should be called by the application after it changes the content
+ * behind a monitored register without going through ucdm_set_register.
+ * Has no effect on registers which are not monitored.
+ *
+ * @param addr Address/identifier of the register.
+ */
+void ucdm_rbe_check(ucdm_addr_t addr);
+
+/**
+ * \brief Check all monitored registers.
+ */
+void ucdm_rbe_poll(void);
+
+/**
+ * \brief Pop the next register to be reported from the report queue.
+ *
+ * @param addr Pointer to where the register address should be stored
+ * @param value Pointer to where the reported value should be stored
+ * @return 0 if a register was popped, 1 if the queue is empty.
+ */
+HAL_BASE_t ucdm_rbe_pop(ucdm_addr_t * addr, uint16_t * value);
+
+/**
+ * \brief Number of registers waiting in the report queue.
+ */
+uint16_t ucdm_rbe_pending(void);
+
+/** \brief Number of reports dropped because the queue was full. */
+extern uint16_t ucdm_rbe_overflow;
+
+#endif
+#endif
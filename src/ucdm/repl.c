@@ -0,0 +1,343 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file repl.c
+ * @brief Register change replication to a standby instance
+ *
+ */
+
+#include "repl.h"
+
+#if UCDM_REPL_ENABLE
+
+// Registers carried by a single snapshot frame
+#define UCDM_REPL_SNAPSHOT_CHUNK    ((UCDM_REPL_PAYLOAD_LENGTH - 2) / 2)
+
+typedef struct UCDM_REPL_DELTA_t{
+    ucdm_addr_t addr;
+    uint16_t value;
+} ucdm_repl_delta_t;
+
+static ucdm_repl_sink_t ucdm_repl_sink = NULL;
+static uint32_t ucdm_repl_seq;
+static ucdm_repl_delta_t ucdm_repl_batch[UCDM_REPL_BATCH];
+static uint8_t ucdm_repl_nbatch;
+#if UCDM_REPL_SNAPSHOT_INTERVAL
+static uint16_t ucdm_repl_since_snapshot;
+#endif
+static uint8_t ucdm_repl_frame[UCDM_REPL_FRAME_LENGTH];
+
+static uint32_t ucdm_repl_expected;
+static uint8_t ucdm_repl_in_sync;
+static ucdm_addr_t ucdm_repl_snapshot_next;
+
+void _ucdm_repl_init(void){
+    ucdm_repl_sink = NULL;
+    ucdm_repl_nbatch = 0;
+    ucdm_repl_in_sync = 0;
+    ucdm_repl_snapshot_next = 0;
+}
+
+static inline uint16_t _ucdm_repl_rd16(const uint8_t * p){
+    return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+
+static inline void _ucdm_repl_wr16(uint8_t * p, uint16_t value){
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+static uint16_t _ucdm_repl_crc(const uint8_t * data, uint16_t len){
+    // CRC-16/CCITT-FALSE
+    uint16_t crc = 0xFFFF;
+    while (len--){
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i=0; i < 8; i++){
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static inline uint8_t _ucdm_repl_replicated(ucdm_addr_t addr){
+    uint8_t regr_type = ucdm_acctype[addr] & UCDM_AT_READ_MASK;
+    return regr_type == UCDM_AT_READ_NORM || regr_type == UCDM_AT_READ_PTR;
+}
+
+static void _ucdm_repl_emit(uint8_t type, uint8_t flags, uint16_t len){
+    uint8_t * f = ucdm_repl_frame;
+    f[0] = type;
+    f[1] = flags;
+    _ucdm_repl_wr16(f + 2, ucdm_repl_seq & 0xFFFF);
+    _ucdm_repl_wr16(f + 4, ucdm_repl_seq >> 16);
+    _ucdm_repl_wr16(f + 6, len);
+    len += UCDM_REPL_HEADER_LENGTH;
+    _ucdm_repl_wr16(f + len, _ucdm_repl_crc(f, len));
+    ucdm_repl_seq++;
+    ucdm_repl_sink(f, len + 2);
+}
+
+static void _ucdm_repl_snapshot(void){
+    uint8_t * p = ucdm_repl_frame + UCDM_REPL_HEADER_LENGTH;
+    uint32_t addr = 0;
+    // The sink may stop the producer partway through, if its stream fails.
+    while (addr < UCDM_MAX_REGISTERS && ucdm_repl_sink){
+        uint16_t n = UCDM_REPL_SNAPSHOT_CHUNK;
+        if (n > UCDM_MAX_REGISTERS - addr){
+            n = UCDM_MAX_REGISTERS - addr;
+        }
+        _ucdm_repl_wr16(p, addr);
+        for (uint16_t i=0; i < n; i++){
+            _ucdm_repl_wr16(p + 2 + 2 * i, _ucdm_repl_replicated(addr + i) ? 
+                                           _ucdm_get_register(addr + i) : 0xFFFF);
+        }
+        addr += n;
+        _ucdm_repl_emit(UCDM_REPL_FRAME_SNAPSHOT, 
+                        (addr == UCDM_MAX_REGISTERS) ? UCDM_REPL_FLAG_LAST : 0, 2 + 2 * n);
+    }
+    #if UCDM_REPL_SNAPSHOT_INTERVAL
+    ucdm_repl_since_snapshot = 0;
+    #endif
+}
+
+void ucdm_repl_start(ucdm_repl_sink_t sink){
+    ucdm_repl_sink = sink;
+    ucdm_repl_seq = 0;
+    ucdm_repl_nbatch = 0;
+    _ucdm_repl_snapshot();
+}
+
+void ucdm_repl_stop(void){
+    ucdm_repl_sink = NULL;
+    ucdm_repl_nbatch = 0;
+}
+
+uint8_t ucdm_repl_running(void){
+    return ucdm_repl_sink != NULL;
+}
+
+void ucdm_repl_flush(void){
+    if (!ucdm_repl_sink || !ucdm_repl_nbatch){
+        return;
+    }
+    uint8_t * p = ucdm_repl_frame + UCDM_REPL_HEADER_LENGTH;
+    for (uint8_t i=0; i < ucdm_repl_nbatch; i++){
+        _ucdm_repl_wr16(p + 4 * i, ucdm_repl_batch[i].addr);
+        _ucdm_repl_wr16(p + 4 * i + 2, ucdm_repl_batch[i].value);
+    }
+    _ucdm_repl_emit(UCDM_REPL_FRAME_DELTA, 0, 4 * ucdm_repl_nbatch);
+    ucdm_repl_nbatch = 0;
+    #if UCDM_REPL_SNAPSHOT_INTERVAL
+    if (++ucdm_repl_since_snapshot >= UCDM_REPL_SNAPSHOT_INTERVAL){
+        _ucdm_repl_snapshot();
+    }
+    #endif
+}
+
+void ucdm_repl_resync(void){
+    if (!ucdm_repl_sink){
+        return;
+    }
+    ucdm_repl_flush();
+    _ucdm_repl_snapshot();
+}
+
+void _ucdm_repl_capture(ucdm_addr_t addr){
+    // Called after a register is written.
+    if (!ucdm_repl_sink || !_ucdm_repl_replicated(addr)){
+        return;
+    }
+    uint16_t value = _ucdm_get_register(addr);
+    for (uint8_t i=0; i < ucdm_repl_nbatch; i++){
+        if (ucdm_repl_batch[i].addr == addr){
+            ucdm_repl_batch[i].value = value;
+            return;
+        }
+    }
+    ucdm_repl_batch[ucdm_repl_nbatch].addr = addr;
+    ucdm_repl_batch[ucdm_repl_nbatch].value = value;
+    ucdm_repl_nbatch++;
+    if (ucdm_repl_nbatch == UCDM_REPL_BATCH){
+        ucdm_repl_flush();
+    }
+}
+
+static void _ucdm_repl_store(ucdm_addr_t addr, uint16_t value){
+    if (addr >= UCDM_MAX_REGISTERS){
+        return;
+    }
+    switch (ucdm_acctype[addr] & UCDM_AT_READ_MASK){
+        case UCDM_AT_READ_NORM:
+            *_ucdm_register_data(addr) = value;
+            break;
+        case UCDM_AT_READ_PTR:
+            if (ucdm_register[addr].ptr){
+                *(ucdm_register[addr].ptr) = value;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+HAL_BASE_t ucdm_repl_apply(const uint8_t * frame, uint16_t len){
+    if (len < UCDM_REPL_HEADER_LENGTH + 2){
+        return UCDM_REPL_MALFORMED;
+    }
+    uint16_t plen = _ucdm_repl_rd16(frame + 6);
+    if (len != UCDM_REPL_HEADER_LENGTH + plen + 2 || 
+            _ucdm_repl_crc(frame, UCDM_REPL_HEADER_LENGTH + plen) != 
+            _ucdm_repl_rd16(frame + UCDM_REPL_HEADER_LENGTH + plen)){
+        return UCDM_REPL_MALFORMED;
+    }
+    uint8_t type = frame[0];
+    uint32_t seq = (uint32_t)_ucdm_repl_rd16(frame + 2) | ((uint32_t)_ucdm_repl_rd16(frame + 4) << 16);
+    const uint8_t * p = frame + UCDM_REPL_HEADER_LENGTH;
+    
+    if (type == UCDM_REPL_FRAME_DELTA){
+        if (plen % 4){
+            return UCDM_REPL_MALFORMED;
+        }
+        if (!ucdm_repl_in_sync){
+            return UCDM_REPL_WAITING;
+        }
+        if (seq != ucdm_repl_expected){
+            ucdm_repl_in_sync = 0;
+            ucdm_repl_snapshot_next = 0;
+            return UCDM_REPL_GAP;
+        }
+        for (uint16_t i=0; i < plen; i += 4){
+            _ucdm_repl_store(_ucdm_repl_rd16(p + i), _ucdm_repl_rd16(p + i + 2));
+        }
+        ucdm_repl_expected = seq + 1;
+        return UCDM_REPL_APPLIED;
+    }
+    
+    if (type != UCDM_REPL_FRAME_SNAPSHOT || plen < 2 || plen % 2){
+        return UCDM_REPL_MALFORMED;
+    }
+    // A snapshot is accepted from its first frame onwards, and has to be 
+    // received in sequence to the end before the consumer is in sync.
+    ucdm_addr_t saddr = _ucdm_repl_rd16(p);
+    if (saddr == 0){
+        ucdm_repl_in_sync = 0;
+    } else if (saddr != ucdm_repl_snapshot_next || seq != ucdm_repl_expected){
+        ucdm_repl_in_sync = 0;
+        ucdm_repl_snapshot_next = 0;
+        return UCDM_REPL_GAP;
+    }
+    for (uint16_t i=0; i < (plen - 2) / 2; i++){
+        _ucdm_repl_store(saddr + i, _ucdm_repl_rd16(p + 2 + 2 * i));
+    }
+    ucdm_repl_snapshot_next = saddr + (plen - 2) / 2;
+    ucdm_repl_expected = seq + 1;
+    if (frame[1] & UCDM_REPL_FLAG_LAST){
+        ucdm_repl_in_sync = 1;
+        ucdm_repl_snapshot_next = 0;
+    }
+    return UCDM_REPL_APPLIED;
+}
+
+uint8_t ucdm_repl_synced(void){
+    return ucdm_repl_in_sync;
+}
+
+#ifdef PIO_NATIVE
+
+#include <errno.h>
+#include <unistd.h>
+
+static int ucdm_repl_fd = -1;
+
+static void _ucdm_repl_sink_fd(const uint8_t * frame, uint16_t len){
+    while (len){
+        ssize_t n = write(ucdm_repl_fd, frame, len);
+        if (n < 0 && errno == EINTR){
+            continue;
+        }
+        if (n <= 0){
+            // Part of the frame may already be in the stream, and frames 
+            // carry no synchronisation marker. Nothing more can be sent 
+            // on this stream, so that the consumer sees it end rather 
+            // than misread the frames which follow.
+            close(ucdm_repl_fd);
+            ucdm_repl_fd = -1;
+            ucdm_repl_stop();
+            return;
+        }
+        frame += n;
+        len -= n;
+    }
+}
+
+void ucdm_repl_start_fd(int fd){
+    ucdm_repl_fd = fd;
+    ucdm_repl_start(_ucdm_repl_sink_fd);
+}
+
+// Frame being received by ucdm_repl_receive_fd, kept across calls so 
+// that frames can arrive in pieces on non-blocking descriptors.
+static uint8_t ucdm_repl_rx[UCDM_REPL_FRAME_LENGTH];
+static uint16_t ucdm_repl_rx_len = 0;
+
+static HAL_BASE_t _ucdm_repl_receive_fail(int fd, HAL_BASE_t rval){
+    // The frame boundaries of the stream are lost, so it can't be used 
+    // further. The consumer waits for a snapshot on the next stream.
+    close(fd);
+    ucdm_repl_rx_len = 0;
+    ucdm_repl_in_sync = 0;
+    ucdm_repl_snapshot_next = 0;
+    return rval;
+}
+
+HAL_BASE_t ucdm_repl_receive_fd(int fd){
+    uint16_t need = UCDM_REPL_HEADER_LENGTH;
+    while (1){
+        if (ucdm_repl_rx_len >= UCDM_REPL_HEADER_LENGTH){
+            uint16_t plen = _ucdm_repl_rd16(ucdm_repl_rx + 6);
+            if (plen > UCDM_REPL_PAYLOAD_LENGTH){
+                return _ucdm_repl_receive_fail(fd, UCDM_REPL_MALFORMED);
+            }
+            need = UCDM_REPL_HEADER_LENGTH + plen + 2;
+        }
+        if (ucdm_repl_rx_len == need){
+            break;
+        }
+        ssize_t n = read(fd, ucdm_repl_rx + ucdm_repl_rx_len, need - ucdm_repl_rx_len);
+        if (n < 0 && errno == EINTR){
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){
+            return UCDM_REPL_INCOMPLETE;
+        }
+        if (n <= 0){
+            return _ucdm_repl_receive_fail(fd, UCDM_REPL_READ_ERROR);
+        }
+        ucdm_repl_rx_len += n;
+    }
+    ucdm_repl_rx_len = 0;
+    return ucdm_repl_apply(ucdm_repl_rx, need);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,222 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file repl.h
+ * @brief Register change replication to a standby instance
+ * 
+ * In a redundant controller pair, the standby unit keeps a copy of the 
+ * register map of the active unit, so that it can take over without 
+ * losing state. The replication producer on the active unit captures 
+ * every successful register write, whether made by ucdm_set_register, 
+ * ucdm_set_registers, or the bit write functions, and emits the changes 
+ * as a stream of sequence-numbered frames. The replication consumer on 
+ * the standby unit applies the stream to its own register map. 
+ * 
+ * Replication covers plain and pointer-read registers, which are the 
+ * registers holding state. Function registers are not replicated. Both 
+ * units are expected to share the same register configuration. 
+ * Replicated values are stored directly on the standby, and do not run 
+ * post-write handlers there. 
+ * 
+ * Each frame consists of an 8 byte header, a payload, and a CRC. All 
+ * multi-byte fields are little endian : 
+ * 
+ *  - type (1 byte) : UCDM_REPL_FRAME_DELTA or UCDM_REPL_FRAME_SNAPSHOT
+ *  - flags (1 byte) : UCDM_REPL_FLAG_LAST on the last snapshot frame
+ *  - seq (4 bytes) : sequence number, incremented with every frame
+ *  - len (2 bytes) : length of the payload
+ *  - payload
+ *  - crc (2 bytes) : CRC-16/CCITT-FALSE of the header and payload
+ * 
+ * The payload of a delta frame is a batch of up to APP_UCDM_REPL_BATCH 
+ * (addr, value) pairs of 2 bytes each. Changes are accumulated in the 
+ * batch until it is full or the application calls ucdm_repl_flush, and 
+ * repeated writes to a register within a batch are coalesced. The payload 
+ * of a snapshot frame is the address of the first register it covers, 
+ * followed by the values of consecutive registers. A full snapshot is a 
+ * run of snapshot frames covering the whole register map, the last of 
+ * which carries UCDM_REPL_FLAG_LAST. 
+ * 
+ * The consumer tracks the sequence number. A frame out of sequence means 
+ * frames have been lost, and the consumer discards deltas until it 
+ * receives a full snapshot. The application forwards the resync request 
+ * to the producer, which calls ucdm_repl_resync. The producer also emits 
+ * a full snapshot when it is started and, if APP_UCDM_REPL_SNAPSHOT_INTERVAL 
+ * is set, after every that many delta frames. 
+ * 
+ * Frames are handed to a sink function installed by the application, and 
+ * the transport is left to the application. On native builds, frames can 
+ * be written to and read from a file descriptor such as a pipe or a 
+ * socket using ucdm_repl_start_fd and ucdm_repl_receive_fd. 
+ * 
+ * A unit normally runs either the producer or the consumer. The consumer 
+ * does not feed the producer, so a unit running both does not echo 
+ * replicated changes back. 
+ * 
+ * This is enabled by setting APP_UCDM_REPL_BATCH. 
+ */
+
+#ifndef UCDM_REPL_H
+#define UCDM_REPL_H
+
+#include "ucdm.h"
+
+#if UCDM_REPL_ENABLE
+
+/** Length of the frame header */
+#define UCDM_REPL_HEADER_LENGTH     8
+/** Length of the largest frame payload */
+#define UCDM_REPL_PAYLOAD_LENGTH    (4 * UCDM_REPL_BATCH)
+/** Length of the largest frame */
+#define UCDM_REPL_FRAME_LENGTH      (UCDM_REPL_HEADER_LENGTH + UCDM_REPL_PAYLOAD_LENGTH + 2)
+
+/**
+ * @name UCDM Replication Frame Types
+ */
+/**@{*/
+#define UCDM_REPL_FRAME_DELTA       0x01
+#define UCDM_REPL_FRAME_SNAPSHOT    0x02
+/**@}*/
+
+/** Flag marking the last frame of a snapshot */
+#define UCDM_REPL_FLAG_LAST         0x01
+
+/**
+ * @name UCDM Replication Consumer Results
+ */
+/**@{*/
+/** The frame was applied */
+#define UCDM_REPL_APPLIED           0
+/** The frame is malformed or fails its CRC check */
+#define UCDM_REPL_MALFORMED         1
+/** Frames were lost. Deltas are discarded until a snapshot is received */
+#define UCDM_REPL_GAP               2
+/** The frame was discarded while waiting for a snapshot */
+#define UCDM_REPL_WAITING           3
+/** The stream failed and was closed. Returned by ucdm_repl_receive_fd only */
+#define UCDM_REPL_READ_ERROR        4
+/** Part of a frame has been received. Returned by ucdm_repl_receive_fd only */
+#define UCDM_REPL_INCOMPLETE        5
+/**@}*/
+
+/**
+ * \brief Replication sink function.
+ * 
+ * @param frame The frame.
+ * @param len Length of the frame.
+ */
+typedef void (*ucdm_repl_sink_t)(const uint8_t * frame, uint16_t len);
+
+void _ucdm_repl_init(void);
+
+void _ucdm_repl_capture(ucdm_addr_t addr);
+
+/**
+ * \brief Start the replication producer.
+ * 
+ * Emits a full snapshot to the sink right away.
+ * 
+ * @param sink Function to hand frames to.
+ */
+void ucdm_repl_start(ucdm_repl_sink_t sink);
+
+/**
+ * \brief Stop the replication producer. Pending changes are discarded.
+ */
+void ucdm_repl_stop(void);
+
+/**
+ * \brief Check whether the replication producer is running.
+ * 
+ * @return 1 if running, 0 if stopped.
+ */
+uint8_t ucdm_repl_running(void);
+
+/**
+ * \brief Emit the pending batch of changes, if any.
+ * 
+ * Should be called periodically from the application's main loop, so 
+ * that changes are not held back until the batch fills up.
+ */
+void ucdm_repl_flush(void);
+
+/**
+ * \brief Emit the pending batch followed by a full snapshot.
+ */
+void ucdm_repl_resync(void);
+
+/**
+ * \brief Apply a frame to the local register map.
+ * 
+ * @param frame The frame.
+ * @param len Length of the frame.
+ * @return UCDM_REPL_APPLIED, UCDM_REPL_MALFORMED, UCDM_REPL_GAP or 
+ *         UCDM_REPL_WAITING.
+ */
+HAL_BASE_t ucdm_repl_apply(const uint8_t * frame, uint16_t len);
+
+/**
+ * \brief Check whether the consumer is in sync with the producer.
+ * 
+ * @return 1 if in sync, 0 if waiting for a snapshot.
+ */
+uint8_t ucdm_repl_synced(void);
+
+#ifdef PIO_NATIVE
+
+/**
+ * \brief Start the replication producer, writing frames to a file descriptor.
+ * 
+ * Interrupted writes are retried. If a write fails otherwise, including 
+ * with EAGAIN on a non-blocking descriptor, the frame being written may 
+ * be left torn in the stream. The descriptor is then closed and the 
+ * producer stopped, which the application can detect with 
+ * ucdm_repl_running. The consumer sees the stream end and falls out of 
+ * sync. The application should open a new stream and restart the 
+ * producer on it. 
+ */
+void ucdm_repl_start_fd(int fd);
+
+/**
+ * \brief Read a single frame from a file descriptor and apply it.
+ * 
+ * Blocks until a whole frame has been read, unless the file descriptor 
+ * is non-blocking. On a non-blocking descriptor, the part of the frame 
+ * available is kept, and the rest is read by later calls, which should 
+ * be made when the descriptor is readable again. Only one descriptor can 
+ * be received from at a time.
+ * 
+ * Frames carry no synchronisation marker, so the stream can't be resumed 
+ * after an error, a closed stream, or a frame with an invalid length. In 
+ * these cases the descriptor is closed and the consumer falls out of sync. 
+ * The application should open a new stream and have the producer send a 
+ * snapshot on it. 
+ * 
+ * @return As for ucdm_repl_apply, UCDM_REPL_INCOMPLETE if the frame is 
+ *         not complete yet, or UCDM_REPL_READ_ERROR if the stream failed.
+ */
+HAL_BASE_t ucdm_repl_receive_fd(int fd);
+
+#endif
+
+#endif
+#endif
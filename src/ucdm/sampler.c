@@ -0,0 +1,195 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file sampler.c
+ * @brief Periodic register sampler with FIFO readout
+ *
+ */
+
+#include <string.h>
+#include "sampler.h"
+
+#if UCDM_SAMPLER_ENABLE
+
+ucdm_addr_t ucdm_sampler_channels[UCDM_SAMPLER_MAX_CHANNELS];
+uint8_t ucdm_sampler_nchannels;
+
+uint16_t ucdm_sampler_buffer[UCDM_SAMPLER_BUFFER_LENGTH];
+uint16_t ucdm_sampler_capacity;
+uint16_t ucdm_sampler_head;
+uint16_t ucdm_sampler_count;
+uint16_t ucdm_sampler_overrun;
+
+uint16_t ucdm_sampler_fifo[UCDM_SAMPLER_FIFO_WINDOW];
+
+static ucdm_tick_t ucdm_sampler_period;
+static ucdm_tick_t ucdm_sampler_last;
+static uint8_t ucdm_sampler_running;
+static uint8_t ucdm_sampler_fifo_installed;
+
+static inline uint8_t _ucdm_sampler_record_length(void){
+    return 2 + ucdm_sampler_nchannels;
+}
+
+static void _ucdm_sampler_reset(void){
+    ucdm_sampler_head = 0;
+    ucdm_sampler_count = 0;
+    ucdm_sampler_overrun = 0;
+    ucdm_sampler_capacity = UCDM_SAMPLER_BUFFER_LENGTH / _ucdm_sampler_record_length();
+}
+
+void _ucdm_sampler_init(void){
+    ucdm_sampler_nchannels = 0;
+    ucdm_sampler_period = 0;
+    ucdm_sampler_running = 0;
+    ucdm_sampler_fifo_installed = 0;
+    _ucdm_sampler_reset();
+}
+
+HAL_BASE_t ucdm_sampler_add_channel(ucdm_addr_t addr){
+    if (addr >= UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    if (ucdm_sampler_nchannels >= UCDM_SAMPLER_MAX_CHANNELS){
+        return 2;
+    }
+    if (ucdm_sampler_fifo_installed && 
+            _ucdm_sampler_record_length() + 1 > UCDM_SAMPLER_FIFO_WINDOW){
+        // A record which does not fit in the window would never drain.
+        return 3;
+    }
+    ucdm_sampler_channels[ucdm_sampler_nchannels++] = addr;
+    _ucdm_sampler_reset();
+    return 0;
+}
+
+void ucdm_sampler_set_period(ucdm_tick_t period){
+    ucdm_sampler_period = period;
+}
+
+void ucdm_sampler_start(void){
+    ucdm_sampler_last = ucdm_tick() - ucdm_sampler_period;
+    ucdm_sampler_running = 1;
+}
+
+void ucdm_sampler_stop(void){
+    ucdm_sampler_running = 0;
+}
+
+static void _ucdm_sampler_capture(ucdm_tick_t now){
+    uint16_t idx;
+    uint16_t * record;
+    if (ucdm_sampler_count == ucdm_sampler_capacity){
+        ucdm_sampler_head++;
+        if (ucdm_sampler_head == ucdm_sampler_capacity){
+            ucdm_sampler_head = 0;
+        }
+        ucdm_sampler_count--;
+        ucdm_sampler_overrun++;
+    }
+    idx = ucdm_sampler_head + ucdm_sampler_count;
+    if (idx >= ucdm_sampler_capacity){
+        idx -= ucdm_sampler_capacity;
+    }
+    record = &ucdm_sampler_buffer[idx * _ucdm_sampler_record_length()];
+    record[0] = now & 0xFFFF;
+    record[1] = now >> 16;
+    for (uint8_t i=0; i < ucdm_sampler_nchannels; i++){
+        record[2 + i] = _ucdm_get_register(ucdm_sampler_channels[i]);
+    }
+    ucdm_sampler_count++;
+}
+
+uint8_t ucdm_sampler_poll(void){
+    if (!ucdm_sampler_running){
+        return 0;
+    }
+    ucdm_tick_t now = ucdm_tick();
+    ucdm_tick_t elapsed = now - ucdm_sampler_last;
+    if (elapsed < ucdm_sampler_period){
+        return 0;
+    }
+    if (elapsed < 2 * ucdm_sampler_period){
+        // Stay on the sampling grid as long as we aren't falling behind
+        ucdm_sampler_last += ucdm_sampler_period;
+    } else {
+        ucdm_sampler_last = now;
+    }
+    _ucdm_sampler_capture(now);
+    return 1;
+}
+
+void ucdm_sampler_trigger(void){
+    _ucdm_sampler_capture(ucdm_tick());
+}
+
+uint16_t ucdm_sampler_available(void){
+    return ucdm_sampler_count;
+}
+
+uint16_t ucdm_sampler_drain(uint16_t * target, uint16_t maxrecords){
+    uint8_t reclen = _ucdm_sampler_record_length();
+    uint16_t n = 0;
+    while (n < maxrecords && ucdm_sampler_count){
+        memcpy(target, 
+               &ucdm_sampler_buffer[ucdm_sampler_head * reclen], 
+               reclen * sizeof(uint16_t));
+        target += reclen;
+        ucdm_sampler_head++;
+        if (ucdm_sampler_head == ucdm_sampler_capacity){
+            ucdm_sampler_head = 0;
+        }
+        ucdm_sampler_count--;
+        n++;
+    }
+    return n;
+}
+
+uint16_t _ucdm_sampler_fifo_prep(ucdm_addr_t addr){
+    // Latch as many whole records as will fit into the window. This 
+    // function is called on every read of the FIFO count register, 
+    // whoever the reader is. The registers which follow it point into 
+    // the latched window. 
+    uint16_t n = ucdm_sampler_drain(
+        &ucdm_sampler_fifo[0], 
+        UCDM_SAMPLER_FIFO_WINDOW / _ucdm_sampler_record_length()
+    );
+    return n * _ucdm_sampler_record_length();
+}
+
+HAL_BASE_t ucdm_sampler_install_fifo(ucdm_addr_t saddr){
+    if (_ucdm_sampler_record_length() > UCDM_SAMPLER_FIFO_WINDOW){
+        return 2;
+    }
+    if (saddr + UCDM_SAMPLER_FIFO_WINDOW < UCDM_MAX_REGISTERS){
+        ucdm_sampler_fifo_installed = 1;
+        ucdm_redirect_regr_func(saddr, &_ucdm_sampler_fifo_prep);
+        for (uint8_t i=0; i < UCDM_SAMPLER_FIFO_WINDOW; i++){
+            ucdm_redirect_regr_ptr(saddr + 1 + i, &ucdm_sampler_fifo[i]);
+        }
+        return 0;
+    } else {
+        return 1;
+    }
+}
+
+#endif
@@ -0,0 +1,152 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file sampler.h
+ * @brief Periodic register sampler with FIFO readout
+ * 
+ * The sampler takes snapshots of a configured list of UCDM registers at 
+ * a fixed period, and stores them along with a timestamp in a preallocated 
+ * ring buffer. Each record in the ring buffer is laid out as : 
+ * 
+ *  - Timestamp, low word
+ *  - Timestamp, high word
+ *  - One word for each configured channel, in the order they were added
+ * 
+ * Registers are read using ucdm_get_register, so all read redirection 
+ * types can be sampled. Timestamps are obtained from ucdm_tick. 
+ * 
+ * Sampling is driven by the application, either by calling 
+ * ucdm_sampler_poll from the main loop or by calling ucdm_sampler_trigger
+ * from a timer interrupt. If the ring buffer is full, the oldest record is 
+ * discarded and ucdm_sampler_overrun is incremented. The sampler does not 
+ * do any locking of its own. If samples are taken from an interrupt, the 
+ * application must ensure the ring buffer is drained with that interrupt 
+ * masked.
+ * 
+ * The ring buffer can be drained in bulk by the application using 
+ * ucdm_sampler_drain, or by a master through a FIFO register window 
+ * installed with ucdm_sampler_install_fifo. The window follows the 
+ * semantics of MODBUS FC24 (Read FIFO Queue) : reading the first register 
+ * of the window pops as many whole records as will fit into the window 
+ * and returns the number of words popped. The words themselves are then 
+ * available in the registers which follow. 
+ * 
+ * Popping happens on any read of the count register, whatever path the 
+ * read takes. Popped records are gone once the next read of the count 
+ * register replaces the window contents. Register views, span reads, 
+ * report-by-exception scans, shared memory publishing and any other 
+ * consumer which reads the count register will therefore drain and 
+ * discard records. Keep the count register out of such mechanisms, and 
+ * leave only the master which consumes the FIFO reading it. 
+ * 
+ * Every record must fit in the window. ucdm_sampler_install_fifo and 
+ * ucdm_sampler_add_channel refuse configurations where it would not, 
+ * since such a FIFO would never drain. 
+ * 
+ * The number of channels is limited by APP_UCDM_SAMPLER_MAX_CHANNELS. The 
+ * ring buffer is sized to hold APP_UCDM_SAMPLER_DEPTH records when all 
+ * channels are in use, and holds proportionally more records when fewer 
+ * channels are configured. The number of data registers in the FIFO 
+ * window is set by APP_UCDM_SAMPLER_FIFO_WINDOW.
+ */
+
+#ifndef UCDM_SAMPLER_H
+#define UCDM_SAMPLER_H
+
+#include "ucdm.h"
+
+#if UCDM_SAMPLER_ENABLE
+
+#include "tick.h"
+
+#define UCDM_SAMPLER_BUFFER_LENGTH  (UCDM_SAMPLER_DEPTH * (2 + UCDM_SAMPLER_MAX_CHANNELS))
+
+void _ucdm_sampler_init(void);
+
+/**
+ * \brief Add a register to the list of sampled registers.
+ * 
+ * Any samples already in the ring buffer are discarded. 
+ * 
+ * @param addr Address/identifier of the register.
+ * @return 0 for success, 1 for register out of range, 2 if no free channels, 
+ *         3 if a FIFO window is installed and the longer record would not 
+ *         fit in it.
+ */
+HAL_BASE_t ucdm_sampler_add_channel(ucdm_addr_t addr);
+
+/**
+ * \brief Set the sampling period.
+ * 
+ * @param period Sampling period, in ticks of the installed tick source.
+ */
+void ucdm_sampler_set_period(ucdm_tick_t period);
+
+/** \brief Start periodic sampling from ucdm_sampler_poll. */
+void ucdm_sampler_start(void);
+
+/** \brief Stop periodic sampling from ucdm_sampler_poll. */
+void ucdm_sampler_stop(void);
+
+/**
+ * \brief Take a sample if the sampling period has elapsed.
+ * 
+ * @return 1 if a sample was taken, 0 otherwise.
+ */
+uint8_t ucdm_sampler_poll(void);
+
+/** \brief Take a sample immediately. */
+void ucdm_sampler_trigger(void);
+
+/** \brief Number of records in the ring buffer. */
+uint16_t ucdm_sampler_available(void);
+
+/**
+ * \brief Pop records from the ring buffer.
+ * 
+ * @param target Buffer for the records. Must be large enough to hold 
+ *               maxrecords records of (2 + channels) words each.
+ * @param maxrecords Maximum number of records to pop.
+ * @return Number of records popped.
+ */
+uint16_t ucdm_sampler_drain(uint16_t * target, uint16_t maxrecords);
+
+/**
+ * \brief Expose the ring buffer as a FIFO register window.
+ * 
+ * Configures read access on saddr to return the FIFO count, and on the 
+ * APP_UCDM_SAMPLER_FIFO_WINDOW registers which follow to return the 
+ * popped words. Each read of saddr pops records from the ring buffer. 
+ * 
+ * Channels should be added before the FIFO is installed. 
+ * 
+ * @param saddr Address/identifier of the FIFO count register.
+ * @return 0 for success, 1 for register out of range, 2 if a record with 
+ *         the configured channels does not fit in the window.
+ */
+HAL_BASE_t ucdm_sampler_install_fifo(ucdm_addr_t saddr);
+
+/** \brief Number of records discarded because the ring buffer was full. */
+extern uint16_t ucdm_sampler_overrun;
+
+#endif
+#endif
@@ -0,0 +1,201 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file shm.c
+ * @brief Shared memory register image for host tooling on native builds
+ *
+ */
+
+#include "shm.h"
+
+#if UCDM_SHM_ENABLE
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Attempts a reader makes to get a consistent copy before giving up.
+#define UCDM_SHM_SNAPSHOT_RETRIES   1000
+
+static ucdm_shm_image_t * ucdm_shm_image = NULL;
+static int ucdm_shm_fd = -1;
+
+static inline void _ucdm_shm_write_begin(void){
+    uint32_t seq = __atomic_load_n(&ucdm_shm_image->seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&ucdm_shm_image->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void _ucdm_shm_write_end(void){
+    uint32_t seq = __atomic_load_n(&ucdm_shm_image->seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&ucdm_shm_image->seq, seq + 1, __ATOMIC_RELEASE);
+}
+
+static inline void _ucdm_shm_write_word(ucdm_addr_t addr, uint16_t value){
+    __atomic_store_n(&ucdm_shm_image->data[addr], value, __ATOMIC_RELAXED);
+}
+
+static inline uint8_t _ucdm_shm_publishable(ucdm_addr_t addr){
+    // Function-read registers are only read when the application asks for
+    // them, since reading them may be expensive or have side effects.
+    uint8_t regr_type = ucdm_acctype[addr] & UCDM_AT_READ_MASK;
+    return (regr_type == UCDM_AT_READ_NORM || regr_type == UCDM_AT_READ_PTR);
+}
+
+static HAL_BASE_t _ucdm_shm_map(int fd){
+    if (fd < 0){
+        return 2;
+    }
+    if (ftruncate(fd, sizeof(ucdm_shm_image_t))){
+        close(fd);
+        return 2;
+    }
+    void * image = mmap(NULL, sizeof(ucdm_shm_image_t),
+                        PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (image == MAP_FAILED){
+        close(fd);
+        return 2;
+    }
+    ucdm_shm_close();
+    ucdm_shm_fd = fd;
+    ucdm_shm_image = (ucdm_shm_image_t *)image;
+    // Readers check the magic before anything else, so it goes in last.
+    ucdm_shm_image->magic = 0;
+    ucdm_shm_image->version = UCDM_SHM_VERSION;
+    ucdm_shm_image->nregs = UCDM_MAX_REGISTERS;
+    ucdm_shm_image->seq = 0;
+    memset(ucdm_shm_image->data, 0, sizeof(ucdm_shm_image->data));
+    ucdm_shm_publish();
+    __atomic_store_n(&ucdm_shm_image->magic, UCDM_SHM_MAGIC, __ATOMIC_RELEASE);
+    return 0;
+}
+
+HAL_BASE_t ucdm_shm_open(const char * name){
+    return _ucdm_shm_map(shm_open(name, O_CREAT | O_RDWR, 0644));
+}
+
+HAL_BASE_t ucdm_shm_open_file(const char * path){
+    return _ucdm_shm_map(open(path, O_CREAT | O_RDWR, 0644));
+}
+
+void ucdm_shm_close(void){
+    if (ucdm_shm_image){
+        munmap(ucdm_shm_image, sizeof(ucdm_shm_image_t));
+        ucdm_shm_image = NULL;
+    }
+    if (ucdm_shm_fd >= 0){
+        close(ucdm_shm_fd);
+        ucdm_shm_fd = -1;
+    }
+}
+
+void ucdm_shm_publish(void){
+    if (!ucdm_shm_image){
+        return;
+    }
+    _ucdm_shm_write_begin();
+    for (ucdm_addr_t addr=0; addr < UCDM_MAX_REGISTERS; addr++){
+        if (_ucdm_shm_publishable(addr)){
+            _ucdm_shm_write_word(addr, _ucdm_get_register(addr));
+        }
+    }
+    _ucdm_shm_write_end();
+}
+
+HAL_BASE_t ucdm_shm_publish_range(ucdm_addr_t saddr, uint16_t count){
+    if ((uint32_t)saddr + count > UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    if (!ucdm_shm_image){
+        return 2;
+    }
+    _ucdm_shm_write_begin();
+    for (uint16_t i=0; i < count; i++){
+        _ucdm_shm_write_word(saddr + i, _ucdm_get_register(saddr + i));
+    }
+    _ucdm_shm_write_end();
+    return 0;
+}
+
+void _ucdm_shm_update(ucdm_addr_t addr){
+    // Called after a register is written.
+    if (!ucdm_shm_image || !_ucdm_shm_publishable(addr)){
+        return;
+    }
+    _ucdm_shm_write_begin();
+    _ucdm_shm_write_word(addr, _ucdm_get_register(addr));
+    _ucdm_shm_write_end();
+}
+
+static const ucdm_shm_image_t * _ucdm_shm_attach(int fd){
+    if (fd < 0){
+        return NULL;
+    }
+    void * image = mmap(NULL, sizeof(ucdm_shm_image_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED){
+        return NULL;
+    }
+    if (__atomic_load_n(&((ucdm_shm_image_t *)image)->magic, __ATOMIC_ACQUIRE) != UCDM_SHM_MAGIC ||
+            ((ucdm_shm_image_t *)image)->version != UCDM_SHM_VERSION){
+        munmap(image, sizeof(ucdm_shm_image_t));
+        return NULL;
+    }
+    return (const ucdm_shm_image_t *)image;
+}
+
+const ucdm_shm_image_t * ucdm_shm_attach(const char * name){
+    return _ucdm_shm_attach(shm_open(name, O_RDONLY, 0));
+}
+
+const ucdm_shm_image_t * ucdm_shm_attach_file(const char * path){
+    return _ucdm_shm_attach(open(path, O_RDONLY));
+}
+
+void ucdm_shm_detach(const ucdm_shm_image_t * image){
+    munmap((void *)image, sizeof(ucdm_shm_image_t));
+}
+
+HAL_BASE_t ucdm_shm_snapshot(const ucdm_shm_image_t * image, ucdm_addr_t saddr,
+                             uint16_t count, uint16_t * target){
+    if ((uint32_t)saddr + count > image->nregs){
+        return 1;
+    }
+    for (uint16_t attempt=0; attempt < UCDM_SHM_SNAPSHOT_RETRIES; attempt++){
+        uint32_t seq = __atomic_load_n(&image->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1){
+            continue;
+        }
+        for (uint16_t i=0; i < count; i++){
+            target[i] = __atomic_load_n(&image->data[saddr + i], __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&image->seq, __ATOMIC_RELAXED) == seq){
+            return 0;
+        }
+    }
+    return 2;
+}
+
+#endif
@@ -0,0 +1,163 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file shm.h
+ * @brief Shared memory register image for host tooling on native builds
+ *
+ * On native builds, the register map can be mirrored into a POSIX shared
+ * memory object or an mmap'd file, so that other processes on the same
+ * host, such as diagnostic tools or an HMI, can read it directly instead
+ * of going through a protocol round trip.
+ *
+ * The image consists of a small header followed by one 16-bit word per
+ * register, holding the value a protocol read of that register would
+ * return. Writes made through ucdm_set_register, ucdm_set_registers,
+ * ucdm_set_bit and ucdm_clear_bit update the image as they happen for
+ * plain and pointer-redirected registers. Pointer-redirected registers
+ * whose content changes without UCDM seeing it are brought up to date when
+ * the application calls ucdm_shm_publish.
+ *
+ * Reading a function-read register may be expensive or have side effects,
+ * such as draining a sampler FIFO, so these are never read implicitly and
+ * read as 0 in the image until the application publishes them explicitly
+ * using ucdm_shm_publish_range.
+ *
+ * The image is protected by a sequence counter. The counter is odd while
+ * the image is being updated and even otherwise. Readers map the image
+ * read-only using ucdm_shm_attach, and take consistent copies of it using
+ * ucdm_shm_snapshot, which retries if the counter changed during the
+ * copy. Neither the writer nor the reader makes any system calls once
+ * the image is mapped.
+ *
+ * This is enabled by setting APP_ENABLE_UCDM_SHM, and is only available
+ * on native builds.
+ */
+
+#ifndef UCDM_SHM_H
+#define UCDM_SHM_H
+
+#include "ucdm.h"
+
+#if UCDM_SHM_ENABLE
+
+#ifndef PIO_NATIVE
+#error "UCDM shared memory images are only supported on native builds"
+#endif
+
+/** Magic number identifying a UCDM register image, "UCDM" */
+#define UCDM_SHM_MAGIC              0x4D444355
+/** Version of the image layout */
+#define UCDM_SHM_VERSION            1
+
+typedef struct UCDM_SHM_IMAGE_t{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t nregs;
+    uint32_t seq;
+    uint32_t reserved;
+    uint16_t data[UCDM_MAX_REGISTERS];
+} ucdm_shm_image_t;
+
+void _ucdm_shm_update(ucdm_addr_t addr);
+
+/**
+ * \brief Create and map the shared memory register image.
+ *
+ * The image is created if it does not exist and fully published.
+ *
+ * @param name Name of the POSIX shared memory object, for shm_open.
+ * @return 0 for success, 2 if the image could not be created or mapped.
+ */
+HAL_BASE_t ucdm_shm_open(const char * name);
+
+/**
+ * \brief Create and map the register image in a regular file.
+ *
+ * @param path Path of the file to map.
+ * @return 0 for success, 2 if the image could not be created or mapped.
+ */
+HAL_BASE_t ucdm_shm_open_file(const char * path);
+
+/**
+ * \brief Unmap the register image.
+ *
+ * The shared memory object or file is left in place for the application
+ * to remove if required.
+ */
+void ucdm_shm_close(void);
+
+/**
+ * \brief Update the image with the current content of every plain and 
+ *        pointer-redirected register.
+ */
+void ucdm_shm_publish(void);
+
+/**
+ * \brief Update the image with the current content of a range of registers.
+ *
+ * Unlike ucdm_shm_publish, this also reads function-read registers in the 
+ * range, and should only be used where the application knows that doing 
+ * so is safe.
+ *
+ * @param saddr First register to publish.
+ * @param count Number of registers to publish.
+ * @return 0 for success, 1 if the range is out of bounds, 2 if no image 
+ *         is open.
+ */
+HAL_BASE_t ucdm_shm_publish_range(ucdm_addr_t saddr, uint16_t count);
+
+/**
+ * \brief Map an existing register image read-only, from a reader process.
+ *
+ * @param name Name of the POSIX shared memory object.
+ * @return Pointer to the mapped image, or NULL on failure.
+ */
+const ucdm_shm_image_t * ucdm_shm_attach(const char * name);
+
+/**
+ * \brief Map an existing register image file read-only, from a reader process.
+ *
+ * @param path Path of the file.
+ * @return Pointer to the mapped image, or NULL on failure.
+ */
+const ucdm_shm_image_t * ucdm_shm_attach_file(const char * path);
+
+/**
+ * \brief Unmap a register image mapped with ucdm_shm_attach.
+ */
+void ucdm_shm_detach(const ucdm_shm_image_t * image);
+
+/**
+ * \brief Take a consistent copy of part of a register image.
+ *
+ * @param image Mapped image.
+ * @param saddr First register to copy.
+ * @param count Number of registers to copy.
+ * @param target Array of count words to copy into.
+ * @return 0 for success, 1 if the range extends beyond the image, 2 if
+ *         no consistent copy could be taken.
+ */
+HAL_BASE_t ucdm_shm_snapshot(const ucdm_shm_image_t * image, ucdm_addr_t saddr,
+                             uint16_t count, uint16_t * target);
+
+#endif
+#endif
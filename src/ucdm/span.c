@@ -25,16 +25,69 @@
  *
  */
 
+#include <string.h>
 #include "span.h"
 
 #if UCDM_SPAN_ENABLE
 
-uint16_t ucdm_span_buffer[UCDM_SPAN_MAX_LENGTH];
+// Read spans are keyed by their first register, write spans by each of 
+// their registers. 
+#define UCDM_SPAN_MAP_SIZE  (UCDM_SPAN_MAX_COUNT * UCDM_SPAN_MAX_LENGTH)
+
+uint16_t ucdm_span_rbuffer[UCDM_SPAN_MAX_LENGTH];
+ucdm_span_t ucdm_spans[UCDM_SPAN_MAX_COUNT];
+uint8_t ucdm_span_count;
+uint16_t ucdm_span_dropped;
 hashmap_t ucdm_span_map = {0};
-hashmap_entry_t ucdm_span_table[UCDM_SPAN_MAX_COUNT];
+hashmap_entry_t ucdm_span_table[UCDM_SPAN_MAP_SIZE];
 
 void _ucdm_span_init(void){
-    hashmap_init(&ucdm_span_map, &ucdm_span_table[0], UCDM_SPAN_MAX_COUNT);
+    ucdm_span_count = 0;
+    ucdm_span_dropped = 0;
+    hashmap_init(&ucdm_span_map, &ucdm_span_table[0], UCDM_SPAN_MAP_SIZE);
+}
+
+static inline uint8_t _ucdm_span_word_index(uint8_t order, uint8_t nwords, uint8_t i){
+    // Index of the native word which is exposed on register i of the span.
+    // Selects between i and (nwords - 1 - i) without branching.
+    uint8_t rmask = -(order & UCDM_SPAN_ORDER_WORDSWAP);
+    return i + (rmask & (uint8_t)(nwords - 1 - 2 * i));
+}
+
+static inline uint16_t _ucdm_span_swizzle(uint8_t order, uint16_t word){
+    uint16_t bmask = -((order & UCDM_SPAN_ORDER_BYTESWAP) >> 1);
+    uint16_t swapped = (word << 8) | (word >> 8);
+    return word ^ ((word ^ swapped) & bmask);
+}
+
+static ucdm_span_t * _ucdm_span_create(ucdm_addr_t saddr, uint8_t len, uint8_t type){
+    if (ucdm_span_count >= UCDM_SPAN_MAX_COUNT){
+        return NULL;
+    }
+    ucdm_span_t * span = &ucdm_spans[ucdm_span_count++];
+    span->saddr = saddr;
+    span->len = len;
+    span->type = type;
+    span->order = UCDM_SPAN_ORDER_CDAB;
+    span->received = 0;
+    return span;
+}
+
+static inline HAL_BASE_t _ucdm_span_check(ucdm_addr_t saddr, uint8_t len){
+    if (len < 4 || len % 2 || len/2 > UCDM_SPAN_MAX_LENGTH){
+        return 2;
+    }
+    if (saddr + len/2 > UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    // Both span types share the map, so no register of the new span may 
+    // already be a key of another span.
+    for (uint8_t i=0; i < len/2; i++){
+        if (hashmap_get(&ucdm_span_map, saddr + i)){
+            return 4;
+        }
+    }
+    return 0;
 }
 
 uint16_t _ucdm_span_read_prep(ucdm_addr_t addr){
@@ -45,69 +98,123 @@ uint16_t _ucdm_span_read_prep(ucdm_addr_t addr){
     if (entry == NULL){
         return 0xFFFF;
     }
-    memcpy(
-        &ucdm_span_buffer[1], 
-        &entry->ptr + 2, 
-        entry->len - 2
-    );
-    return *(uint16_t *)(entry->ptr) & 0xFFFF;
+    ucdm_span_t * span = (ucdm_span_t *)entry->ptr;
+    uint16_t words[UCDM_SPAN_MAX_LENGTH];
+    uint8_t nwords = span->len / 2;
+    memcpy(&words[0], span->target.buf, span->len);
+    for (uint8_t i=0; i < nwords; i++){
+        ucdm_span_rbuffer[i] = _ucdm_span_swizzle(
+            span->order, words[_ucdm_span_word_index(span->order, nwords, i)]
+        );
+    }
+    return ucdm_span_rbuffer[0];
 }
 
 HAL_BASE_t ucdm_redirect_spanr_buf(ucdm_addr_t saddr, void * target, uint8_t len){
-    if (len < 4 || len % 2 || len > UCDM_SPAN_MAX_LENGTH){
-        return 2;
+    HAL_BASE_t rval = _ucdm_span_check(saddr, len);
+    if (rval){
+        return rval;
     }
-    if (saddr + len/2 < UCDM_MAX_REGISTERS){
-        hashmap_insert(&ucdm_span_map, saddr, target, len);
-        ucdm_redirect_regr_func(saddr, &_ucdm_span_read_prep);
-        for (size_t i=1; i < len/2 ; i++){
-            ucdm_redirect_regr_ptr(saddr + i, &ucdm_span_buffer[i]);
-        }
-        return 0;
-    } else {
-        return 1;
+    ucdm_span_t * span = _ucdm_span_create(saddr, len, UCDM_SPAN_TYPE_READ);
+    if (span == NULL){
+        return 3;
     }
+    span->target.buf = target;
+    hashmap_insert(&ucdm_span_map, saddr, (void *)span, len);
+    ucdm_redirect_regr_func(saddr, &_ucdm_span_read_prep);
+    for (uint8_t i=1; i < len/2 ; i++){
+        ucdm_redirect_regr_ptr(saddr + i, &ucdm_span_rbuffer[i]);
+    }
+    return 0;
 }
 
-void _ucdm_span_write_finish(ucdm_addr_t addr, uint16_t value){
-    // Handle the data in the ephemeral buffer. 
-    // This function is called when the last 16-bit word is read. It should 
-    // finish the assembly of the datatype and do whatever it wants with this 
-    // data before returning.
+static void _ucdm_span_write_commit(ucdm_span_t * span){
+    uint16_t words[UCDM_SPAN_MAX_LENGTH];
+    uint8_t nwords = span->len / 2;
+    for (uint8_t i=0; i < nwords; i++){
+        words[_ucdm_span_word_index(span->order, nwords, i)] = 
+            _ucdm_span_swizzle(span->order, span->staged[i]);
+    }
+    span->target.wfunc(span->saddr, (void *)&words[0]);
+}
+
+void _ucdm_span_write_word(ucdm_addr_t addr, uint16_t value){
+    // Stage a word of a write transaction. The transaction is committed, 
+    // and the target function called, once all words have been received. 
+    // A write to the first register, or to a register already staged, 
+    // starts a new transaction and drops the partial one. 
     hashmap_entry_t * entry = hashmap_get(&ucdm_span_map, addr);
     if (entry == NULL){
         return;
     }
+    ucdm_span_t * span = (ucdm_span_t *)entry->ptr;
+    uint8_t offset = addr - span->saddr;
+    uint16_t complete = (1 << (span->len / 2)) - 1;
+    
+    #if UCDM_SPAN_TIMEOUT
+    ucdm_tick_t now = ucdm_tick();
+    if (span->received && (ucdm_tick_t)(now - span->started) > UCDM_SPAN_TIMEOUT){
+        span->received = 0;
+        ucdm_span_dropped++;
+    }
+    if (!span->received){
+        span->started = now;
+    }
+    #endif
     
-    ((void (*)(ucdm_addr_t, void *))entry->ptr)(
-        addr - entry->len/2, 
-        (void *)&ucdm_span_buffer[0]
-    );
+    if (span->received && (!offset || span->received & (1 << offset))){
+        span->received = 0;
+        ucdm_span_dropped++;
+        #if UCDM_SPAN_TIMEOUT
+        span->started = now;
+        #endif
+    }
+    
+    span->staged[offset] = value;
+    span->received |= (1 << offset);
+    if (span->received == complete){
+        span->received = 0;
+        _ucdm_span_write_commit(span);
+    }
     return;
 }
 
 
 HAL_BASE_t ucdm_redirect_spanw_func(ucdm_addr_t saddr, uint8_t len, void target(ucdm_addr_t, void * param)){
-    if (len < 4 || len % 2 || len > UCDM_SPAN_MAX_LENGTH){
-        return 2;
+    HAL_BASE_t rval = _ucdm_span_check(saddr, len);
+    if (rval){
+        return rval;
+    }
+    ucdm_span_t * span = _ucdm_span_create(saddr, len, UCDM_SPAN_TYPE_WRITE);
+    if (span == NULL){
+        return 3;
+    }
+    span->target.wfunc = target;
+    for (uint8_t i=0; i < len/2; i++){
+        hashmap_insert(&ucdm_span_map, saddr + i, (void *)span, len);
+        ucdm_redirect_regw_func(saddr + i, _ucdm_span_write_word);
     }
-    if (saddr + len/2 < UCDM_MAX_REGISTERS){
-        hashmap_insert(&ucdm_span_map, saddr, target, len);
-        for (uint8_t i=0; i < (len/2) - 1 ; i++){
-            ucdm_redirect_regw_ptr(
-                saddr + i, 
-                &ucdm_span_buffer[i]
-            );
+    return 0;
+}
+
+HAL_BASE_t ucdm_set_span_order(ucdm_addr_t saddr, uint8_t order){
+    HAL_BASE_t rval = 1;
+    for (uint8_t i=0; i < ucdm_span_count; i++){
+        if (ucdm_spans[i].saddr == saddr){
+            ucdm_spans[i].order = order;
+            rval = 0;
         }
-        ucdm_redirect_regw_func(
-            saddr + len/2, 
-            _ucdm_span_write_finish
-        );
-        return 0;
-    } else {
-        return 1;
     }
+    return rval;
 }
 
+HAL_BASE_t ucdm_span_abort(ucdm_addr_t saddr){
+    hashmap_entry_t * entry = hashmap_get(&ucdm_span_map, saddr);
+    if (entry == NULL || ((ucdm_span_t *)entry->ptr)->saddr != saddr){
+        return 1;
+    }
+    ((ucdm_span_t *)entry->ptr)->received = 0;
+    return 0;
+}
 
 #endif
@@ -23,6 +23,38 @@
  * @file span.h
  * @brief Support for types spanning multiple registers
  * 
+ * Spans expose a value of len bytes on len/2 consecutive registers. Read 
+ * spans snapshot the target buffer into a staging buffer when the first 
+ * register is read. 
+ * 
+ * Write spans are transactional. Each write span has its own staging 
+ * buffer and a bitmap of the words received. A write to the first 
+ * register, or to a register already written in the current transaction, 
+ * starts a new transaction. Other words may be written in any order, and 
+ * the assembled value is passed to the target function only once every 
+ * word of the span has been written. If 
+ * APP_UCDM_SPAN_TIMEOUT is set, a transaction which is not completed 
+ * within that many ticks of its first word is dropped, and the next word 
+ * written starts a fresh transaction. Partially written values are never 
+ * merged into a later write. 
+ * 
+ * Each span has a word and byte order, set using ucdm_set_span_order. 
+ * Using the usual notation for a 32-bit value 0xAABBCCDD, the orders 
+ * place the following content on the span's registers : 
+ * 
+ *  - UCDM_SPAN_ORDER_CDAB : 0xCCDD, 0xAABB (native, default)
+ *  - UCDM_SPAN_ORDER_ABCD : 0xAABB, 0xCCDD
+ *  - UCDM_SPAN_ORDER_DCBA : 0xDDCC, 0xBBAA
+ *  - UCDM_SPAN_ORDER_BADC : 0xBBAA, 0xDDCC
+ * 
+ * Longer values follow the same pattern. The reordering is applied as a 
+ * branch-free swizzle while the staging buffer is filled or drained, so 
+ * the cost does not depend on the order selected. 
+ * 
+ * The span table holds APP_UCDM_SPAN_MAX_COUNT spans, and spans may be at 
+ * most APP_UCDM_SPAN_MAX_LENGTH registers long. Since each register holds 
+ * a single redirection target, spans cannot overlap, and a span which 
+ * would overlap an existing one is rejected. 
  */
 
 #ifndef UCDM_SPAN_H
@@ -34,11 +66,101 @@
 
 #include <ds/hashmap.h>
 
+/**
+ * @name UCDM Span Word and Byte Order Definitions
+ */
+/**@{*/ 
+/** Span Order, Registers in reverse order of native (little endian) words */
+#define UCDM_SPAN_ORDER_WORDSWAP    0x01
+/** Span Order, Bytes swapped within each register */
+#define UCDM_SPAN_ORDER_BYTESWAP    0x02
+/** Span Order, Least significant word first */
+#define UCDM_SPAN_ORDER_CDAB        0x00
+/** Span Order, Most significant word first */
+#define UCDM_SPAN_ORDER_ABCD        UCDM_SPAN_ORDER_WORDSWAP
+/** Span Order, Least significant word first, byte swapped */
+#define UCDM_SPAN_ORDER_DCBA        UCDM_SPAN_ORDER_BYTESWAP
+/** Span Order, Most significant word first, byte swapped */
+#define UCDM_SPAN_ORDER_BADC        (UCDM_SPAN_ORDER_WORDSWAP | UCDM_SPAN_ORDER_BYTESWAP)
+/**@}*/ 
+
+#if UCDM_SPAN_TIMEOUT
+#include "tick.h"
+#endif
+
+#if UCDM_SPAN_MAX_LENGTH > 16
+    #error "UCDM spans can be at most 16 registers long"
+#endif
+
+#define UCDM_SPAN_TYPE_READ         0x00
+#define UCDM_SPAN_TYPE_WRITE        0x01
+
+typedef struct UCDM_SPAN_t{
+    ucdm_addr_t saddr;
+    uint8_t len;
+    uint8_t type;
+    uint8_t order;
+    union {
+        void * buf;
+        void (*wfunc)(ucdm_addr_t, void *);
+    } target;
+    uint16_t received;
+    #if UCDM_SPAN_TIMEOUT
+    ucdm_tick_t started;
+    #endif
+    uint16_t staged[UCDM_SPAN_MAX_LENGTH];
+} ucdm_span_t;
+
+extern ucdm_span_t ucdm_spans[];
+extern uint8_t ucdm_span_count;
+
 void _ucdm_span_init(void);
 
+/** 
+ * \brief Configure UCDM register read access on a range of registers to read from a buffer. 
+ * 
+ * @param saddr Address/identifier of the first register of the span.
+ * @param target Pointer to the buffer holding the value.
+ * @param len Length of the value in bytes. 
+ * @return 0 for success, 1 for register out of range, 2 for invalid length, 
+ *         3 if the span table is full, 4 if it overlaps an existing span.
+ */
 HAL_BASE_t ucdm_redirect_spanr_buf(ucdm_addr_t saddr, void * target, uint8_t len);
 
+/** 
+ * \brief Configure UCDM register write access on a range of registers to write to a function. 
+ * 
+ * The function is called with the address of the first register and a 
+ * pointer to the assembled value once the last register is written.
+ * 
+ * @param saddr Address/identifier of the first register of the span.
+ * @param len Length of the value in bytes. 
+ * @param target Pointer to the function the assembled value should be passed to.
+ * @return 0 for success, 1 for register out of range, 2 for invalid length, 
+ *         3 if the span table is full, 4 if it overlaps an existing span.
+ */
 HAL_BASE_t ucdm_redirect_spanw_func(ucdm_addr_t saddr, uint8_t len, void target(ucdm_addr_t, void * param));
 
+/** 
+ * \brief Set the word and byte order of the spans starting at a register.
+ * 
+ * @param saddr Address/identifier of the first register of the span.
+ * @param order One of the UCDM_SPAN_ORDER_ definitions.
+ * @return 0 for success, 1 if there is no span at saddr.
+ */
+HAL_BASE_t ucdm_set_span_order(ucdm_addr_t saddr, uint8_t order);
+
+/** 
+ * \brief Drop any incomplete write transaction on the span starting at a register.
+ * 
+ * @param saddr Address/identifier of the first register of the span.
+ * @return 0 for success, 1 if there is no span at saddr.
+ */
+HAL_BASE_t ucdm_span_abort(ucdm_addr_t saddr);
+
+/** \brief Number of incomplete span write transactions which were dropped, 
+ *         either on timeout or when a new transaction was started. */
+extern uint16_t ucdm_span_dropped;
+
 #endif
 #endif
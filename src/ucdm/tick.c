@@ -0,0 +1,55 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file tick.c
+ * @brief Timestamp source for UCDM instrumentation
+ *
+ */
+
+#include "tick.h"
+
+#if UCDM_TICK_ENABLE
+
+#ifdef PIO_NATIVE
+#include <time.h>
+#endif
+
+static ucdm_tick_source_t ucdm_tick_source = NULL;
+
+void ucdm_install_tick_source(ucdm_tick_source_t source){
+    ucdm_tick_source = source;
+}
+
+ucdm_tick_t ucdm_tick(void){
+    if (ucdm_tick_source){
+        return ucdm_tick_source();
+    }
+    #ifdef PIO_NATIVE
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ucdm_tick_t)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+    #else
+    return 0;
+    #endif
+}
+
+#endif
@@ -0,0 +1,66 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file tick.h
+ * @brief Timestamp source for UCDM instrumentation
+ * 
+ * Some of the optional UCDM subsystems need to know the time. UCDM does 
+ * not depend on any particular timekeeping library, so the application 
+ * should install a tick source using ucdm_install_tick_source during 
+ * initialization. This would generally be a thin wrapper around a SysTick 
+ * counter or a free running hardware timer. 
+ * 
+ * The unit of the tick is whatever the installed source provides. All 
+ * UCDM arithmetic on ticks is done modulo 2^32, so the source is allowed 
+ * to wrap around. 
+ * 
+ * On native builds, if no source is installed, a microsecond counter 
+ * derived from CLOCK_MONOTONIC is used. On other platforms, ucdm_tick 
+ * will return 0 until a source is installed. 
+ */
+
+#ifndef UCDM_TICK_H
+#define UCDM_TICK_H
+
+#include "ucdm.h"
+
+#if UCDM_TICK_ENABLE
+
+typedef uint32_t ucdm_tick_t;
+
+typedef ucdm_tick_t (*ucdm_tick_source_t)(void);
+
+/**
+ * \brief Install the tick source used by UCDM.
+ * 
+ * @param source Function returning the current tick count, or NULL to 
+ *               revert to the default source.
+ */
+void ucdm_install_tick_source(ucdm_tick_source_t source);
+
+/**
+ * \brief Get the current tick count.
+ */
+ucdm_tick_t ucdm_tick(void);
+
+#endif
+#endif
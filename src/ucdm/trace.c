@@ -0,0 +1,142 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file trace.c
+ * @brief Binary trace of UCDM register and bit accesses
+ *
+ */
+
+#include "trace.h"
+
+#if UCDM_TRACE_ENABLE
+
+#ifdef PIO_NATIVE
+#include <stdio.h>
+#endif
+
+#define UCDM_TRACE_MASK     (UCDM_TRACE_DEPTH - 1)
+
+ucdm_trace_record_t ucdm_trace_buffer[UCDM_TRACE_DEPTH];
+uint16_t ucdm_trace_dropped;
+
+// head and tail are free running. head is only written by the producer, 
+// and tail only by the consumer. 
+static uint16_t ucdm_trace_head;
+static uint16_t ucdm_trace_tail;
+static uint16_t ucdm_trace_seq;
+static volatile uint8_t ucdm_trace_armed;
+
+void _ucdm_trace_init(void){
+    ucdm_trace_head = 0;
+    ucdm_trace_tail = 0;
+    ucdm_trace_seq = 0;
+    ucdm_trace_dropped = 0;
+    ucdm_trace_armed = 0;
+}
+
+void ucdm_trace_enable(uint8_t enable){
+    ucdm_trace_armed = enable;
+}
+
+void _ucdm_trace_record(uint8_t op, uint16_t addr, uint16_t value, uint8_t result){
+    if (!ucdm_trace_armed){
+        return;
+    }
+    uint16_t head = ucdm_trace_head;
+    uint16_t seq = ucdm_trace_seq++;
+    if ((uint16_t)(head - __atomic_load_n(&ucdm_trace_tail, __ATOMIC_ACQUIRE)) >= UCDM_TRACE_DEPTH){
+        ucdm_trace_dropped++;
+        return;
+    }
+    ucdm_trace_record_t * record = &ucdm_trace_buffer[head & UCDM_TRACE_MASK];
+    record->tick = ucdm_tick();
+    record->seq = seq;
+    record->addr = addr;
+    record->value = value;
+    record->op = op;
+    record->result = result;
+    __atomic_store_n(&ucdm_trace_head, head + 1, __ATOMIC_RELEASE);
+}
+
+uint16_t ucdm_trace_available(void){
+    return (uint16_t)(__atomic_load_n(&ucdm_trace_head, __ATOMIC_ACQUIRE) - ucdm_trace_tail);
+}
+
+uint16_t ucdm_trace_dump(ucdm_trace_record_t * target, uint16_t maxrecords){
+    uint16_t tail = ucdm_trace_tail;
+    uint16_t avail = (uint16_t)(__atomic_load_n(&ucdm_trace_head, __ATOMIC_ACQUIRE) - tail);
+    uint16_t n = (avail < maxrecords) ? avail : maxrecords;
+    for (uint16_t i=0; i < n; i++){
+        target[i] = ucdm_trace_buffer[(tail + i) & UCDM_TRACE_MASK];
+    }
+    __atomic_store_n(&ucdm_trace_tail, tail + n, __ATOMIC_RELEASE);
+    return n;
+}
+
+void ucdm_trace_pack(const ucdm_trace_record_t * record, uint8_t * buf){
+    buf[0] = record->tick & 0xFF;
+    buf[1] = (record->tick >> 8) & 0xFF;
+    buf[2] = (record->tick >> 16) & 0xFF;
+    buf[3] = (record->tick >> 24) & 0xFF;
+    buf[4] = record->seq & 0xFF;
+    buf[5] = record->seq >> 8;
+    buf[6] = record->addr & 0xFF;
+    buf[7] = record->addr >> 8;
+    buf[8] = record->value & 0xFF;
+    buf[9] = record->value >> 8;
+    buf[10] = record->op;
+    buf[11] = record->result;
+}
+
+void ucdm_trace_unpack(const uint8_t * buf, ucdm_trace_record_t * record){
+    record->tick = (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | 
+                   ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+    record->seq = buf[4] | (buf[5] << 8);
+    record->addr = buf[6] | (buf[7] << 8);
+    record->value = buf[8] | (buf[9] << 8);
+    record->op = buf[10];
+    record->result = buf[11];
+}
+
+#ifdef PIO_NATIVE
+
+static const char * _ucdm_trace_op_name(uint8_t op){
+    switch (op){
+        case UCDM_TRACE_OP_REGR: return "REGR";
+        case UCDM_TRACE_OP_REGW: return "REGW";
+        case UCDM_TRACE_OP_BITR: return "BITR";
+        case UCDM_TRACE_OP_BITS: return "BITS";
+        case UCDM_TRACE_OP_BITC: return "BITC";
+        default: return "????";
+    }
+}
+
+int ucdm_trace_format(const ucdm_trace_record_t * record, char * buf, size_t size){
+    return snprintf(buf, size, "%10lu %5u %s 0x%04X 0x%04X %u", 
+                    (unsigned long)record->tick, record->seq, 
+                    _ucdm_trace_op_name(record->op), 
+                    record->addr, record->value, record->result);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,163 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file trace.h
+ * @brief Binary trace of UCDM register and bit accesses
+ * 
+ * When enabled, every access made through the UCDM access functions 
+ * (ucdm_get_register, ucdm_set_register, ucdm_get_bit, ucdm_set_bit and 
+ * ucdm_clear_bit) is logged as a fixed size binary record into a ring 
+ * buffer. This provides a record of which registers a master read or 
+ * wrote, and in what order, for post-mortem analysis of protocol issues 
+ * in the field. 
+ * 
+ * The trace is compiled in by setting APP_UCDM_TRACE_DEPTH to the number 
+ * of records the ring buffer should hold, which must be a power of 2. 
+ * When compiled in, tracing must additionally be armed at runtime using 
+ * ucdm_trace_enable. When APP_UCDM_TRACE_DEPTH is 0 (the default), the 
+ * trace compiles out completely. 
+ * 
+ * The ring buffer is lock-free for a single producer and a single 
+ * consumer. The producer is whichever context the protocol accesses UCDM 
+ * from, and the consumer is whoever calls ucdm_trace_dump. When the ring 
+ * buffer is full, new records are discarded and counted in 
+ * ucdm_trace_dropped. Each record carries a sequence number, so gaps are 
+ * visible in the dump. 
+ * 
+ * For transport off the device, records can be packed into a portable 
+ * little-endian wire format of UCDM_TRACE_WIRE_LENGTH bytes using 
+ * ucdm_trace_pack. The host side tooling can decode this format using 
+ * ucdm_trace_unpack and ucdm_trace_format, which have no dependencies on 
+ * the rest of UCDM. The wire format is : 
+ * 
+ *  - tick      : 4 bytes
+ *  - sequence  : 2 bytes
+ *  - address   : 2 bytes
+ *  - value     : 2 bytes
+ *  - op        : 1 byte
+ *  - result    : 1 byte
+ * 
+ * For bit operations, address is the address of the register containing 
+ * the bit and value is the bit mask. For bit reads, result holds the 
+ * return value of ucdm_get_bit. 
+ */
+
+#ifndef UCDM_TRACE_H
+#define UCDM_TRACE_H
+
+#include "ucdm.h"
+
+#if UCDM_TRACE_ENABLE
+
+#include "tick.h"
+
+#if UCDM_TRACE_DEPTH & (UCDM_TRACE_DEPTH - 1)
+    #error "APP_UCDM_TRACE_DEPTH must be a power of 2"
+#endif
+
+/**
+ * @name UCDM Trace Operation Definitions
+ */
+/**@{*/ 
+/** Register Read */
+#define UCDM_TRACE_OP_REGR          0x01
+/** Register Write */
+#define UCDM_TRACE_OP_REGW          0x02
+/** Bit Read */
+#define UCDM_TRACE_OP_BITR          0x03
+/** Bit Set */
+#define UCDM_TRACE_OP_BITS          0x04
+/** Bit Clear */
+#define UCDM_TRACE_OP_BITC          0x05
+/**@}*/ 
+
+#define UCDM_TRACE_WIRE_LENGTH      12
+
+typedef struct UCDM_TRACE_RECORD_t{
+    ucdm_tick_t tick;
+    uint16_t seq;
+    uint16_t addr;
+    uint16_t value;
+    uint8_t op;
+    uint8_t result;
+} ucdm_trace_record_t;
+
+void _ucdm_trace_init(void);
+
+void _ucdm_trace_record(uint8_t op, uint16_t addr, uint16_t value, uint8_t result);
+
+/** 
+ * \brief Arm or disarm access tracing.
+ * 
+ * @param enable Non-zero to start tracing, 0 to stop.
+ */
+void ucdm_trace_enable(uint8_t enable);
+
+/** 
+ * \brief Number of records waiting in the trace buffer.
+ */
+uint16_t ucdm_trace_available(void);
+
+/** 
+ * \brief Pop records from the trace buffer.
+ * 
+ * @param target Array to copy the records into.
+ * @param maxrecords Maximum number of records to pop.
+ * @return Number of records popped.
+ */
+uint16_t ucdm_trace_dump(ucdm_trace_record_t * target, uint16_t maxrecords);
+
+/** 
+ * \brief Pack a trace record into the wire format.
+ * 
+ * @param record Record to pack.
+ * @param buf Buffer of at least UCDM_TRACE_WIRE_LENGTH bytes.
+ */
+void ucdm_trace_pack(const ucdm_trace_record_t * record, uint8_t * buf);
+
+/** 
+ * \brief Unpack a trace record from the wire format.
+ * 
+ * @param buf Buffer of at least UCDM_TRACE_WIRE_LENGTH bytes.
+ * @param record Record to unpack into.
+ */
+void ucdm_trace_unpack(const uint8_t * buf, ucdm_trace_record_t * record);
+
+#ifdef PIO_NATIVE
+/** 
+ * \brief Format a trace record as a line of human readable text.
+ * 
+ * Only available on native builds. 
+ * 
+ * @param record Record to format.
+ * @param buf Buffer for the text.
+ * @param size Size of the buffer.
+ * @return Length of the formatted text, as returned by snprintf.
+ */
+int ucdm_trace_format(const ucdm_trace_record_t * record, char * buf, size_t size);
+#endif
+
+/** \brief Number of records discarded because the trace buffer was full. */
+extern uint16_t ucdm_trace_dropped;
+
+#endif
+#endif
@@ -33,6 +33,20 @@
 #include "ucdm.h"
 #include "span.h"
 #include "descriptor.h"
+#include "rbe.h"
+#include "sampler.h"
+#include "trace.h"
+#include "hstats.h"
+#include "defer.h"
+#include "cache.h"
+#include "block.h"
+#include "shm.h"
+#include "diag.h"
+#include "async.h"
+#include "repl.h"
+#include "view.h"
+#include "hpool.h"
+#include "alias.h"
 
 
 uint16_t ucdm_diagnostic_register;
@@ -41,21 +55,201 @@ uint8_t  ucdm_exception_status;
 #if UCDM_ENABLE_HANDLERS
 avlt_t   ucdm_rwht;
 avlt_t   ucdm_bwht;
+
+static inline void _ucdm_call_rw_handler(ucdm_rw_handler_t handler, ucdm_addr_t addr);
+static inline void _ucdm_call_bw_handler(ucdm_bw_handler_t handler, ucdm_addr_t addr, uint16_t mask);
+
+static inline void _ucdm_call_rw_handler(ucdm_rw_handler_t handler, ucdm_addr_t addr){
+    #if UCDM_ENABLE_DIAGNOSTICS
+    _ucdm_diag_handler();
+    #endif
+    #if UCDM_DEFER_ENABLE
+    if (_ucdm_defer_handler(UCDM_DEFER_TYPE_RW, (void *)handler, addr, 0)){
+        return;
+    }
+    #endif
+    #if UCDM_HSTATS_ENABLE || UCDM_DEFER_ENABLE
+    ucdm_tick_t start = ucdm_tick();
+    #endif
+    handler(addr);
+    #if UCDM_HSTATS_ENABLE || UCDM_DEFER_ENABLE
+    ucdm_tick_t elapsed = ucdm_tick() - start;
+    #endif
+    #if UCDM_HSTATS_ENABLE
+    _ucdm_hstats_record((void *)handler, addr, elapsed);
+    #endif
+    #if UCDM_DEFER_ENABLE
+    _ucdm_defer_account((void *)handler, elapsed);
+    #endif
+}
+
+static inline void _ucdm_call_bw_handler(ucdm_bw_handler_t handler, ucdm_addr_t addr, uint16_t mask){
+    #if UCDM_ENABLE_DIAGNOSTICS
+    _ucdm_diag_handler();
+    #endif
+    #if UCDM_DEFER_ENABLE
+    if (_ucdm_defer_handler(UCDM_DEFER_TYPE_BW, (void *)handler, addr, mask)){
+        return;
+    }
+    #endif
+    #if UCDM_HSTATS_ENABLE || UCDM_DEFER_ENABLE
+    ucdm_tick_t start = ucdm_tick();
+    #endif
+    handler(addr, mask);
+    #if UCDM_HSTATS_ENABLE || UCDM_DEFER_ENABLE
+    ucdm_tick_t elapsed = ucdm_tick() - start;
+    #endif
+    #if UCDM_HSTATS_ENABLE
+    _ucdm_hstats_record((void *)handler, addr, elapsed);
+    #endif
+    #if UCDM_DEFER_ENABLE
+    _ucdm_defer_account((void *)handler, elapsed);
+    #endif
+}
+
+static inline void _ucdm_exec_rw_handlers(ucdm_addr_t addr){
+    avlt_node_t * hfnode = avlt_find_node(&ucdm_rwht, addr);
+    if (hfnode && hfnode->content){
+        _ucdm_call_rw_handler((ucdm_rw_handler_t)(hfnode->content), addr);
+    }
+    #if UCDM_HPOOL_ENABLE
+    // Handlers may change the pool, so the chain is copied before any of 
+    // them are called. This is on the stack of every handled write, and 
+    // is sized by the chain limit rather than by the pool.
+    void * chain[UCDM_HPOOL_MAX_CHAIN];
+    uint8_t count = _ucdm_hpool_chain(addr, UCDM_HPOOL_TYPE_RW, 0xFFFF, &chain[0]);
+    for (uint8_t i=0; i < count; i++){
+        _ucdm_call_rw_handler((ucdm_rw_handler_t)(chain[i]), addr);
+    }
+    #endif
+}
+
+static inline void _ucdm_exec_bw_handlers(ucdm_addr_t addr, uint16_t mask){
+    avlt_node_t * hfnode = avlt_find_node(&ucdm_bwht, addr);
+    if (hfnode && hfnode->content){
+        _ucdm_call_bw_handler((ucdm_bw_handler_t)(hfnode->content), addr, mask);
+    }
+    #if UCDM_HPOOL_ENABLE
+    void * chain[UCDM_HPOOL_MAX_CHAIN];
+    uint8_t count = _ucdm_hpool_chain(addr, UCDM_HPOOL_TYPE_BW, mask, &chain[0]);
+    for (uint8_t i=0; i < count; i++){
+        _ucdm_call_bw_handler((ucdm_bw_handler_t)(chain[i]), addr, mask);
+    }
+    #endif
+}
 #endif
 
+#if UCDM_CONST_CONFIG
+uint16_t ucdm_data[UCDM_CONST_DATA_COUNT];
+#else
 ucdm_register_t ucdm_register[UCDM_MAX_REGISTERS];
 ucdm_acctype_t  ucdm_acctype[UCDM_MAX_REGISTERS];
+#endif
+
+#if UCDM_ENABLE_PERM_BITMAPS
+#define UCDM_PERM_WORDS     ((UCDM_MAX_REGISTERS + 31) / 32)
+
+uint32_t ucdm_perm_readable[UCDM_PERM_WORDS];
+uint32_t ucdm_perm_writable[UCDM_PERM_WORDS];
+uint32_t ucdm_perm_bitwritable[UCDM_PERM_WORDS];
+
+static inline void _ucdm_perm_assign(uint32_t * map, ucdm_addr_t addr, uint8_t value){
+    uint32_t mask = (uint32_t)1 << (addr & 31);
+    map[addr >> 5] = (map[addr >> 5] & ~mask) | (value ? mask : 0);
+}
+
+void _ucdm_perm_update(ucdm_addr_t addr){
+    ucdm_acctype_t at = ucdm_acctype[addr];
+    _ucdm_perm_assign(ucdm_perm_readable, addr, at & UCDM_AT_READ_MASK);
+    _ucdm_perm_assign(ucdm_perm_writable, addr, at & UCDM_AT_REGW_TYPE_MASK);
+    _ucdm_perm_assign(ucdm_perm_bitwritable, addr, at & UCDM_AT_BITW_WE);
+}
+
+static uint8_t _ucdm_perm_run(const uint32_t * map, uint32_t addr, uint32_t count){
+    // Check that all bits of map in [addr, addr + count) are set, testing 
+    // whole words at a time.
+    uint32_t end = addr + count - 1;
+    uint32_t w = addr >> 5;
+    uint32_t first = ~(uint32_t)0 << (addr & 31);
+    uint32_t last = ~(uint32_t)0 >> (31 - (end & 31));
+    if (w == end >> 5){
+        return (map[w] & first & last) == (first & last);
+    }
+    if ((map[w] & first) != first){
+        return 0;
+    }
+    for (w++; w < end >> 5; w++){
+        if (map[w] != ~(uint32_t)0){
+            return 0;
+        }
+    }
+    return (map[w] & last) == last;
+}
+
+static uint8_t _ucdm_perm_range(const uint32_t * map, uint32_t addr, uint32_t count){
+    #if UCDM_ALIAS_ENABLE
+    // Check each run of consecutive canonical registers separately.
+    ucdm_addr_t caddr;
+    while (count){
+        uint16_t n = _ucdm_alias_run(addr, count, &caddr);
+        if (!_ucdm_perm_run(map, caddr, n)){
+            return 0;
+        }
+        addr += n;
+        count -= n;
+    }
+    return 1;
+    #else
+    return _ucdm_perm_run(map, addr, count);
+    #endif
+}
+#else
+void _ucdm_perm_update(ucdm_addr_t addr){
+    ;
+}
+
+static uint8_t _ucdm_perm_range_acctype(uint32_t addr, uint32_t count, ucdm_acctype_t mask){
+    for (uint32_t i=addr; i < addr + count; i++){
+        #if UCDM_ALIAS_ENABLE
+        if (!(ucdm_acctype[_ucdm_alias_resolve(i)] & mask)){
+        #else
+        if (!(ucdm_acctype[i] & mask)){
+        #endif
+            return 0;
+        }
+    }
+    return 1;
+}
+#endif
 
 static inline void _ucdm_registers_init(void);
 static inline void _ucdm_acctype_init(void);
 static inline void _ucdm_handlers_init(void);
 
 static inline void _ucdm_registers_init(void){
+    #if UCDM_CONST_CONFIG
+    memset(&ucdm_data, 0, sizeof(ucdm_data));
+    #else
     memset(&ucdm_register, 0, sizeof(ucdm_register_t) * UCDM_MAX_REGISTERS);
+    #endif
 }
 
 static inline void _ucdm_acctype_init(void){
+    #if UCDM_CONST_CONFIG
+    // The access types are fixed. The bitmaps, if any, are built from them.
+    #if UCDM_ENABLE_PERM_BITMAPS
+    for (uint32_t addr=0; addr < UCDM_MAX_REGISTERS; addr++){
+        _ucdm_perm_update(addr);
+    }
+    #endif
+    #else
     memset(&ucdm_acctype, 0, sizeof(uint8_t) * UCDM_MAX_REGISTERS);
+    #if UCDM_ENABLE_PERM_BITMAPS
+    memset(&ucdm_perm_readable, 0, sizeof(ucdm_perm_readable));
+    memset(&ucdm_perm_writable, 0, sizeof(ucdm_perm_writable));
+    memset(&ucdm_perm_bitwritable, 0, sizeof(ucdm_perm_bitwritable));
+    #endif
+    #endif
 }
 
 #if UCDM_LIBVERSION_DESCRIPTOR
@@ -66,7 +260,13 @@ static descriptor_custom_t ucdm_descriptor = {NULL, DESCRIPTOR_TAG_LIBVERSION,
     
 static void _ucdm_install_descriptor(void)
 {
-    descriptor_install(&ucdm_descriptor);
+    // The descriptor is static, so installing it again on a repeated 
+    // ucdm_init would link it to itself.
+    static uint8_t installed = 0;
+    if (!installed){
+        descriptor_install(&ucdm_descriptor);
+        installed = 1;
+    }
 }    
 
 #endif
@@ -89,12 +289,54 @@ void ucdm_init(void){
     #if UCDM_SPAN_ENABLE
     _ucdm_span_init();
     #endif
+    #if UCDM_RBE_ENABLE
+    _ucdm_rbe_init();
+    #endif
+    #if UCDM_SAMPLER_ENABLE
+    _ucdm_sampler_init();
+    #endif
+    #if UCDM_TRACE_ENABLE
+    _ucdm_trace_init();
+    #endif
+    #if UCDM_HSTATS_ENABLE
+    _ucdm_hstats_init();
+    #endif
+    #if UCDM_DEFER_ENABLE
+    _ucdm_defer_init();
+    #endif
+    #if UCDM_CACHE_ENABLE
+    _ucdm_cache_init();
+    #endif
+    #if UCDM_BLOCK_ENABLE
+    _ucdm_block_init();
+    #endif
+    #if UCDM_ENABLE_DIAGNOSTICS
+    _ucdm_diag_init();
+    #endif
+    #if UCDM_ASYNC_ENABLE
+    _ucdm_async_init();
+    #endif
+    #if UCDM_REPL_ENABLE
+    _ucdm_repl_init();
+    #endif
+    #if UCDM_VIEW_ENABLE
+    _ucdm_view_init();
+    #endif
+    #if UCDM_HPOOL_ENABLE
+    _ucdm_hpool_init();
+    #endif
+    #if UCDM_ALIAS_ENABLE
+    _ucdm_alias_init();
+    #endif
     return;
 }
 
+#if !UCDM_CONST_CONFIG
+
 HAL_BASE_t ucdm_disable_regr(ucdm_addr_t addr){
     if (addr < UCDM_MAX_REGISTERS) {
         ucdm_acctype[addr] &= ~UCDM_AT_READ_MASK;
+        _ucdm_perm_update(addr);
         return 0;
     } else {
         return 1;
@@ -104,6 +346,7 @@ HAL_BASE_t ucdm_disable_regr(ucdm_addr_t addr){
 HAL_BASE_t ucdm_enable_regr(ucdm_addr_t addr){
     if (addr < UCDM_MAX_REGISTERS) {
         ucdm_acctype[addr] = (ucdm_acctype[addr] & ~UCDM_AT_READ_MASK) | UCDM_AT_READ_NORM;
+        _ucdm_perm_update(addr);
         return 0;
     } else {
         return 1;
@@ -113,6 +356,7 @@ HAL_BASE_t ucdm_enable_regr(ucdm_addr_t addr){
 HAL_BASE_t ucdm_redirect_regr_ptr(ucdm_addr_t addr, uint16_t * target){
     if (addr < UCDM_MAX_REGISTERS) {
         ucdm_acctype[addr] = (ucdm_acctype[addr] & ~UCDM_AT_READ_MASK) | UCDM_AT_READ_PTR;
+        _ucdm_perm_update(addr);
         ucdm_register[addr].ptr = target;
         return 0;
     } else {
@@ -123,6 +367,7 @@ HAL_BASE_t ucdm_redirect_regr_ptr(ucdm_addr_t addr, uint16_t * target){
 HAL_BASE_t ucdm_redirect_regr_func(ucdm_addr_t addr, uint16_t target(ucdm_addr_t)){
     if (addr < UCDM_MAX_REGISTERS) {
         ucdm_acctype[addr] = (ucdm_acctype[addr] & ~UCDM_AT_READ_MASK) | UCDM_AT_READ_FUNC;
+        _ucdm_perm_update(addr);
         ucdm_register[addr].rfunc = target;
         ucdm_disable_regw(addr);
         return 0;
@@ -131,7 +376,9 @@ HAL_BASE_t ucdm_redirect_regr_func(ucdm_addr_t addr, uint16_t target(ucdm_addr_t
     }
 }
 
-uint16_t ucdm_get_register(ucdm_addr_t addr){
+#endif
+
+static uint16_t _ucdm_read_register(ucdm_addr_t addr){
     if (addr >= UCDM_MAX_REGISTERS){
         return 0xFFFF;
     }
@@ -139,7 +386,7 @@ uint16_t ucdm_get_register(ucdm_addr_t addr){
     uint8_t regr_type = ucdm_acctype[addr] & UCDM_AT_READ_MASK;
     switch (regr_type){
         case UCDM_AT_READ_NORM:
-            return ucdm_register[addr].data;
+            return *_ucdm_register_data(addr);
             break;
         case UCDM_AT_READ_PTR:
             if (ucdm_register[addr].ptr){
@@ -150,7 +397,11 @@ uint16_t ucdm_get_register(ucdm_addr_t addr){
             break;
         case UCDM_AT_READ_FUNC:
             if (ucdm_register[addr].rfunc){
+                #if UCDM_CACHE_ENABLE
+                return _ucdm_cache_read(addr);
+                #else
                 return (ucdm_register[addr].rfunc)(addr);
+                #endif
             } else {
                 return 0xFFFF;
             }
@@ -162,9 +413,119 @@ uint16_t ucdm_get_register(ucdm_addr_t addr){
     }
 }
 
+uint16_t _ucdm_get_register(ucdm_addr_t addr){
+    #if UCDM_ALIAS_ENABLE
+    addr = _ucdm_alias_resolve(addr);
+    #endif
+    return _ucdm_read_register(addr);
+}
+
+static uint16_t _ucdm_protocol_read(ucdm_addr_t addr){
+    // Protocol read of a canonical register.
+    uint16_t value = _ucdm_read_register(addr);
+    #if UCDM_ENABLE_DIAGNOSTICS
+    _ucdm_diag_read(addr >= UCDM_MAX_REGISTERS || !(ucdm_acctype[addr] & UCDM_AT_READ_MASK));
+    #endif
+    #if UCDM_TRACE_ENABLE
+    _ucdm_trace_record(UCDM_TRACE_OP_REGR, addr, value, 
+        (addr >= UCDM_MAX_REGISTERS) ? 1 : 
+        !(ucdm_acctype[addr] & UCDM_AT_READ_MASK) ? 2 : 0);
+    #endif
+    return value;
+}
+
+uint16_t ucdm_get_register(ucdm_addr_t addr){
+    #if UCDM_ENABLE_DIAGNOSTICS
+    uint16_t exceptions = _ucdm_diag_message_begin();
+    #endif
+    #if UCDM_ALIAS_ENABLE
+    addr = _ucdm_alias_resolve(addr);
+    #endif
+    uint16_t value = _ucdm_protocol_read(addr);
+    #if UCDM_ENABLE_DIAGNOSTICS
+    _ucdm_diag_message_end(exceptions);
+    #endif
+    return value;
+}
+
+static void _ucdm_get_registers(ucdm_addr_t saddr, uint8_t count, uint16_t * target){
+    // Protocol read of a range of canonical registers.
+    uint8_t i = 0;
+    while (i < count){
+        #if UCDM_VIEW_ENABLE
+        uint8_t nv = _ucdm_view_read(saddr + i, count - i, &target[i]);
+        if (nv){
+            for (uint8_t j=i; j < i + nv; j++){
+                #if UCDM_ENABLE_DIAGNOSTICS
+                _ucdm_diag_read(0);
+                #endif
+                #if UCDM_TRACE_ENABLE
+                _ucdm_trace_record(UCDM_TRACE_OP_REGR, saddr + j, target[j], 0);
+                #endif
+            }
+            i += nv;
+            continue;
+        }
+        #endif
+        #if UCDM_BLOCK_ENABLE
+        uint8_t n = _ucdm_block_read(saddr + i, count - i, &target[i]);
+        if (n){
+            for (uint8_t j=i; j < i + n; j++){
+                #if UCDM_ENABLE_DIAGNOSTICS
+                _ucdm_diag_read(0);
+                #endif
+                #if UCDM_TRACE_ENABLE
+                _ucdm_trace_record(UCDM_TRACE_OP_REGR, saddr + j, target[j], 0);
+                #endif
+            }
+            i += n;
+            continue;
+        }
+        #endif
+        target[i] = _ucdm_protocol_read(saddr + i);
+        i++;
+    }
+}
+
+static HAL_BASE_t _ucdm_protocol_get_registers(ucdm_addr_t saddr, uint8_t count, uint16_t * target){
+    if ((uint32_t)saddr + count > UCDM_MAX_REGISTERS){
+        #if UCDM_ENABLE_DIAGNOSTICS
+        _ucdm_diag_exception(UCDM_EXCEPTION_ILLEGAL_ADDRESS);
+        #endif
+        return 1;
+    }
+    #if UCDM_ALIAS_ENABLE
+    ucdm_addr_t caddr;
+    while (count){
+        uint8_t n = _ucdm_alias_run(saddr, count, &caddr);
+        _ucdm_get_registers(caddr, n, target);
+        saddr += n;
+        count -= n;
+        target += n;
+    }
+    #else
+    _ucdm_get_registers(saddr, count, target);
+    #endif
+    return 0;
+}
+
+HAL_BASE_t ucdm_get_registers(ucdm_addr_t saddr, uint8_t count, uint16_t * target){
+    #if UCDM_ENABLE_DIAGNOSTICS
+    uint16_t exceptions = _ucdm_diag_message_begin();
+    HAL_BASE_t rval = _ucdm_protocol_get_registers(saddr, count, target);
+    _ucdm_diag_message_end(exceptions);
+    return rval;
+    #else
+    return _ucdm_protocol_get_registers(saddr, count, target);
+    #endif
+}
+
+#if !UCDM_CONST_CONFIG
+
 HAL_BASE_t ucdm_disable_regw(ucdm_addr_t addr){
     if (addr < UCDM_MAX_REGISTERS) {
         ucdm_acctype[addr] &= ~UCDM_AT_REGW_TYPE_MASK;
+        _ucdm_perm_update(addr);
         return 0;
     } else {
         return 1;
@@ -174,6 +535,7 @@ HAL_BASE_t ucdm_disable_regw(ucdm_addr_t addr){
 HAL_BASE_t ucdm_enable_regw(ucdm_addr_t addr){
     if (addr < UCDM_MAX_REGISTERS) {
         ucdm_acctype[addr] = (ucdm_acctype[addr] & ~UCDM_AT_REGW_TYPE_MASK) | UCDM_AT_REGW_TYPE_NORMAL;
+        _ucdm_perm_update(addr);
         return 0;
     } else {
         return 1;
@@ -183,6 +545,7 @@ HAL_BASE_t ucdm_enable_regw(ucdm_addr_t addr){
 HAL_BASE_t ucdm_redirect_regw_ptr(ucdm_addr_t addr, uint16_t * target){
     if (addr < UCDM_MAX_REGISTERS) {
         ucdm_acctype[addr] = (ucdm_acctype[addr] & ~UCDM_AT_REGW_TYPE_MASK) | UCDM_AT_REGW_TYPE_PTR;
+        _ucdm_perm_update(addr);
         ucdm_register[addr].ptr = target;
         return 0;
     } else {
@@ -193,6 +556,7 @@ HAL_BASE_t ucdm_redirect_regw_ptr(ucdm_addr_t addr, uint16_t * target){
 HAL_BASE_t ucdm_redirect_regw_func(ucdm_addr_t addr, void target(ucdm_addr_t, uint16_t)){
     if (addr < UCDM_MAX_REGISTERS) {
         ucdm_acctype[addr] = (ucdm_acctype[addr] & ~UCDM_AT_REGW_TYPE_MASK) | UCDM_AT_REGW_TYPE_FUNC;
+        _ucdm_perm_update(addr);
         ucdm_register[addr].wfunc = target;
         ucdm_disable_regr(addr);
         return 0;
@@ -201,16 +565,47 @@ HAL_BASE_t ucdm_redirect_regw_func(ucdm_addr_t addr, void target(ucdm_addr_t, ui
     }
 }
 
+#endif
 
-HAL_BASE_t ucdm_set_register(ucdm_addr_t addr, uint16_t value){
+static inline void _ucdm_post_write(ucdm_addr_t addr, uint16_t value){
+    // Processing common to every successful register write.
+    #if UCDM_RBE_ENABLE
+    _ucdm_rbe_check(addr, value);
+    #endif
+
+    #if UCDM_SHM_ENABLE
+    _ucdm_shm_update(addr);
+    #endif
+
+    #if UCDM_REPL_ENABLE
+    _ucdm_repl_capture(addr);
+    #endif
+   
+    #if UCDM_ENABLE_HANDLERS
+    if (ucdm_acctype[addr] & UCDM_AT_REGW_HF){
+        _ucdm_exec_rw_handlers(addr);
+    }
+    #endif
+}
+
+#if UCDM_ASYNC_ENABLE
+void _ucdm_async_post_write(ucdm_addr_t addr, uint16_t value){
+    _ucdm_post_write(addr, value);
+}
+#endif
+
+static HAL_BASE_t _ucdm_write_register(ucdm_addr_t addr, uint16_t value){
     if (addr >= UCDM_MAX_REGISTERS){
         return 1;
     }
+    #if UCDM_VIEW_ENABLE
+    HAL_BASE_t rval;
+    #endif
     
     uint8_t regw_type = ucdm_acctype[addr] & UCDM_AT_REGW_TYPE_MASK;
     switch (regw_type){
         case UCDM_AT_REGW_TYPE_NORMAL:
-            ucdm_register[addr].data = value;
+            *_ucdm_register_data(addr) = value;
             break;
         case UCDM_AT_REGW_TYPE_PTR:
             if (ucdm_register[addr].ptr){
@@ -220,6 +615,11 @@ HAL_BASE_t ucdm_set_register(ucdm_addr_t addr, uint16_t value){
             }
             break;
         case UCDM_AT_REGW_TYPE_FUNC:
+            #if UCDM_VIEW_ENABLE
+            if (_ucdm_view_write(addr, 1, &value, &rval)){
+                return rval;
+            }
+            #endif
             if (ucdm_register[addr].wfunc){
                 (ucdm_register[addr].wfunc)(addr, value);
             } else {
@@ -231,22 +631,173 @@ HAL_BASE_t ucdm_set_register(ucdm_addr_t addr, uint16_t value){
             return 2;
             break;
     }
-   
-    #if UCDM_ENABLE_HANDLERS
-    if (ucdm_acctype[addr] & UCDM_AT_REGW_HF){
-        avlt_node_t * hfnode;
-        hfnode = avlt_find_node(&ucdm_rwht, addr);
-        if (hfnode && hfnode->content){
-            ((ucdm_rw_handler_t)(hfnode->content))(addr);
+
+    _ucdm_post_write(addr, value);
+    return 0;
+}
+
+HAL_BASE_t _ucdm_set_register(ucdm_addr_t addr, uint16_t value){
+    #if UCDM_ALIAS_ENABLE
+    addr = _ucdm_alias_resolve(addr);
+    #endif
+    return _ucdm_write_register(addr, value);
+}
+
+static HAL_BASE_t _ucdm_protocol_write(ucdm_addr_t addr, uint16_t value){
+    // Protocol write of a canonical register.
+    HAL_BASE_t rval = _ucdm_write_register(addr, value);
+    #if UCDM_ENABLE_DIAGNOSTICS
+    _ucdm_diag_write(!rval ? 0 : (rval == 3) ? UCDM_EXCEPTION_DEVICE_FAILURE : 
+                                               UCDM_EXCEPTION_ILLEGAL_ADDRESS);
+    #endif
+    #if UCDM_TRACE_ENABLE
+    _ucdm_trace_record(UCDM_TRACE_OP_REGW, addr, value, rval);
+    #endif
+    return rval;
+}
+
+HAL_BASE_t ucdm_set_register(ucdm_addr_t addr, uint16_t value){
+    #if UCDM_ENABLE_DIAGNOSTICS
+    uint16_t exceptions = _ucdm_diag_message_begin();
+    #endif
+    #if UCDM_ALIAS_ENABLE
+    addr = _ucdm_alias_resolve(addr);
+    #endif
+    HAL_BASE_t rval = _ucdm_protocol_write(addr, value);
+    #if UCDM_ENABLE_DIAGNOSTICS
+    _ucdm_diag_message_end(exceptions);
+    #endif
+    return rval;
+}
+
+static HAL_BASE_t _ucdm_set_registers(ucdm_addr_t saddr, uint8_t count, const uint16_t * values){
+    // Protocol write of a range of canonical registers.
+    HAL_BASE_t rval;
+    uint8_t i = 0;
+    while (i < count){
+        #if UCDM_VIEW_ENABLE
+        uint8_t nv = _ucdm_view_write(saddr + i, count - i, &values[i], &rval);
+        if (nv){
+            for (uint8_t j=i; j < i + nv; j++){
+                #if UCDM_ENABLE_DIAGNOSTICS
+                _ucdm_diag_write((!rval || j < i + nv - 1) ? 0 : (rval == 3) ? 
+                                 UCDM_EXCEPTION_DEVICE_FAILURE : UCDM_EXCEPTION_ILLEGAL_ADDRESS);
+                #endif
+                #if UCDM_TRACE_ENABLE
+                _ucdm_trace_record(UCDM_TRACE_OP_REGW, saddr + j, values[j], 
+                                   (j == i + nv - 1) ? rval : 0);
+                #endif
+            }
+            if (rval){
+                return rval;
+            }
+            i += nv;
+            continue;
         }
+        #endif
+        #if UCDM_BLOCK_ENABLE
+        uint8_t n = _ucdm_block_write(saddr + i, count - i, &values[i]);
+        if (n){
+            for (uint8_t j=i; j < i + n; j++){
+                _ucdm_post_write(saddr + j, values[j]);
+                #if UCDM_ENABLE_DIAGNOSTICS
+                _ucdm_diag_write(0);
+                #endif
+                #if UCDM_TRACE_ENABLE
+                _ucdm_trace_record(UCDM_TRACE_OP_REGW, saddr + j, values[j], 0);
+                #endif
+            }
+            i += n;
+            continue;
+        }
+        #endif
+        rval = _ucdm_protocol_write(saddr + i, values[i]);
+        if (rval){
+            return rval;
+        }
+        i++;
+    }
+    return 0;
+}
+
+static HAL_BASE_t _ucdm_protocol_set_registers(ucdm_addr_t saddr, uint8_t count, const uint16_t * values){
+    if ((uint32_t)saddr + count > UCDM_MAX_REGISTERS){
+        #if UCDM_ENABLE_DIAGNOSTICS
+        _ucdm_diag_exception(UCDM_EXCEPTION_ILLEGAL_ADDRESS);
+        #endif
+        return 1;
+    }
+    #if UCDM_ALIAS_ENABLE
+    HAL_BASE_t rval;
+    ucdm_addr_t caddr;
+    while (count){
+        uint8_t n = _ucdm_alias_run(saddr, count, &caddr);
+        rval = _ucdm_set_registers(caddr, n, values);
+        if (rval){
+            return rval;
+        }
+        saddr += n;
+        count -= n;
+        values += n;
     }
-    #endif
     return 0;
+    #else
+    return _ucdm_set_registers(saddr, count, values);
+    #endif
+}
+
+HAL_BASE_t ucdm_set_registers(ucdm_addr_t saddr, uint8_t count, const uint16_t * values){
+    #if UCDM_ENABLE_DIAGNOSTICS
+    uint16_t exceptions = _ucdm_diag_message_begin();
+    HAL_BASE_t rval = _ucdm_protocol_set_registers(saddr, count, values);
+    _ucdm_diag_message_end(exceptions);
+    return rval;
+    #else
+    return _ucdm_protocol_set_registers(saddr, count, values);
+    #endif
 }
 
+uint8_t ucdm_range_readable(ucdm_addr_t addr, uint16_t count){
+    if (!count || (uint32_t)addr + count > UCDM_MAX_REGISTERS){
+        return 0;
+    }
+    #if UCDM_ENABLE_PERM_BITMAPS
+    return _ucdm_perm_range(ucdm_perm_readable, addr, count);
+    #else
+    return _ucdm_perm_range_acctype(addr, count, UCDM_AT_READ_MASK);
+    #endif
+}
+
+uint8_t ucdm_range_writable(ucdm_addr_t addr, uint16_t count){
+    if (!count || (uint32_t)addr + count > UCDM_MAX_REGISTERS){
+        return 0;
+    }
+    #if UCDM_ENABLE_PERM_BITMAPS
+    return _ucdm_perm_range(ucdm_perm_writable, addr, count);
+    #else
+    return _ucdm_perm_range_acctype(addr, count, UCDM_AT_REGW_TYPE_MASK);
+    #endif
+}
+
+uint8_t ucdm_range_bit_writable(ucdm_addrb_t addrb, uint16_t count){
+    if (!count || (uint32_t)addrb + count > UCDM_MAX_BITS){
+        return 0;
+    }
+    uint32_t addr = addrb >> 4;
+    uint32_t nregs = (((uint32_t)addrb + count - 1) >> 4) - addr + 1;
+    #if UCDM_ENABLE_PERM_BITMAPS
+    return _ucdm_perm_range(ucdm_perm_bitwritable, addr, nregs);
+    #else
+    return _ucdm_perm_range_acctype(addr, nregs, UCDM_AT_BITW_WE);
+    #endif
+}
+
+#if !UCDM_CONST_CONFIG
+
 HAL_BASE_t ucdm_enable_bitw(ucdm_addr_t addr){
     if (addr < UCDM_MAX_REGISTERS) {
         ucdm_acctype[addr] |= UCDM_AT_BITW_WE;
+        _ucdm_perm_update(addr);
         return 0;
     } else {
         return 1;
@@ -256,12 +807,15 @@ HAL_BASE_t ucdm_enable_bitw(ucdm_addr_t addr){
 HAL_BASE_t ucdm_disable_bitw(ucdm_addr_t addr){
     if (addr < UCDM_MAX_REGISTERS) {
         ucdm_acctype[addr] &= ~UCDM_AT_BITW_WE;
+        _ucdm_perm_update(addr);
         return 0;
     } else {
         return 1;
     }
 }
 
+#endif
+
 static inline void _ucdm_wfunc_bitset(uint16_t * target, uint16_t mask);
 static inline void _ucdm_wfunc_bitclear(uint16_t * target, uint16_t mask);
 static uint8_t _ucdm_generic_wop_bit(ucdm_addrb_t addrb, void wfunc(uint16_t *, uint16_t));
@@ -271,18 +825,11 @@ static uint8_t _ucdm_generic_wop_bit(ucdm_addrb_t addrb, void wfunc(uint16_t *,
 static void _ucdm_exec_bit_handler(ucdm_addr_t addr, uint16_t mask);
 
 static void _ucdm_exec_bit_handler(ucdm_addr_t addr, uint16_t mask){
-    avlt_node_t * hfnode;
     if (ucdm_acctype[addr] & UCDM_AT_BITW_HF){
-        hfnode = avlt_find_node(&ucdm_bwht, addr);
-        if (hfnode && hfnode->content){
-            ((ucdm_bw_handler_t)(hfnode->content))(addr, mask);
-        }
+        _ucdm_exec_bw_handlers(addr, mask);
     }
     else if (ucdm_acctype[addr] & UCDM_AT_REGW_HF){
-        hfnode = avlt_find_node(&ucdm_rwht, addr);
-        if (hfnode && hfnode->content){
-            ((ucdm_rw_handler_t)(hfnode->content))(addr);
-        }
+        _ucdm_exec_rw_handlers(addr);
     }
     return;
 }
@@ -316,7 +863,7 @@ static uint8_t _ucdm_generic_wop_bit(ucdm_addrb_t addrb, void wfunc(uint16_t *,
     
     switch (reg_at & UCDM_AT_REGW_TYPE_MASK){
         case UCDM_AT_REGW_TYPE_NORMAL:
-            wfunc(&(ucdm_register[addr].data), mask);
+            wfunc(_ucdm_register_data(addr), mask);
             break;
         case UCDM_AT_REGW_TYPE_PTR:
             if (ucdm_register[addr].ptr){
@@ -330,21 +877,65 @@ static uint8_t _ucdm_generic_wop_bit(ucdm_addrb_t addrb, void wfunc(uint16_t *,
         default:
             return 3;
     }
+    #if UCDM_RBE_ENABLE
+    _ucdm_rbe_check(addr, _ucdm_read_register(addr));
+    #endif
+    #if UCDM_SHM_ENABLE
+    _ucdm_shm_update(addr);
+    #endif
+    #if UCDM_REPL_ENABLE
+    _ucdm_repl_capture(addr);
+    #endif
     #if UCDM_ENABLE_HANDLERS
     _ucdm_exec_bit_handler(addr, mask);
     #endif
     return 0;
 }
 
+HAL_BASE_t _ucdm_write_bit(ucdm_addrb_t addrb, uint8_t value){
+    #if UCDM_ALIAS_ENABLE
+    addrb = _ucdm_alias_resolve_bit(addrb);
+    #endif
+    return _ucdm_generic_wop_bit(addrb, value ? _ucdm_wfunc_bitset : _ucdm_wfunc_bitclear);
+}
+
 HAL_BASE_t ucdm_set_bit(ucdm_addrb_t addrb){
-    return _ucdm_generic_wop_bit(addrb, _ucdm_wfunc_bitset);
+    #if UCDM_ALIAS_ENABLE
+    addrb = _ucdm_alias_resolve_bit(addrb);
+    #endif
+    HAL_BASE_t rval = _ucdm_generic_wop_bit(addrb, _ucdm_wfunc_bitset);
+    #if UCDM_ENABLE_DIAGNOSTICS
+    uint16_t exceptions = _ucdm_diag_message_begin();
+    _ucdm_diag_write(!rval ? 0 : (rval == 4) ? UCDM_EXCEPTION_DEVICE_FAILURE : 
+                                               UCDM_EXCEPTION_ILLEGAL_ADDRESS);
+    _ucdm_diag_message_end(exceptions);
+    #endif
+    #if UCDM_TRACE_ENABLE
+    _ucdm_trace_record(UCDM_TRACE_OP_BITS, addrb >> 4, 1 << (addrb & 15), rval);
+    #endif
+    return rval;
 }
 
 HAL_BASE_t ucdm_clear_bit(ucdm_addrb_t addrb){
-    return _ucdm_generic_wop_bit(addrb, _ucdm_wfunc_bitclear);
+    #if UCDM_ALIAS_ENABLE
+    addrb = _ucdm_alias_resolve_bit(addrb);
+    #endif
+    HAL_BASE_t rval = _ucdm_generic_wop_bit(addrb, _ucdm_wfunc_bitclear);
+    #if UCDM_ENABLE_DIAGNOSTICS
+    uint16_t exceptions = _ucdm_diag_message_begin();
+    _ucdm_diag_write(!rval ? 0 : (rval == 4) ? UCDM_EXCEPTION_DEVICE_FAILURE : 
+                                               UCDM_EXCEPTION_ILLEGAL_ADDRESS);
+    _ucdm_diag_message_end(exceptions);
+    #endif
+    #if UCDM_TRACE_ENABLE
+    _ucdm_trace_record(UCDM_TRACE_OP_BITC, addrb >> 4, 1 << (addrb & 15), rval);
+    #endif
+    return rval;
 }
 
-uint8_t ucdm_get_bit(ucdm_addrb_t addrb){
+static inline uint8_t _ucdm_get_bit(ucdm_addrb_t addrb);
+
+static inline uint8_t _ucdm_get_bit(ucdm_addrb_t addrb){
     if (addrb >= UCDM_MAX_BITS){
         return 1;
     }
@@ -355,7 +946,7 @@ uint8_t ucdm_get_bit(ucdm_addrb_t addrb){
     reg_at = ucdm_acctype[addr] & UCDM_AT_READ_MASK;
     switch (reg_at){
         case UCDM_AT_READ_NORM:
-            if (ucdm_register[addr].data & mask){
+            if (*_ucdm_register_data(addr) & mask){
                 return 0xFF;
             }
             else{
@@ -378,6 +969,22 @@ uint8_t ucdm_get_bit(ucdm_addrb_t addrb){
     }
 }
 
+uint8_t ucdm_get_bit(ucdm_addrb_t addrb){
+    #if UCDM_ALIAS_ENABLE
+    addrb = _ucdm_alias_resolve_bit(addrb);
+    #endif
+    uint8_t rval = _ucdm_get_bit(addrb);
+    #if UCDM_ENABLE_DIAGNOSTICS
+    uint16_t exceptions = _ucdm_diag_message_begin();
+    _ucdm_diag_read(addrb >= UCDM_MAX_BITS || !(ucdm_acctype[addrb >> 4] & UCDM_AT_READ_MASK));
+    _ucdm_diag_message_end(exceptions);
+    #endif
+    #if UCDM_TRACE_ENABLE
+    _ucdm_trace_record(UCDM_TRACE_OP_BITR, addrb >> 4, 1 << (addrb & 15), rval);
+    #endif
+    return rval;
+}
+
 #if UCDM_ENABLE_HANDLERS
 
 static void _prepare_regw_handler(avlt_node_t * node, ucdm_addr_t addr, 
@@ -394,7 +1001,9 @@ HAL_BASE_t ucdm_install_regw_handler(ucdm_addr_t addr,
                                avlt_node_t * rwh_node, 
                                ucdm_rw_handler_t handler){
     if (addr < UCDM_MAX_REGISTERS) {    
+        #if !UCDM_CONST_CONFIG
         ucdm_acctype[addr] |= UCDM_AT_REGW_HF;
+        #endif
         _prepare_regw_handler(rwh_node, addr, handler);
         avlt_insert_node(&ucdm_rwht, rwh_node);
         return 0;
@@ -417,7 +1026,9 @@ HAL_BASE_t ucdm_install_bitw_handler(ucdm_addr_t addr,
                                avlt_node_t * bwh_node, 
                                ucdm_bw_handler_t handler){
     if (addr < UCDM_MAX_REGISTERS) {
+        #if !UCDM_CONST_CONFIG
         ucdm_acctype[addr] |= UCDM_AT_BITW_HF;
+        #endif
         _prepare_bitw_handler(bwh_node, addr, handler);
         avlt_insert_node(&ucdm_bwht, bwh_node);
         return 0;
@@ -426,4 +1037,43 @@ HAL_BASE_t ucdm_install_bitw_handler(ucdm_addr_t addr,
     }
 }
 
+static HAL_BASE_t _ucdm_handler_priority(void * handler, uint8_t priority){
+    #if UCDM_DEFER_ENABLE
+    if (ucdm_defer_set_priority(handler, priority)){
+        return 2;
+    }
+    #endif
+    return 0;
+}
+
+HAL_BASE_t ucdm_install_regw_handler_prio(ucdm_addr_t addr, 
+                               avlt_node_t * rwh_node, 
+                               ucdm_rw_handler_t handler, 
+                               uint8_t priority){
+    // The priority is assigned first, so that the handler is not left 
+    // installed if it can't be.
+    if (addr >= UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    if (_ucdm_handler_priority((void *)handler, priority)){
+        return 2;
+    }
+    return ucdm_install_regw_handler(addr, rwh_node, handler);
+}
+
+HAL_BASE_t ucdm_install_bitw_handler_prio(ucdm_addr_t addr, 
+                               avlt_node_t * bwh_node, 
+                               ucdm_bw_handler_t handler, 
+                               uint8_t priority){
+    // The priority is assigned first, so that the handler is not left 
+    // installed if it can't be.
+    if (addr >= UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    if (_ucdm_handler_priority((void *)handler, priority)){
+        return 2;
+    }
+    return ucdm_install_bitw_handler(addr, bwh_node, handler);
+}
+
 #endif
\ No newline at end of file
@@ -196,6 +196,28 @@
  * access to variables larger than 16-bit should use the pointer redirection 
  * functionality.
  * 
+ * Const Configuration
+ * ===================
+ * 
+ * On devices whose register map is fixed at build time, the access type 
+ * and redirection targets can be kept in flash instead of RAM by setting 
+ * APP_ENABLE_UCDM_CONST_CONFIG. The application then defines ucdm_acctype 
+ * and ucdm_register as const tables of UCDM_MAX_REGISTERS entries, using 
+ * the UCDM_CONST_* initializers for ucdm_register. Registers which store 
+ * their content in UCDM (normal read or write type) are given an index 
+ * into ucdm_data, a RAM array of APP_UCDM_CONST_DATA_COUNT words, so that 
+ * only those registers consume RAM. Indices need not be unique, though 
+ * there is rarely a reason to share one. 
+ * 
+ * In this mode, the register configuration functions are not available, 
+ * and neither are the modules which rely on them (spans, sampler, blocks, 
+ * device maps, async registers and views). Post-write handlers can still 
+ * be installed, but the handler flags of the registers they are installed 
+ * on must already be set in the const access type table. The permission 
+ * bitmaps are disabled by default, and are built from the tables by 
+ * ucdm_init if enabled. The application accesses the content of normal 
+ * registers through ucdm_data. 
+ * 
  * @see ucdm.c
  */
 
@@ -207,8 +229,15 @@
 #include <stdint.h>
 #include "config.h"
 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
 #define UCDM_EXST_KEEPALIVE_REQ         0x01
 #define UCDM_EXST_TIMESYNC_REQ          0x02
+#define UCDM_EXST_READ_REJECTED         0x04
+#define UCDM_EXST_WRITE_REJECTED        0x08
 
 typedef UCDM_REG_ADDR_TYPE ucdm_addr_t;
 typedef UCDM_BIT_ADDR_TYPE ucdm_addrb_t;
@@ -231,18 +260,70 @@ typedef union UCDM_REGISTER_t{
  */
 /**@{*/ 
 
+#if UCDM_CONST_CONFIG
+
+/** \brief Const redirection targets and data indices for UCDM registers. */
+extern const ucdm_register_t ucdm_register[];
+
+/** \brief Const UCDM access type settings. */
+extern const ucdm_acctype_t ucdm_acctype[];
+
+/** \brief Actual storage for normal UCDM registers, by data index. */
+extern uint16_t ucdm_data[];
+
+#else
+
 /** \brief Actual storage for UCDM registers. */
 extern ucdm_register_t ucdm_register[];
 
 /** \brief Actual storage for UCDM access type settings. */
 extern ucdm_acctype_t ucdm_acctype[];
 
+#endif
+
+#if UCDM_ENABLE_HANDLERS
+/** \brief Trees of post-write handlers installed with application nodes. */
+extern avlt_t ucdm_rwht;
+extern avlt_t ucdm_bwht;
+#endif
+
 extern uint16_t ucdm_diagnostic_register;
 
 extern  uint8_t ucdm_exception_status;
 
 /**@}*/ 
 
+/**
+ * @name UCDM Const Configuration Initializers
+ * 
+ * Initializers for entries of the const ucdm_register table. 
+ */
+/**@{*/ 
+/** Register without storage or redirection */
+#define UCDM_CONST_NONE             {.data = 0}
+/** Normal register, stored in ucdm_data at the given index */
+#define UCDM_CONST_DATA(idx)        {.data = (idx)}
+/** Register redirected to a pointer */
+#define UCDM_CONST_PTR(target)      {.ptr = (target)}
+/** Register with read redirected to a function */
+#define UCDM_CONST_RFUNC(target)    {.rfunc = (target)}
+/** Register with write redirected to a function */
+#define UCDM_CONST_WFUNC(target)    {.wfunc = (target)}
+/**@}*/ 
+
+/** 
+  * \brief Get a pointer to the storage of a normal UCDM register.
+  * 
+  * @param addr Address/identifier of the register
+  */
+static inline uint16_t * _ucdm_register_data(ucdm_addr_t addr){
+    #if UCDM_CONST_CONFIG
+    return &ucdm_data[ucdm_register[addr].data];
+    #else
+    return &ucdm_register[addr].data;
+    #endif
+}
+
 /**
  * @name UCDM Access Type Definitions for Register and Bit Read
  */
@@ -308,6 +389,8 @@ extern  uint8_t ucdm_exception_status;
 void ucdm_init(void);
 /**@}*/
 
+#if !UCDM_CONST_CONFIG
+
 /**
  * @name UCDM Register Configuration Functions for Register Read
  */
@@ -419,6 +502,8 @@ HAL_BASE_t ucdm_redirect_regw_func(ucdm_addr_t addr, void target(ucdm_addr_t, ui
 
 /**@}*/ 
 
+#endif
+
 /**
  * @name UCDM Register Configuration Functions for Post-Write Handler Functions
  */
@@ -426,7 +511,9 @@ HAL_BASE_t ucdm_redirect_regw_func(ucdm_addr_t addr, void target(ucdm_addr_t, ui
 /** 
  * \brief Install a Register Write Handler for a UCDM register.
  * 
- * \warning This will overwrite any handler previously installed.
+ * \warning This will overwrite any handler previously installed with a 
+ *          tree node. Use the handler pool (hpool.h) to install several 
+ *          handlers on the same register.
  * 
  * @param addr Address/identifier of the register.
  * @param rwh_node Handler tree node container to use. This should be allocated 
@@ -440,7 +527,9 @@ HAL_BASE_t ucdm_install_regw_handler(ucdm_addr_t addr,
 /** 
  * \brief Install a Bit Write Handler for a UCDM register.
  * 
- * \warning This will overwrite any handler previously installed.
+ * \warning This will overwrite any handler previously installed with a 
+ *          tree node. Use the handler pool (hpool.h) to install several 
+ *          handlers on the same register.
  * 
  * @param addr Address/identifier of the register.
  * @param bwh_node Handler tree node container to use. This should be allocated 
@@ -450,6 +539,36 @@ HAL_BASE_t ucdm_install_regw_handler(ucdm_addr_t addr,
 HAL_BASE_t ucdm_install_bitw_handler(ucdm_addr_t addr, 
                                avlt_node_t * bwh_node, 
                                ucdm_bw_handler_t handler);
+
+/** 
+ * \brief Install a Register Write Handler with a priority class.
+ * 
+ * The priority class determines the order in which deferred executions 
+ * of the handler are drained by ucdm_defer_poll. See defer.h. It has no 
+ * effect if handler deferral is not enabled. 
+ * 
+ * @param addr Address/identifier of the register.
+ * @param rwh_node Handler tree node container to use.
+ * @param handler Pointer to the handler function.
+ * @param priority Priority class of the handler, 0 being the lowest.
+ * @return 0 for success, 1 for register out of range, 2 if the priority 
+ *         class could not be assigned, in which case the handler is not 
+ *         installed.
+ */
+HAL_BASE_t ucdm_install_regw_handler_prio(ucdm_addr_t addr, 
+                               avlt_node_t * rwh_node, 
+                               ucdm_rw_handler_t handler, 
+                               uint8_t priority);
+
+/** 
+ * \brief Install a Bit Write Handler with a priority class.
+ * 
+ * @see ucdm_install_regw_handler_prio
+ */
+HAL_BASE_t ucdm_install_bitw_handler_prio(ucdm_addr_t addr, 
+                               avlt_node_t * bwh_node, 
+                               ucdm_bw_handler_t handler, 
+                               uint8_t priority);
 /**@}*/ 
 
 /**
@@ -465,6 +584,23 @@ HAL_BASE_t ucdm_install_bitw_handler(ucdm_addr_t addr,
   */
 HAL_BASE_t ucdm_set_register(ucdm_addr_t addr, uint16_t value);
 
+/** 
+  * \brief Set the values of a range of UCDM registers from protocol.
+  * 
+  * Equivalent to calling ucdm_set_register on each register of the range, 
+  * except that registers served by a block write function are written 
+  * with a single call to that function. Registers are written in order, 
+  * and writing stops at the first register which could not be written. 
+  * 
+  * @param saddr Address/identifier of the first register
+  * @param count Number of registers to write
+  * @param values Array of count values to be written
+  * @return 0 for registers set, 1 if the range extends beyond the last 
+  *         register, otherwise the error returned by ucdm_set_register 
+  *         for the first failing register.
+  */
+HAL_BASE_t ucdm_set_registers(ucdm_addr_t saddr, uint8_t count, const uint16_t * values);
+
 /** 
   * \brief Get the value of a UCDM register from protocol.
   * 
@@ -472,6 +608,101 @@ HAL_BASE_t ucdm_set_register(ucdm_addr_t addr, uint16_t value);
   * @return Value of the register, or 0xFFFF if address is invalid.
   */
 uint16_t ucdm_get_register(ucdm_addr_t addr);
+
+/** 
+  * \brief Get the values of a range of UCDM registers from protocol.
+  * 
+  * Equivalent to calling ucdm_get_register on each register of the range, 
+  * except that registers served by a block read function are read with 
+  * a single call to that function. 
+  * 
+  * @param saddr Address/identifier of the first register
+  * @param count Number of registers to read
+  * @param target Array of count words to be filled in
+  * @return 0 for success, 1 if the range extends beyond the last register.
+  */
+HAL_BASE_t ucdm_get_registers(ucdm_addr_t saddr, uint8_t count, uint16_t * target);
+
+/** 
+  * \brief Get the value of a UCDM register from within UCDM subsystems.
+  * 
+  * Identical to ucdm_get_register, except that the access is not counted 
+  * as a protocol access by tracing and diagnostics. 
+  * 
+  * @param addr Address/identifier of the register
+  * @return Value of the register, or 0xFFFF if address is invalid.
+  */
+uint16_t _ucdm_get_register(ucdm_addr_t addr);
+
+/** 
+  * \brief Set the value of a UCDM register from within UCDM subsystems.
+  * 
+  * Identical to ucdm_set_register, except that the access is not counted 
+  * as a protocol access by tracing and diagnostics. 
+  * 
+  * @param addr Address/identifier of the register
+  * @param value The value to be set
+  * @return As for ucdm_set_register.
+  */
+HAL_BASE_t _ucdm_set_register(ucdm_addr_t addr, uint16_t value);
+
+/** 
+  * \brief Set or clear a UCDM bit from within UCDM subsystems.
+  * 
+  * Identical to ucdm_set_bit or ucdm_clear_bit, except that the access is 
+  * not counted as a protocol access by tracing and diagnostics. 
+  * 
+  * @param addrb Address/identifier of the bit
+  * @param value Non-zero to set the bit, 0 to clear it
+  * @return As for ucdm_set_bit.
+  */
+HAL_BASE_t _ucdm_write_bit(ucdm_addrb_t addrb, uint8_t value);
+/**@}*/ 
+
+/**
+ * @name UCDM Range Permission Checks
+ * 
+ * These allow protocol implementations to validate a whole request before 
+ * executing any of it, for instance to return MODBUS exception 02 for a 
+ * multi-register request which touches an inaccessible register. With 
+ * APP_ENABLE_UCDM_PERM_BITMAPS (the default), the configuration functions 
+ * maintain bitmaps of readable, register-writable and bit-writable 
+ * registers, and ranges are checked a word of the bitmap at a time. 
+ * Without, each register's access type is checked in turn.
+ */
+/**@{*/ 
+/** 
+  * \brief Check whether every register in a range can be read.
+  * 
+  * @param addr Address/identifier of the first register
+  * @param count Number of registers
+  * @return 1 if all registers exist and are readable, 0 otherwise.
+  */
+uint8_t ucdm_range_readable(ucdm_addr_t addr, uint16_t count);
+
+/** 
+  * \brief Check whether every register in a range can be written.
+  * 
+  * @param addr Address/identifier of the first register
+  * @param count Number of registers
+  * @return 1 if all registers exist and are writable, 0 otherwise.
+  */
+uint8_t ucdm_range_writable(ucdm_addr_t addr, uint16_t count);
+
+/** 
+  * \brief Check whether every bit in a range can be written.
+  * 
+  * @param addrb Address/identifier of the first bit
+  * @param count Number of bits
+  * @return 1 if all bits exist and are writable, 0 otherwise.
+  */
+uint8_t ucdm_range_bit_writable(ucdm_addrb_t addrb, uint16_t count);
+
+/** 
+  * \brief Update the permission bitmaps after a register's access type 
+  *        is changed from outside the configuration functions.
+  */
+void _ucdm_perm_update(ucdm_addr_t addr);
 /**@}*/ 
 
 
@@ -520,4 +751,8 @@ HAL_BASE_t ucdm_clear_bit(ucdm_addrb_t addrb);
 uint8_t ucdm_get_bit(ucdm_addrb_t addrb);
 /**@}*/ 
 
+#ifdef __cplusplus
+}
+#endif /* extern "C" */
+
 #endif
@@ -0,0 +1,179 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file value.hpp
+ * @brief Typed C++ accessors for values spanning multiple registers
+ *
+ * The ucdm::value template binds a typed variable to a contiguous range
+ * of UCDM registers at compile time. Each register in the range is
+ * pointer-redirected directly to the corresponding 16-bit word of the
+ * variable, so protocol reads and writes are plain loads and stores on
+ * the variable itself. There is no hashmap lookup and no staging buffer
+ * involved, as there is with the span redirections in span.h.
+ *
+ * Usage :
+ *
+ * @code
+ * ucdm::value<int64_t, 0x20> energy;
+ * ucdm::value<float, 0x24, ucdm::WordOrder::BigEndian> setpoint;
+ *
+ * void devicemap_init(void){
+ *     energy.bind_read();
+ *     setpoint.bind();
+ * }
+ *
+ * energy = 1234567890123;
+ * float sp = setpoint;
+ * @endcode
+ *
+ * The word order determines which register holds which word of the
+ * value. With WordOrder::LittleEndian, the register at ADDR holds the
+ * least significant word. With WordOrder::BigEndian, it holds the most
+ * significant word. The byte order within each register is always the
+ * natural order of a 16-bit register.
+ *
+ * Note that the usual caveats of pointer redirection apply. A master
+ * reading the value while the application is updating it, or the
+ * application reading the value while a master is part way through
+ * writing it, may see a torn value.
+ */
+
+#ifndef UCDM_VALUE_HPP
+#define UCDM_VALUE_HPP
+
+#include "ucdm.h"
+
+namespace ucdm {
+
+enum class WordOrder : uint8_t {
+    LittleEndian,
+    BigEndian,
+};
+
+namespace detail {
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+static constexpr bool host_little_endian = false;
+#else
+static constexpr bool host_little_endian = true;
+#endif
+
+}
+
+template <typename T, ucdm_addr_t ADDR, WordOrder ORDER = WordOrder::LittleEndian>
+class value {
+    static_assert(sizeof(T) % 2 == 0,
+                  "ucdm::value requires a type with a whole number of registers");
+    static_assert(sizeof(T) >= 2,
+                  "ucdm::value requires a type at least one register wide");
+    static_assert((unsigned long)ADDR + sizeof(T) / 2 <= UCDM_MAX_REGISTERS,
+                  "ucdm::value register range exceeds UCDM_MAX_REGISTERS");
+
+public:
+    /** \brief Address of the first register of the range. */
+    static constexpr ucdm_addr_t address = ADDR;
+
+    /** \brief Number of registers in the range. */
+    static constexpr uint8_t length = sizeof(T) / 2;
+
+    /**
+     * \brief Index into the variable of the word exposed at ADDR + offset.
+     */
+    static constexpr uint8_t word_index(uint8_t offset){
+        return ((ORDER == WordOrder::LittleEndian) == detail::host_little_endian)
+               ? offset : (length - 1 - offset);
+    }
+
+    value() : storage() {}
+    explicit value(T initial) : storage() { storage.v = initial; }
+
+    /**
+     * \brief Redirect register reads on the range to this variable.
+     *
+     * @return 0 for success, 1 for register out of range.
+     */
+    HAL_BASE_t bind_read(void){
+        for (uint8_t i = 0; i < length; i++){
+            if (ucdm_redirect_regr_ptr(ADDR + i, &storage.w[word_index(i)])){
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * \brief Redirect register writes on the range to this variable.
+     *
+     * @return 0 for success, 1 for register out of range.
+     */
+    HAL_BASE_t bind_write(void){
+        for (uint8_t i = 0; i < length; i++){
+            if (ucdm_redirect_regw_ptr(ADDR + i, &storage.w[word_index(i)])){
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * \brief Redirect both register reads and writes on the range to this variable.
+     *
+     * @return 0 for success, 1 for register out of range.
+     */
+    HAL_BASE_t bind(void){
+        return bind_read() | bind_write();
+    }
+
+    T get(void) const { return storage.v; }
+    void set(T v){ storage.v = v; }
+
+    operator T() const { return storage.v; }
+    value & operator=(T v){ storage.v = v; return *this; }
+
+    /**
+     * \brief The word exposed at register ADDR + OFFSET.
+     */
+    template <uint8_t OFFSET>
+    uint16_t word(void) const {
+        static_assert(OFFSET < length, "ucdm::value word offset out of range");
+        return storage.w[word_index(OFFSET)];
+    }
+
+    /** \brief Pointer to the underlying variable. */
+    T * ptr(void){ return &storage.v; }
+
+private:
+    union {
+        T v;
+        uint16_t w[sizeof(T) / 2];
+    } storage;
+};
+
+template <typename T, ucdm_addr_t ADDR, WordOrder ORDER>
+constexpr ucdm_addr_t value<T, ADDR, ORDER>::address;
+
+template <typename T, ucdm_addr_t ADDR, WordOrder ORDER>
+constexpr uint8_t value<T, ADDR, ORDER>::length;
+
+}
+
+#endif
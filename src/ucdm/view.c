@@ -0,0 +1,205 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file view.c
+ * @brief Scatter-gather virtual register views
+ *
+ */
+
+#include "view.h"
+
+#if UCDM_VIEW_ENABLE
+
+ucdm_view_t ucdm_views[UCDM_VIEW_MAX_COUNT];
+uint8_t ucdm_view_count;
+
+void _ucdm_view_init(void){
+    ucdm_view_count = 0;
+}
+
+static ucdm_view_t * _ucdm_view_find(ucdm_addr_t addr){
+    for (uint8_t i=0; i < ucdm_view_count; i++){
+        if (addr >= ucdm_views[i].saddr && addr < ucdm_views[i].saddr + ucdm_views[i].count){
+            return &ucdm_views[i];
+        }
+    }
+    return NULL;
+}
+
+static uint16_t _ucdm_view_resolve_read(uint32_t entry){
+    if (!(entry & UCDM_VIEW_ENTRY_BIT)){
+        return _ucdm_get_register(entry);
+    }
+    ucdm_addr_t addr;
+    uint16_t mask;
+    ucdm_get_bit_addr(entry & ~UCDM_VIEW_ENTRY_BIT, &addr, &mask);
+    if (!(ucdm_acctype[addr] & UCDM_AT_READ_MASK)){
+        return 0xFFFF;
+    }
+    return (_ucdm_get_register(addr) & mask) ? 1 : 0;
+}
+
+static HAL_BASE_t _ucdm_view_resolve_write(uint32_t entry, uint16_t value){
+    if (!(entry & UCDM_VIEW_ENTRY_BIT)){
+        return _ucdm_set_register(entry, value);
+    }
+    // Map bit write errors onto those of register writes
+    switch (_ucdm_write_bit(entry & ~UCDM_VIEW_ENTRY_BIT, value ? 1 : 0)){
+        case 0:
+            return 0;
+        case 4:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+static uint16_t _ucdm_view_read_word(ucdm_addr_t addr){
+    ucdm_view_t * view = _ucdm_view_find(addr);
+    if (!view){
+        return 0xFFFF;
+    }
+    return _ucdm_view_resolve_read(view->index[addr - view->saddr]);
+}
+
+static inline ucdm_view_t * _ucdm_view_window(ucdm_addr_t addr){
+    if ((ucdm_acctype[addr] & UCDM_AT_READ_MASK) != UCDM_AT_READ_FUNC ||
+            ucdm_register[addr].rfunc != &_ucdm_view_read_word){
+        return NULL;
+    }
+    return _ucdm_view_find(addr);
+}
+
+uint8_t _ucdm_view_read(ucdm_addr_t addr, uint8_t count, uint16_t * out){
+    // Read as much of the requested range as falls within the view window 
+    // containing addr, and return the number of registers read. Returns 0
+    // if addr is not part of a view window.
+    ucdm_view_t * view = _ucdm_view_window(addr);
+    if (!view){
+        return 0;
+    }
+    uint8_t offset = addr - view->saddr;
+    if (count > view->count - offset){
+        count = view->count - offset;
+    }
+    const uint32_t * entry = &view->index[offset];
+    for (uint8_t i=0; i < count; i++){
+        out[i] = _ucdm_view_resolve_read(entry[i]);
+    }
+    return count;
+}
+
+uint8_t _ucdm_view_write(ucdm_addr_t addr, uint8_t count, const uint16_t * values, HAL_BASE_t * rval){
+    // Write as much of the given range as falls within the view window 
+    // containing addr, stopping at the first error. Returns the number of 
+    // registers attempted, or 0 if addr is not part of a view window.
+    ucdm_view_t * view = _ucdm_view_window(addr);
+    if (!view){
+        return 0;
+    }
+    uint8_t offset = addr - view->saddr;
+    if (count > view->count - offset){
+        count = view->count - offset;
+    }
+    const uint32_t * entry = &view->index[offset];
+    *rval = 0;
+    for (uint8_t i=0; i < count; i++){
+        *rval = _ucdm_view_resolve_write(entry[i], values[i]);
+        if (*rval){
+            return i + 1;
+        }
+    }
+    return count;
+}
+
+static uint8_t _ucdm_view_entry_valid(uint32_t entry, ucdm_addr_t saddr, uint8_t count){
+    uint32_t addr = entry;
+    if (entry & UCDM_VIEW_ENTRY_BIT){
+        addr = entry & ~UCDM_VIEW_ENTRY_BIT;
+        if (addr >= UCDM_MAX_BITS){
+            return 0;
+        }
+        addr >>= 4;
+    }
+    if (addr >= UCDM_MAX_REGISTERS || _ucdm_view_find(addr) || 
+            (addr >= saddr && addr < (uint32_t)saddr + count)){
+        return 0;
+    }
+    return 1;
+}
+
+static uint8_t _ucdm_view_overlaps(ucdm_addr_t saddr, uint8_t count){
+    // Check whether the range overlaps the window of any installed view.
+    for (uint8_t v=0; v < ucdm_view_count; v++){
+        if ((uint32_t)saddr < (uint32_t)ucdm_views[v].saddr + ucdm_views[v].count && 
+                (uint32_t)ucdm_views[v].saddr < (uint32_t)saddr + count){
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static uint8_t _ucdm_view_referenced(ucdm_addr_t saddr, uint8_t count){
+    // Check whether any installed view refers to a register in the range.
+    for (uint8_t v=0; v < ucdm_view_count; v++){
+        for (uint8_t i=0; i < ucdm_views[v].count; i++){
+            uint32_t addr = ucdm_views[v].index[i];
+            if (addr & UCDM_VIEW_ENTRY_BIT){
+                addr = (addr & ~UCDM_VIEW_ENTRY_BIT) >> 4;
+            }
+            if (addr >= saddr && addr < (uint32_t)saddr + count){
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+HAL_BASE_t ucdm_install_view(ucdm_addr_t saddr, uint8_t count, const uint32_t * index){
+    if ((uint32_t)saddr + count > UCDM_MAX_REGISTERS){
+        return 1;
+    }
+    if (!count || _ucdm_view_overlaps(saddr, count) || 
+            _ucdm_view_referenced(saddr, count)){
+        return 2;
+    }
+    for (uint8_t i=0; i < count; i++){
+        if (!_ucdm_view_entry_valid(index[i], saddr, count)){
+            return 2;
+        }
+    }
+    if (ucdm_view_count >= UCDM_VIEW_MAX_COUNT){
+        return 3;
+    }
+    ucdm_view_t * view = &ucdm_views[ucdm_view_count++];
+    view->saddr = saddr;
+    view->count = count;
+    view->index = index;
+    for (uint8_t i=0; i < count; i++){
+        ucdm_redirect_regr_func(saddr + i, &_ucdm_view_read_word);
+        ucdm_acctype[saddr + i] |= UCDM_AT_REGW_TYPE_FUNC;
+        _ucdm_perm_update(saddr + i);
+    }
+    return 0;
+}
+
+#endif
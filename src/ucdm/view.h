@@ -0,0 +1,98 @@
+/* 
+   Copyright (c)
+     (c) 2026 Chintalagiri Shashank
+   
+   This file is part of
+   Embedded bootstraps : ucdm library
+   
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+*/
+
+/**
+ * @file view.h
+ * @brief Scatter-gather virtual register views
+ * 
+ * Masters often want a curated set of registers scattered across the 
+ * register map, such as the values shown on a dashboard. Reading them 
+ * one at a time costs a request per register. 
+ * 
+ * A view is a window of consecutive registers, each of which stands in 
+ * for a register or a bit elsewhere in the map. The mapping is given by an 
+ * index list, normally a const array built at compile time using 
+ * UCDM_VIEW_REG and UCDM_VIEW_BIT, with one entry per register of the 
+ * window. A master can then fetch or set the whole curated set with a 
+ * single multi-register request on the window. 
+ * 
+ * Reads through the window return the value of the register the entry 
+ * refers to, or 0 or 1 for a bit. Writes through the window are applied 
+ * to the register, or set the bit if the value written is non-zero and 
+ * clear it otherwise. Accesses through a view are subject to the access 
+ * permissions of the register they resolve to, and writes run the 
+ * post-write handlers and other processing of that register as usual. 
+ * Bulk accesses made with ucdm_get_registers and ucdm_set_registers 
+ * resolve the part of the requested range falling within the window in 
+ * a single pass over the index list. A bulk write through a view stops 
+ * at the first entry which can't be written. 
+ * 
+ * Window registers are readable and writable function registers as far 
+ * as the rest of UCDM is concerned. Entries may not refer to the window 
+ * of another view. Up to APP_UCDM_VIEW_MAX_COUNT views can be installed. 
+ * The index list is not copied, and must remain valid while the view is 
+ * installed. 
+ */
+
+#ifndef UCDM_VIEW_H
+#define UCDM_VIEW_H
+
+#include "ucdm.h"
+
+#if UCDM_VIEW_ENABLE
+
+/** Index list entry flag marking a bit address */
+#define UCDM_VIEW_ENTRY_BIT         0x80000000UL
+
+/** Index list entry standing in for a register */
+#define UCDM_VIEW_REG(addr)         ((uint32_t)(addr))
+/** Index list entry standing in for a bit */
+#define UCDM_VIEW_BIT(addrb)        ((uint32_t)(addrb) | UCDM_VIEW_ENTRY_BIT)
+
+typedef struct UCDM_VIEW_t{
+    ucdm_addr_t saddr;
+    uint8_t count;
+    const uint32_t * index;
+} ucdm_view_t;
+
+void _ucdm_view_init(void);
+
+uint8_t _ucdm_view_read(ucdm_addr_t addr, uint8_t count, uint16_t * out);
+
+uint8_t _ucdm_view_write(ucdm_addr_t addr, uint8_t count, const uint16_t * values, HAL_BASE_t * rval);
+
+/**
+ * \brief Install a view on a window of registers.
+ * 
+ * Any existing configuration of the window registers is replaced. The 
+ * window may not overlap the window of an installed view.
+ * 
+ * @param saddr Address/identifier of the first register of the window.
+ * @param count Number of registers in the window, and entries in the index.
+ * @param index Index list of registers and bits the window stands in for.
+ * @return 0 for success, 1 for window out of range, 2 for bad count, 
+ *         a bad index entry or a window overlapping another view, 3 if 
+ *         no free slots.
+ */
+HAL_BASE_t ucdm_install_view(ucdm_addr_t saddr, uint8_t count, const uint32_t * index);
+
+#endif
+#endif
@@ -21,4 +21,4 @@
 
 #ifndef APP_ENABLE_LIBVERSION_DESCRIPTORS
 #define APP_ENABLE_LIBVERSION_DESCRIPTORS   1  
-#endif
\ No newline at end of file
+#endif
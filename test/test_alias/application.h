@@ -0,0 +1,12 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_UCDM_ALIAS_MAX_COUNT
+#define APP_UCDM_ALIAS_MAX_COUNT            2
+#endif
+
+#ifndef APP_UCDM_MAX_HANDLERS
+#define APP_UCDM_MAX_HANDLERS               4
+#endif
+
+#include "../include/application.h"
@@ -0,0 +1,144 @@
+#include <unity.h>
+#include <string.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/alias.h>
+#include <ucdm/hpool.h>
+#include <scaffold.h>
+
+#define ADDR_CANON      0x10
+#define ADDR_ALIAS      0xA0
+#define ADDR_ALIAS2     0xB0
+#define ADDR_PLAIN      0x9F
+
+uint16_t ptr_target;
+
+uint8_t rwh_addr;
+uint8_t rwh_calls;
+uint8_t bwh_addr;
+uint16_t bwh_mask;
+
+void rwh(ucdm_addr_t addr){
+    rwh_addr = addr;
+    rwh_calls++;
+}
+
+void bwh(ucdm_addr_t addr, uint16_t mask){
+    bwh_addr = addr;
+    bwh_mask = mask;
+}
+
+void setup(void){
+    // ADDR_CANON     : normal, writable, bit writable, with handlers
+    // ADDR_CANON + 1 : pointer
+    // ADDR_CANON + 2 : normal, writable
+    // ADDR_CANON + 3 : normal, read only
+    ucdm_enable_regr(ADDR_CANON);
+    ucdm_enable_regw(ADDR_CANON);
+    ucdm_enable_bitw(ADDR_CANON);
+    ucdm_redirect_regr_ptr(ADDR_CANON + 1, &ptr_target);
+    ucdm_redirect_regw_ptr(ADDR_CANON + 1, &ptr_target);
+    ucdm_enable_regr(ADDR_CANON + 2);
+    ucdm_enable_regw(ADDR_CANON + 2);
+    ucdm_enable_regr(ADDR_CANON + 3);
+    ucdm_enable_regr(ADDR_PLAIN);
+    ucdm_enable_regw(ADDR_PLAIN);
+    ucdm_hpool_install_regw(ADDR_CANON, rwh);
+    ucdm_hpool_install_bitw(ADDR_CANON, bwh);
+}
+
+void test_alias_install(void){
+    TEST_ASSERT_EQUAL(0, ucdm_install_alias(ADDR_ALIAS, 4, ADDR_CANON));
+    // Out of range
+    TEST_ASSERT_EQUAL(1, ucdm_install_alias(UCDM_MAX_REGISTERS - 2, 4, 0x40));
+    TEST_ASSERT_EQUAL(1, ucdm_install_alias(0x40, 4, UCDM_MAX_REGISTERS - 2));
+    // Bad count, or overlapping its own canonical range
+    TEST_ASSERT_EQUAL(2, ucdm_install_alias(0x40, 0, 0x50));
+    TEST_ASSERT_EQUAL(2, ucdm_install_alias(0x40, 4, 0x42));
+    // Overlapping an installed alias range
+    TEST_ASSERT_EQUAL(2, ucdm_install_alias(ADDR_ALIAS + 3, 2, 0x40));
+    // Resolving onto an installed alias range
+    TEST_ASSERT_EQUAL(2, ucdm_install_alias(0x40, 2, ADDR_ALIAS + 1));
+    // Overlapping an installed canonical range
+    TEST_ASSERT_EQUAL(2, ucdm_install_alias(ADDR_CANON + 2, 2, 0x40));
+    // Canonical ranges can be shared.
+    TEST_ASSERT_EQUAL(0, ucdm_install_alias(ADDR_ALIAS2, 2, ADDR_CANON));
+    TEST_ASSERT_EQUAL(3, ucdm_install_alias(0x40, 2, 0x50));
+}
+
+void test_alias_register(void){
+    rwh_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_ALIAS, 0x1234));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, ucdm_get_register(ADDR_CANON));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, ucdm_get_register(ADDR_ALIAS2));
+    // Handlers follow the canonical register.
+    TEST_ASSERT_EQUAL_UINT8(1, rwh_calls);
+    TEST_ASSERT_EQUAL_UINT8(ADDR_CANON, rwh_addr);
+
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_ALIAS2, 0x4321));
+    TEST_ASSERT_EQUAL_HEX16(0x4321, ucdm_get_register(ADDR_ALIAS));
+    TEST_ASSERT_EQUAL_UINT8(2, rwh_calls);
+
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_ALIAS + 1, 0x5555));
+    TEST_ASSERT_EQUAL_HEX16(0x5555, ptr_target);
+    TEST_ASSERT_EQUAL(2, ucdm_set_register(ADDR_ALIAS + 3, 0x5555));
+
+    TEST_ASSERT_EQUAL_HEX16(0x5555, _ucdm_get_register(ADDR_ALIAS2 + 1));
+    TEST_ASSERT_EQUAL(0, _ucdm_set_register(ADDR_ALIAS2 + 1, 0x6666));
+    TEST_ASSERT_EQUAL_HEX16(0x6666, ptr_target);
+}
+
+void test_alias_bit(void){
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_CANON, 0x0000));
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_ALIAS << 4 | 5));
+    TEST_ASSERT_EQUAL_HEX16(1 << 5, ucdm_get_register(ADDR_CANON));
+    TEST_ASSERT_EQUAL_UINT8(ADDR_CANON, bwh_addr);
+    TEST_ASSERT_EQUAL_HEX16(1 << 5, bwh_mask);
+    TEST_ASSERT_TRUE(ucdm_get_bit(ADDR_ALIAS2 << 4 | 5));
+    TEST_ASSERT_FALSE(ucdm_get_bit(ADDR_ALIAS2 << 4 | 4));
+
+    TEST_ASSERT_EQUAL(0, ucdm_clear_bit(ADDR_ALIAS2 << 4 | 5));
+    TEST_ASSERT_EQUAL_HEX16(0, ucdm_get_register(ADDR_CANON));
+    TEST_ASSERT_EQUAL(0, _ucdm_write_bit(ADDR_ALIAS << 4 | 1, 1));
+    TEST_ASSERT_EQUAL_HEX16(1 << 1, ucdm_get_register(ADDR_CANON));
+}
+
+void test_alias_bulk(void){
+    uint16_t values[4] = {0x0101, 0x0202, 0x0303, 0x0404};
+    uint16_t target[4];
+
+    // The range spans an ordinary register and the alias.
+    TEST_ASSERT_EQUAL(0, ucdm_set_registers(ADDR_PLAIN, 4, values));
+    TEST_ASSERT_EQUAL_HEX16(0x0101, ucdm_get_register(ADDR_PLAIN));
+    TEST_ASSERT_EQUAL_HEX16(0x0202, ucdm_get_register(ADDR_CANON));
+    TEST_ASSERT_EQUAL_HEX16(0x0303, ptr_target);
+    TEST_ASSERT_EQUAL_HEX16(0x0404, ucdm_get_register(ADDR_CANON + 2));
+
+    TEST_ASSERT_EQUAL(0, ucdm_get_registers(ADDR_PLAIN, 4, target));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(values, target, 4);
+
+    // Writing stops at the read only canonical register.
+    TEST_ASSERT_EQUAL(2, ucdm_set_registers(ADDR_ALIAS + 2, 2, values));
+    TEST_ASSERT_EQUAL_HEX16(0x0101, ucdm_get_register(ADDR_CANON + 2));
+}
+
+void test_alias_range(void){
+    TEST_ASSERT_TRUE(ucdm_range_readable(ADDR_PLAIN, 5));
+    TEST_ASSERT_FALSE(ucdm_range_readable(ADDR_PLAIN, 6));
+    TEST_ASSERT_TRUE(ucdm_range_writable(ADDR_PLAIN, 4));
+    TEST_ASSERT_FALSE(ucdm_range_writable(ADDR_PLAIN, 5));
+    TEST_ASSERT_TRUE(ucdm_range_readable(ADDR_ALIAS2, 2));
+    TEST_ASSERT_TRUE(ucdm_range_bit_writable(ADDR_ALIAS << 4, 16));
+    TEST_ASSERT_FALSE(ucdm_range_bit_writable(ADDR_ALIAS << 4, 17));
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_alias_install);
+    RUN_TEST(test_alias_register);
+    RUN_TEST(test_alias_bit);
+    RUN_TEST(test_alias_bulk);
+    RUN_TEST(test_alias_range);
+    return UNITY_END();
+}
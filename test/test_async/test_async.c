@@ -0,0 +1,197 @@
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/async.h>
+#include <ucdm/alias.h>
+#include <scaffold.h>
+
+#define ADDR_AREAD      0x20
+#define ADDR_AWRITE     0x21
+#define ADDR_NORM       0x22
+#define ADDR_RO         0x23
+#define ADDR_ALIAS      0x40
+
+ucdm_async_token_t started;
+uint8_t start_calls;
+uint8_t immediate;
+uint16_t written;
+
+void aread_start(ucdm_addr_t addr, ucdm_async_token_t token){
+    start_calls++;
+    started = token;
+    if (immediate){
+        ucdm_async_complete(token, 0x55, 0);
+    }
+}
+
+void awrite_start(ucdm_addr_t addr, uint16_t value, ucdm_async_token_t token){
+    start_calls++;
+    started = token;
+    written = value;
+}
+
+uint8_t cb_calls;
+uint16_t cb_value;
+HAL_BASE_t cb_status;
+
+void done(ucdm_async_token_t token, ucdm_addr_t addr, uint16_t value, 
+          HAL_BASE_t status, void * ctx){
+    cb_calls++;
+    cb_value = value;
+    cb_status = status;
+    *(uint8_t *)ctx = 1;
+}
+
+uint8_t rwh_calls;
+
+void rwh_counting(ucdm_addr_t addr){
+    rwh_calls++;
+}
+
+avlt_node_t rwh_node;
+
+void setup(void){
+    TEST_ASSERT_EQUAL(0, ucdm_redirect_regr_async(ADDR_AREAD, aread_start));
+    TEST_ASSERT_EQUAL(0, ucdm_redirect_regw_async(ADDR_AWRITE, awrite_start));
+    ucdm_enable_regr(ADDR_NORM);
+    ucdm_enable_regw(ADDR_NORM);
+    ucdm_enable_regr(ADDR_RO);
+    ucdm_install_regw_handler(ADDR_AWRITE, &rwh_node, rwh_counting);
+    TEST_ASSERT_EQUAL(0, ucdm_install_alias(ADDR_ALIAS, 4, ADDR_AREAD));
+}
+
+void test_async_install(void){
+    TEST_ASSERT_EQUAL(1, ucdm_redirect_regr_async(UCDM_MAX_REGISTERS, aread_start));
+    TEST_ASSERT_EQUAL(2, ucdm_redirect_regr_async(0x30, aread_start));
+}
+
+void test_async_immediate(void){
+    uint16_t value = 0;
+    ucdm_async_token_t token = 0;
+    ucdm_register[ADDR_NORM].data = 0x1234;
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, ucdm_get_register_async(ADDR_NORM, &value, NULL, NULL, &token));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, value);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, ucdm_set_register_async(ADDR_NORM, 0x4321, NULL, NULL, &token));
+    TEST_ASSERT_EQUAL_HEX16(0x4321, ucdm_register[ADDR_NORM].data);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_REJECTED, ucdm_set_register_async(ADDR_RO, 1, NULL, NULL, &token));
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_REJECTED, ucdm_get_register_async(ADDR_AWRITE, &value, NULL, NULL, &token));
+    
+    // Start functions may complete the token before returning
+    immediate = 1;
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, ucdm_get_register_async(ADDR_AREAD, &value, done, NULL, &token));
+    TEST_ASSERT_EQUAL_HEX16(0x55, value);
+    TEST_ASSERT_EQUAL(0, cb_calls);
+    immediate = 0;
+}
+
+void test_async_callback(void){
+    uint16_t value = 0;
+    uint8_t flag = 0;
+    ucdm_async_token_t token = 0;
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_get_register_async(ADDR_AREAD, &value, done, &flag, &token));
+    TEST_ASSERT_NOT_EQUAL(0, token);
+    TEST_ASSERT_EQUAL(started, token);
+    TEST_ASSERT_EQUAL(0, cb_calls);
+    TEST_ASSERT_EQUAL(0, ucdm_async_complete(token, 0xBEEF, 0));
+    TEST_ASSERT_EQUAL(1, cb_calls);
+    TEST_ASSERT_EQUAL(1, flag);
+    TEST_ASSERT_EQUAL_HEX16(0xBEEF, cb_value);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, cb_status);
+    // Tokens complete only once
+    TEST_ASSERT_EQUAL(1, ucdm_async_complete(token, 0xBEEF, 0));
+    TEST_ASSERT_EQUAL(1, cb_calls);
+    
+    // Writes run the post-write handler on successful completion
+    rwh_calls = 0;
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_set_register_async(ADDR_AWRITE, 0x77, done, &flag, &token));
+    TEST_ASSERT_EQUAL_HEX16(0x77, written);
+    TEST_ASSERT_EQUAL(0, rwh_calls);
+    ucdm_async_complete(token, 0, 1);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_FAILED, cb_status);
+    TEST_ASSERT_EQUAL(0, rwh_calls);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_set_register_async(ADDR_AWRITE, 0x78, done, &flag, &token));
+    ucdm_async_complete(token, 0, 0);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, cb_status);
+    TEST_ASSERT_EQUAL(1, rwh_calls);
+}
+
+void test_async_poll(void){
+    uint16_t value = 0;
+    ucdm_async_token_t t1, t2, t3, t4;
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_get_register_async(ADDR_AREAD, &value, NULL, NULL, &t1));
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_get_register_async(ADDR_AREAD, &value, NULL, NULL, &t2));
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_BUSY, ucdm_get_register_async(ADDR_AREAD, &value, NULL, NULL, &t3));
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_async_poll(t1, &value));
+    ucdm_async_complete(t1, 0x1111, 0);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, ucdm_async_poll(t1, &value));
+    TEST_ASSERT_EQUAL_HEX16(0x1111, value);
+    // Released once the result is collected
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_REJECTED, ucdm_async_poll(t1, &value));
+    
+    // Cancelled tokens are not completed, even when their slot is reused
+    TEST_ASSERT_EQUAL(0, ucdm_async_cancel(t2));
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_get_register_async(ADDR_AREAD, &value, NULL, NULL, &t3));
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_get_register_async(ADDR_AREAD, &value, NULL, NULL, &t4));
+    TEST_ASSERT_EQUAL(t2 & 0xFF, t4 & 0xFF);
+    TEST_ASSERT_EQUAL(1, ucdm_async_complete(t2, 0x2222, 0));
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_async_poll(t4, &value));
+    ucdm_async_cancel(t3);
+    ucdm_async_cancel(t4);
+}
+
+void test_async_sync_access(void){
+    // Synchronous reads return the last completed value and refresh it
+    // in the background.
+    start_calls = 0;
+    TEST_ASSERT_EQUAL_HEX16(0x1111, ucdm_get_register(ADDR_AREAD));
+    TEST_ASSERT_EQUAL(1, start_calls);
+    TEST_ASSERT_EQUAL_HEX16(0x1111, ucdm_get_register(ADDR_AREAD));
+    TEST_ASSERT_EQUAL(1, start_calls);
+    ucdm_async_complete(started, 0x3333, 0);
+    TEST_ASSERT_EQUAL_HEX16(0x3333, ucdm_get_register(ADDR_AREAD));
+    TEST_ASSERT_EQUAL(2, start_calls);
+    ucdm_async_complete(started, 0x3333, 0);
+    
+    // Synchronous writes start the write and return
+    rwh_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_AWRITE, 0x99));
+    TEST_ASSERT_EQUAL_HEX16(0x99, written);
+    TEST_ASSERT_EQUAL(1, rwh_calls);
+    ucdm_async_complete(started, 0, 0);
+    TEST_ASSERT_EQUAL(1, rwh_calls);
+}
+
+void test_async_alias(void){
+    // Aliases of async registers start the operation on the canonical register
+    uint16_t value = 0;
+    ucdm_async_token_t token = 0;
+    start_calls = 0;
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_get_register_async(ADDR_ALIAS, &value, NULL, NULL, &token));
+    TEST_ASSERT_EQUAL(1, start_calls);
+    ucdm_async_complete(token, 0x4444, 0);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, ucdm_async_poll(token, &value));
+    TEST_ASSERT_EQUAL_HEX16(0x4444, value);
+    
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_PENDING, ucdm_set_register_async(ADDR_ALIAS + 1, 0x66, NULL, NULL, &token));
+    TEST_ASSERT_EQUAL(2, start_calls);
+    TEST_ASSERT_EQUAL_HEX16(0x66, written);
+    ucdm_async_complete(token, 0, 0);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, ucdm_async_poll(token, &value));
+    
+    ucdm_register[ADDR_NORM].data = 0x1234;
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, ucdm_get_register_async(ADDR_ALIAS + 2, &value, NULL, NULL, &token));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, value);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_REJECTED, ucdm_set_register_async(ADDR_ALIAS + 3, 1, NULL, NULL, &token));
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_async_install);
+    RUN_TEST(test_async_immediate);
+    RUN_TEST(test_async_callback);
+    RUN_TEST(test_async_poll);
+    RUN_TEST(test_async_sync_access);
+    RUN_TEST(test_async_alias);
+    return UNITY_END();
+}
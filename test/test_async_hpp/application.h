@@ -0,0 +1,12 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_UCDM_ASYNC_MAX_COUNT
+#define APP_UCDM_ASYNC_MAX_COUNT            2
+#endif
+
+#ifndef APP_UCDM_ASYNC_MAX_PENDING
+#define APP_UCDM_ASYNC_MAX_PENDING          2
+#endif
+
+#include "../include/application.h"
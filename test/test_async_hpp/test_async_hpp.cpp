@@ -0,0 +1,119 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/async.hpp>
+#include <scaffold.h>
+
+#if __cplusplus >= 202002L
+
+#define ADDR_AREAD      0x20
+#define ADDR_AWRITE     0x21
+#define ADDR_NORM       0x22
+
+// Minimal eagerly started coroutine type, which runs to completion 
+// without being awaited itself.
+struct task {
+    struct promise_type {
+        task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {}
+    };
+};
+
+ucdm_async_token_t started;
+uint16_t written;
+
+void aread_start(ucdm_addr_t addr, ucdm_async_token_t token){
+    started = token;
+}
+
+void awrite_start(ucdm_addr_t addr, uint16_t value, ucdm_async_token_t token){
+    started = token;
+    written = value;
+}
+
+uint8_t done;
+ucdm::async_result result;
+
+task do_read(ucdm_addr_t addr){
+    result = co_await ucdm::async_read(addr);
+    done = 1;
+}
+
+task do_write(ucdm_addr_t addr, uint16_t value){
+    result = co_await ucdm::async_write(addr, value);
+    done = 1;
+}
+
+void setup(void){
+    TEST_ASSERT_EQUAL(0, ucdm_redirect_regr_async(ADDR_AREAD, aread_start));
+    TEST_ASSERT_EQUAL(0, ucdm_redirect_regw_async(ADDR_AWRITE, awrite_start));
+    ucdm_enable_regr(ADDR_NORM);
+    ucdm_enable_regw(ADDR_NORM);
+}
+
+void test_async_hpp_immediate(void){
+    // Accesses which complete immediately do not suspend
+    ucdm_register[ADDR_NORM].data = 0x1234;
+    done = 0;
+    do_read(ADDR_NORM);
+    TEST_ASSERT_EQUAL(1, done);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, result.status);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, result.value);
+    
+    done = 0;
+    do_write(ADDR_NORM, 0x4321);
+    TEST_ASSERT_EQUAL(1, done);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, result.status);
+    TEST_ASSERT_EQUAL_HEX16(0x4321, ucdm_register[ADDR_NORM].data);
+    
+    done = 0;
+    do_read(ADDR_AWRITE);
+    TEST_ASSERT_EQUAL(1, done);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_REJECTED, result.status);
+}
+
+void test_async_hpp_suspend(void){
+    // Pending accesses resume the coroutine on completion
+    done = 0;
+    do_read(ADDR_AREAD);
+    TEST_ASSERT_EQUAL(0, done);
+    TEST_ASSERT_EQUAL(0, ucdm_async_complete(started, 0xBEEF, 0));
+    TEST_ASSERT_EQUAL(1, done);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_OK, result.status);
+    TEST_ASSERT_EQUAL_HEX16(0xBEEF, result.value);
+    
+    done = 0;
+    do_write(ADDR_AWRITE, 0x77);
+    TEST_ASSERT_EQUAL(0, done);
+    TEST_ASSERT_EQUAL_HEX16(0x77, written);
+    TEST_ASSERT_EQUAL(0, ucdm_async_complete(started, 0, 1));
+    TEST_ASSERT_EQUAL(1, done);
+    TEST_ASSERT_EQUAL(UCDM_ASYNC_FAILED, result.status);
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_async_hpp_immediate);
+    RUN_TEST(test_async_hpp_suspend);
+    return UNITY_END();
+}
+
+#else
+
+void test_async_hpp_unavailable(void){
+    TEST_IGNORE_MESSAGE("ucdm/async.hpp requires C++20");
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    RUN_TEST(test_async_hpp_unavailable);
+    return UNITY_END();
+}
+
+#endif
@@ -0,0 +1,8 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_UCDM_BLOCK_MAX_COUNT
+#define APP_UCDM_BLOCK_MAX_COUNT            2
+#endif
+
+#include "../include/application.h"
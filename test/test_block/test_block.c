@@ -0,0 +1,165 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/block.h>
+#include <scaffold.h>
+
+#define ADDR_BLOCK      0x40
+#define BLOCK_COUNT     6
+#define ADDR_WBLOCK     0x48
+#define WBLOCK_COUNT    4
+
+uint16_t status[BLOCK_COUNT] = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15};
+uint8_t rfunc_calls;
+uint8_t last_offset;
+uint8_t last_count;
+
+void rfunc_status(ucdm_addr_t saddr, uint8_t offset, uint8_t count, uint16_t * out){
+    rfunc_calls++;
+    last_offset = offset;
+    last_count = count;
+    for (uint8_t i=0; i < count; i++){
+        out[i] = status[offset + i];
+    }
+}
+
+uint16_t config[WBLOCK_COUNT];
+uint8_t wfunc_calls;
+
+void wfunc_config(ucdm_addr_t saddr, uint8_t offset, uint8_t count, const uint16_t * values){
+    wfunc_calls++;
+    last_offset = offset;
+    last_count = count;
+    for (uint8_t i=0; i < count; i++){
+        config[offset + i] = values[i];
+    }
+}
+
+uint8_t rwh_calls;
+
+void rwh_counting(ucdm_addr_t addr){
+    rwh_calls++;
+}
+
+avlt_node_t rwh_node;
+
+void setup(void){
+    ucdm_enable_regr(ADDR_BLOCK - 1);
+    ucdm_register[ADDR_BLOCK - 1].data = 0xAA;
+    ucdm_enable_regr(ADDR_BLOCK + BLOCK_COUNT);
+    ucdm_register[ADDR_BLOCK + BLOCK_COUNT].data = 0xBB;
+    TEST_ASSERT_EQUAL(0, ucdm_redirect_block_rfunc(ADDR_BLOCK, BLOCK_COUNT, rfunc_status));
+    TEST_ASSERT_EQUAL(0, ucdm_redirect_block_wfunc(ADDR_WBLOCK, WBLOCK_COUNT, wfunc_config));
+    ucdm_install_regw_handler(ADDR_WBLOCK + 1, &rwh_node, rwh_counting);
+}
+
+void test_block_install(void){
+    TEST_ASSERT_EQUAL(2, ucdm_redirect_block_rfunc(0x50, 0, rfunc_status));
+    TEST_ASSERT_EQUAL(1, ucdm_redirect_block_rfunc(UCDM_MAX_REGISTERS - 2, 3, rfunc_status));
+    TEST_ASSERT_EQUAL(3, ucdm_redirect_block_wfunc(0x60, 2, wfunc_config));
+    // Blocks of the same type may not overlap
+    TEST_ASSERT_EQUAL(4, ucdm_redirect_block_rfunc(ADDR_BLOCK + BLOCK_COUNT - 1, 2, rfunc_status));
+    TEST_ASSERT_EQUAL(4, ucdm_redirect_block_rfunc(ADDR_BLOCK - 1, 2, rfunc_status));
+    TEST_ASSERT_EQUAL(4, ucdm_redirect_block_wfunc(ADDR_WBLOCK + 1, 1, wfunc_config));
+    TEST_ASSERT_EQUAL_HEX16(0xAA, ucdm_get_register(ADDR_BLOCK - 1));
+}
+
+void test_block_single(void){
+    rfunc_calls = 0;
+    TEST_ASSERT_EQUAL_HEX16(0x13, ucdm_get_register(ADDR_BLOCK + 3));
+    TEST_ASSERT_EQUAL(1, rfunc_calls);
+    TEST_ASSERT_EQUAL(3, last_offset);
+    TEST_ASSERT_EQUAL(1, last_count);
+}
+
+void test_block_bulk(void){
+    uint16_t values[BLOCK_COUNT];
+    rfunc_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_get_registers(ADDR_BLOCK, BLOCK_COUNT, values));
+    TEST_ASSERT_EQUAL(1, rfunc_calls);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(status, values, BLOCK_COUNT);
+}
+
+void test_block_bulk_subrange(void){
+    uint16_t values[3];
+    rfunc_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_get_registers(ADDR_BLOCK + 2, 3, values));
+    TEST_ASSERT_EQUAL(1, rfunc_calls);
+    TEST_ASSERT_EQUAL(2, last_offset);
+    TEST_ASSERT_EQUAL(3, last_count);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(&status[2], values, 3);
+}
+
+void test_block_bulk_straddle(void){
+    uint16_t values[BLOCK_COUNT + 2];
+    rfunc_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_get_registers(ADDR_BLOCK - 1, BLOCK_COUNT + 2, values));
+    TEST_ASSERT_EQUAL(1, rfunc_calls);
+    TEST_ASSERT_EQUAL_HEX16(0xAA, values[0]);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(status, &values[1], BLOCK_COUNT);
+    TEST_ASSERT_EQUAL_HEX16(0xBB, values[BLOCK_COUNT + 1]);
+}
+
+void test_block_bulk_range(void){
+    uint16_t values[4];
+    TEST_ASSERT_EQUAL(1, ucdm_get_registers(UCDM_MAX_REGISTERS - 2, 4, values));
+}
+
+void test_block_write_single(void){
+    wfunc_calls = 0;
+    rwh_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_WBLOCK + 2, 0x1234));
+    TEST_ASSERT_EQUAL(1, wfunc_calls);
+    TEST_ASSERT_EQUAL(2, last_offset);
+    TEST_ASSERT_EQUAL(1, last_count);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, config[2]);
+    TEST_ASSERT_EQUAL(0, rwh_calls);
+}
+
+void test_block_write_bulk(void){
+    uint16_t values[WBLOCK_COUNT] = {0x21, 0x22, 0x23, 0x24};
+    wfunc_calls = 0;
+    rwh_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_set_registers(ADDR_WBLOCK, WBLOCK_COUNT, values));
+    TEST_ASSERT_EQUAL(1, wfunc_calls);
+    TEST_ASSERT_EQUAL(0, last_offset);
+    TEST_ASSERT_EQUAL(WBLOCK_COUNT, last_count);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(values, config, WBLOCK_COUNT);
+    // Post-write handlers run for block registers too
+    TEST_ASSERT_EQUAL(1, rwh_calls);
+}
+
+void test_block_write_straddle(void){
+    uint16_t values[3] = {0x31, 0x32, 0x33};
+    wfunc_calls = 0;
+    ucdm_enable_regw(ADDR_WBLOCK + WBLOCK_COUNT);
+    TEST_ASSERT_EQUAL(0, ucdm_set_registers(ADDR_WBLOCK + 2, 3, values));
+    TEST_ASSERT_EQUAL(1, wfunc_calls);
+    TEST_ASSERT_EQUAL(2, last_offset);
+    TEST_ASSERT_EQUAL(2, last_count);
+    TEST_ASSERT_EQUAL_HEX16(0x33, ucdm_register[ADDR_WBLOCK + WBLOCK_COUNT].data);
+}
+
+void test_block_write_error(void){
+    uint16_t values[2] = {0x41, 0x42};
+    TEST_ASSERT_EQUAL(1, ucdm_set_registers(UCDM_MAX_REGISTERS - 1, 2, values));
+    // Read-only registers stop the write
+    TEST_ASSERT_EQUAL(2, ucdm_set_registers(ADDR_BLOCK, 2, values));
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_block_install);
+    RUN_TEST(test_block_single);
+    RUN_TEST(test_block_bulk);
+    RUN_TEST(test_block_bulk_subrange);
+    RUN_TEST(test_block_bulk_straddle);
+    RUN_TEST(test_block_bulk_range);
+    RUN_TEST(test_block_write_single);
+    RUN_TEST(test_block_write_bulk);
+    RUN_TEST(test_block_write_straddle);
+    RUN_TEST(test_block_write_error);
+    return UNITY_END();
+}
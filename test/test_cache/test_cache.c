@@ -0,0 +1,80 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/cache.h>
+#include <scaffold.h>
+
+#define ADDR_CACHED     0x30
+#define ADDR_UNCACHED   0x31
+
+ucdm_tick_t fake_tick;
+uint16_t rfunc_calls;
+
+ucdm_tick_t fake_tick_source(void){
+    return fake_tick;
+}
+
+uint16_t rfunc_counting(ucdm_addr_t addr){
+    return ++rfunc_calls;
+}
+
+void setup(void){
+    ucdm_install_tick_source(fake_tick_source);
+    ucdm_redirect_regr_func(ADDR_CACHED, rfunc_counting);
+    ucdm_redirect_regr_func(ADDR_UNCACHED, rfunc_counting);
+    TEST_ASSERT_EQUAL(0, ucdm_cache_install(ADDR_CACHED, 100));
+}
+
+void test_cache_install(void){
+    TEST_ASSERT_EQUAL(1, ucdm_cache_install(UCDM_MAX_REGISTERS, 10));
+    TEST_ASSERT_EQUAL(0, ucdm_cache_install(0x32, 10));
+    TEST_ASSERT_EQUAL(2, ucdm_cache_install(0x33, 10));
+    // Reinstalling an existing register does not use a slot
+    TEST_ASSERT_EQUAL(0, ucdm_cache_install(0x32, 20));
+}
+
+void test_cache_ttl(void){
+    rfunc_calls = 0;
+    ucdm_cache_reset_stats();
+    TEST_ASSERT_EQUAL(1, ucdm_get_register(ADDR_CACHED));
+    fake_tick += 50;
+    TEST_ASSERT_EQUAL(1, ucdm_get_register(ADDR_CACHED));
+    fake_tick += 49;
+    TEST_ASSERT_EQUAL(1, ucdm_get_register(ADDR_CACHED));
+    fake_tick += 1;
+    TEST_ASSERT_EQUAL(2, ucdm_get_register(ADDR_CACHED));
+    TEST_ASSERT_EQUAL(2, rfunc_calls);
+    TEST_ASSERT_EQUAL(2, ucdm_cache_hits);
+    TEST_ASSERT_EQUAL(2, ucdm_cache_misses);
+}
+
+void test_cache_uncached(void){
+    rfunc_calls = 0;
+    ucdm_cache_reset_stats();
+    TEST_ASSERT_EQUAL(1, ucdm_get_register(ADDR_UNCACHED));
+    TEST_ASSERT_EQUAL(2, ucdm_get_register(ADDR_UNCACHED));
+    TEST_ASSERT_EQUAL(0, ucdm_cache_hits);
+    TEST_ASSERT_EQUAL(0, ucdm_cache_misses);
+}
+
+void test_cache_invalidate(void){
+    rfunc_calls = 0;
+    ucdm_cache_invalidate(ADDR_CACHED);
+    TEST_ASSERT_EQUAL(1, ucdm_get_register(ADDR_CACHED));
+    TEST_ASSERT_EQUAL(1, ucdm_get_register(ADDR_CACHED));
+    ucdm_cache_invalidate(ADDR_CACHED);
+    TEST_ASSERT_EQUAL(2, ucdm_get_register(ADDR_CACHED));
+    ucdm_cache_invalidate_all();
+    TEST_ASSERT_EQUAL(3, ucdm_get_register(ADDR_CACHED));
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_cache_install);
+    RUN_TEST(test_cache_ttl);
+    RUN_TEST(test_cache_uncached);
+    RUN_TEST(test_cache_invalidate);
+    return UNITY_END();
+}
@@ -0,0 +1,25 @@
+
+// Configuration local to this test, on top of the common test configuration.
+// The register map of this test is a const table defined in the test.
+
+#ifndef APP_UCDM_MAX_REGISTERS
+#define APP_UCDM_MAX_REGISTERS              8
+#endif
+
+#ifndef APP_ENABLE_UCDM_CONST_CONFIG
+#define APP_ENABLE_UCDM_CONST_CONFIG        1
+#endif
+
+#ifndef APP_UCDM_CONST_DATA_COUNT
+#define APP_UCDM_CONST_DATA_COUNT           3
+#endif
+
+#ifndef APP_ENABLE_UCDM_PERM_BITMAPS
+#define APP_ENABLE_UCDM_PERM_BITMAPS        1
+#endif
+
+#ifndef APP_UCDM_MAX_HANDLERS
+#define APP_UCDM_MAX_HANDLERS               2
+#endif
+
+#include "../include/application.h"
@@ -0,0 +1,173 @@
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/hpool.h>
+#include <scaffold.h>
+
+#define ADDR_NORM       0
+#define ADDR_RO         1
+#define ADDR_PTR        2
+#define ADDR_RFUNC      3
+#define ADDR_WFUNC      4
+#define ADDR_NONE       5
+#define ADDR_PLAIN      6
+#define ADDR_PTR_RO     7
+
+uint16_t ptr_target = 0x1111;
+uint16_t ptr_ro_target = 0x2222;
+uint16_t wfunc_value;
+
+uint16_t rfunc_addr(ucdm_addr_t addr){
+    return 0x100 + addr;
+}
+
+void wfunc_store(ucdm_addr_t addr, uint16_t value){
+    wfunc_value = value;
+}
+
+const ucdm_acctype_t ucdm_acctype[UCDM_MAX_REGISTERS] = {
+    UCDM_AT_READ_NORM | UCDM_AT_REGW_TYPE_NORMAL | UCDM_AT_BITW_WE_HF | UCDM_AT_REGW_HF,
+    UCDM_AT_READ_NORM,
+    UCDM_AT_READ_PTR | UCDM_AT_REGW_TYPE_PTR,
+    UCDM_AT_READ_FUNC,
+    UCDM_AT_REGW_TYPE_FUNC,
+    0,
+    UCDM_AT_READ_NORM | UCDM_AT_REGW_TYPE_NORMAL,
+    UCDM_AT_READ_PTR,
+};
+
+const ucdm_register_t ucdm_register[UCDM_MAX_REGISTERS] = {
+    UCDM_CONST_DATA(0),
+    UCDM_CONST_DATA(1),
+    UCDM_CONST_PTR(&ptr_target),
+    UCDM_CONST_RFUNC(rfunc_addr),
+    UCDM_CONST_WFUNC(wfunc_store),
+    UCDM_CONST_NONE,
+    UCDM_CONST_DATA(2),
+    UCDM_CONST_PTR(&ptr_ro_target),
+};
+
+uint8_t rwh_calls;
+uint8_t pool_calls;
+uint8_t bwh_calls;
+uint16_t bwh_mask;
+
+void rwh_counting(ucdm_addr_t addr){
+    rwh_calls++;
+}
+
+void rwh_pool(ucdm_addr_t addr){
+    pool_calls++;
+}
+
+void bwh_counting(ucdm_addr_t addr, uint16_t mask){
+    bwh_calls++;
+    bwh_mask = mask;
+}
+
+avlt_node_t rwh_node;
+avlt_node_t bwh_node;
+avlt_node_t plain_node;
+
+void test_const_norm(void){
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_NORM, 0x1234));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, ucdm_data[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, ucdm_get_register(ADDR_NORM));
+    
+    // Read only registers are updated by the application through ucdm_data
+    TEST_ASSERT_EQUAL(2, ucdm_set_register(ADDR_RO, 0x5555));
+    ucdm_data[1] = 0x4321;
+    TEST_ASSERT_EQUAL_HEX16(0x4321, ucdm_get_register(ADDR_RO));
+    
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_PLAIN, 0x6666));
+    TEST_ASSERT_EQUAL_HEX16(0x6666, ucdm_data[2]);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, ucdm_data[0]);
+    
+    TEST_ASSERT_EQUAL(2, ucdm_set_register(ADDR_NONE, 1));
+    TEST_ASSERT_EQUAL(1, ucdm_set_register(UCDM_MAX_REGISTERS, 1));
+}
+
+void test_const_redirect(void){
+    TEST_ASSERT_EQUAL_HEX16(0x1111, ucdm_get_register(ADDR_PTR));
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_PTR, 0x3333));
+    TEST_ASSERT_EQUAL_HEX16(0x3333, ptr_target);
+    TEST_ASSERT_EQUAL_HEX16(0x2222, ucdm_get_register(ADDR_PTR_RO));
+    TEST_ASSERT_EQUAL(2, ucdm_set_register(ADDR_PTR_RO, 0x4444));
+    TEST_ASSERT_EQUAL_HEX16(0x2222, ptr_ro_target);
+    
+    TEST_ASSERT_EQUAL_HEX16(0x103, ucdm_get_register(ADDR_RFUNC));
+    TEST_ASSERT_EQUAL(2, ucdm_set_register(ADDR_RFUNC, 1));
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_WFUNC, 0x7777));
+    TEST_ASSERT_EQUAL_HEX16(0x7777, wfunc_value);
+}
+
+void test_const_bits(void){
+    ucdm_data[0] = 0x0000;
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_NORM << 4 | 3));
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_NORM << 4 | 15));
+    TEST_ASSERT_EQUAL_HEX16(0x8008, ucdm_data[0]);
+    TEST_ASSERT_EQUAL(0, ucdm_clear_bit(ADDR_NORM << 4 | 3));
+    TEST_ASSERT_EQUAL_HEX16(0x8000, ucdm_data[0]);
+    
+    ucdm_data[2] = 0x0000;
+    TEST_ASSERT_EQUAL(2, ucdm_set_bit(ADDR_PLAIN << 4 | 1));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, ucdm_data[2]);
+}
+
+void test_const_handlers(void){
+    TEST_ASSERT_EQUAL(0, ucdm_install_regw_handler(ADDR_NORM, &rwh_node, rwh_counting));
+    TEST_ASSERT_EQUAL(0, ucdm_install_bitw_handler(ADDR_NORM, &bwh_node, bwh_counting));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_NORM, rwh_pool));
+    
+    rwh_calls = 0;
+    pool_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_NORM, 0x0101));
+    TEST_ASSERT_EQUAL(1, rwh_calls);
+    TEST_ASSERT_EQUAL(1, pool_calls);
+    
+    bwh_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_NORM << 4 | 4));
+    TEST_ASSERT_EQUAL(1, bwh_calls);
+    TEST_ASSERT_EQUAL_HEX16(1 << 4, bwh_mask);
+    
+    // The handler flags can't be changed, so handlers on registers 
+    // without the flag set in the table are never called.
+    TEST_ASSERT_EQUAL(0, ucdm_install_regw_handler(ADDR_PLAIN, &plain_node, rwh_counting));
+    rwh_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_PLAIN, 0x0202));
+    TEST_ASSERT_EQUAL(0, rwh_calls);
+    
+    // Removing pool handlers leaves the flags in the table alone
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_regw(ADDR_NORM));
+    TEST_ASSERT_TRUE(ucdm_acctype[ADDR_NORM] & UCDM_AT_REGW_HF);
+    rwh_calls = 0;
+    pool_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_NORM, 0x0303));
+    TEST_ASSERT_EQUAL(1, rwh_calls);
+    TEST_ASSERT_EQUAL(0, pool_calls);
+}
+
+void test_const_ranges(void){
+    TEST_ASSERT_EQUAL(1, ucdm_range_readable(ADDR_NORM, 4));
+    TEST_ASSERT_EQUAL(0, ucdm_range_readable(ADDR_NORM, 5));
+    TEST_ASSERT_EQUAL(1, ucdm_range_readable(ADDR_PLAIN, 2));
+    TEST_ASSERT_EQUAL(0, ucdm_range_readable(ADDR_PLAIN, 3));
+    TEST_ASSERT_EQUAL(1, ucdm_range_writable(ADDR_NORM, 1));
+    TEST_ASSERT_EQUAL(0, ucdm_range_writable(ADDR_NORM, 2));
+    TEST_ASSERT_EQUAL(1, ucdm_range_writable(ADDR_PTR, 1));
+    TEST_ASSERT_EQUAL(0, ucdm_range_writable(ADDR_PTR, 2));
+    TEST_ASSERT_EQUAL(1, ucdm_range_writable(ADDR_WFUNC, 1));
+    TEST_ASSERT_EQUAL(0, ucdm_range_writable(ADDR_PLAIN, 2));
+    TEST_ASSERT_EQUAL(1, ucdm_range_bit_writable(ADDR_NORM << 4, 16));
+    TEST_ASSERT_EQUAL(0, ucdm_range_bit_writable(ADDR_NORM << 4, 17));
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    RUN_TEST(test_const_norm);
+    RUN_TEST(test_const_redirect);
+    RUN_TEST(test_const_bits);
+    RUN_TEST(test_const_handlers);
+    RUN_TEST(test_const_ranges);
+    return UNITY_END();
+}
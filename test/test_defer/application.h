@@ -0,0 +1,20 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_UCDM_HANDLER_BUDGET
+#define APP_UCDM_HANDLER_BUDGET             500
+#endif
+
+#ifndef APP_UCDM_DEFER_RECOVERY
+#define APP_UCDM_DEFER_RECOVERY             2
+#endif
+
+#ifndef APP_UCDM_DEFER_POLL_BUDGET
+#define APP_UCDM_DEFER_POLL_BUDGET          5000
+#endif
+
+#ifndef APP_UCDM_MAX_HANDLERS
+#define APP_UCDM_MAX_HANDLERS               2
+#endif
+
+#include "../include/application.h"
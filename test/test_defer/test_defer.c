@@ -0,0 +1,262 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/defer.h>
+#include <ucdm/hpool.h>
+#include <scaffold.h>
+
+#define ADDR_RW         0x20
+#define ADDR_BW         0x21
+#define ADDR_HI         0x22
+#define ADDR_POOL       0x23
+#define ADDR_BADPRIO    0x24
+#define ADDR_REMOVER    0x25
+
+ucdm_tick_t fake_tick;
+ucdm_tick_t rwh_duration;
+uint8_t rwh_calls;
+uint8_t bwh_calls;
+uint16_t bwh_mask;
+
+ucdm_tick_t fake_tick_source(void){
+    return fake_tick;
+}
+
+uint8_t order[8];
+uint8_t norder;
+
+void rwh_variable(ucdm_addr_t addr){
+    fake_tick += rwh_duration;
+    rwh_calls++;
+    order[norder++ & 7] = addr;
+}
+
+void rwh_urgent(ucdm_addr_t addr){
+    fake_tick += APP_UCDM_HANDLER_BUDGET + 1;
+    order[norder++ & 7] = addr;
+}
+
+void bwh_slow(ucdm_addr_t addr, uint16_t mask){
+    fake_tick += APP_UCDM_HANDLER_BUDGET + 1;
+    bwh_calls++;
+    bwh_mask = mask;
+}
+
+uint8_t pool_a_calls;
+uint8_t pool_b_calls;
+
+void rwh_pool_a(ucdm_addr_t addr){
+    fake_tick += APP_UCDM_HANDLER_BUDGET + 1;
+    pool_a_calls++;
+}
+
+void rwh_pool_b(ucdm_addr_t addr){
+    pool_b_calls++;
+}
+
+uint8_t remover_armed;
+
+void rwh_remover(ucdm_addr_t addr){
+    fake_tick += APP_UCDM_HANDLER_BUDGET + 1;
+    if (remover_armed){
+        ucdm_hpool_remove_regw(ADDR_POOL, rwh_pool_a);
+    }
+}
+
+avlt_node_t rw_node, bw_node, hi_node, badprio_node, remover_node;
+
+void setup(void){
+    ucdm_install_tick_source(fake_tick_source);
+    ucdm_enable_regw(ADDR_RW);
+    ucdm_enable_regw(ADDR_BW);
+    ucdm_enable_bitw(ADDR_BW);
+    ucdm_install_regw_handler(ADDR_RW, &rw_node, rwh_variable);
+    ucdm_install_bitw_handler(ADDR_BW, &bw_node, bwh_slow);
+    ucdm_enable_regw(ADDR_HI);
+    ucdm_install_regw_handler_prio(ADDR_HI, &hi_node, rwh_urgent, 2);
+    ucdm_enable_regw(ADDR_POOL);
+}
+
+void test_defer_fast_inline(void){
+    rwh_calls = 0;
+    rwh_duration = 10;
+    ucdm_set_register(ADDR_RW, 1);
+    TEST_ASSERT_EQUAL(1, rwh_calls);
+    TEST_ASSERT_EQUAL(0, ucdm_defer_is_deferred((void *)rwh_variable));
+    TEST_ASSERT_EQUAL(0, ucdm_defer_pending());
+}
+
+void test_defer_slow_deferred(void){
+    rwh_calls = 0;
+    rwh_duration = APP_UCDM_HANDLER_BUDGET + 1;
+    // Executed inline, found to be over budget
+    ucdm_set_register(ADDR_RW, 1);
+    TEST_ASSERT_EQUAL(1, rwh_calls);
+    TEST_ASSERT_EQUAL(1, ucdm_defer_is_deferred((void *)rwh_variable));
+    
+    ucdm_set_register(ADDR_RW, 2);
+    ucdm_set_register(ADDR_RW, 3);
+    TEST_ASSERT_EQUAL(1, rwh_calls);
+    TEST_ASSERT_EQUAL(2, ucdm_defer_pending());
+    
+    TEST_ASSERT_EQUAL(2, ucdm_defer_poll());
+    TEST_ASSERT_EQUAL(3, rwh_calls);
+    TEST_ASSERT_EQUAL(0, ucdm_defer_pending());
+    TEST_ASSERT_EQUAL(1, ucdm_defer_is_deferred((void *)rwh_variable));
+}
+
+void test_defer_recovery(void){
+    rwh_calls = 0;
+    rwh_duration = 10;
+    ucdm_set_register(ADDR_RW, 4);
+    ucdm_defer_poll();
+    TEST_ASSERT_EQUAL(1, ucdm_defer_is_deferred((void *)rwh_variable));
+    ucdm_set_register(ADDR_RW, 5);
+    ucdm_defer_poll();
+    TEST_ASSERT_EQUAL(2, rwh_calls);
+    TEST_ASSERT_EQUAL(0, ucdm_defer_is_deferred((void *)rwh_variable));
+    
+    ucdm_set_register(ADDR_RW, 6);
+    TEST_ASSERT_EQUAL(3, rwh_calls);
+    TEST_ASSERT_EQUAL(0, ucdm_defer_pending());
+}
+
+void test_defer_bit_handler(void){
+    bwh_calls = 0;
+    ucdm_set_bit(ADDR_BW << 4 | 1);
+    TEST_ASSERT_EQUAL(1, bwh_calls);
+    ucdm_set_bit(ADDR_BW << 4 | 5);
+    TEST_ASSERT_EQUAL(1, bwh_calls);
+    TEST_ASSERT_EQUAL(1, ucdm_defer_poll());
+    TEST_ASSERT_EQUAL(2, bwh_calls);
+    TEST_ASSERT_EQUAL_HEX16(1 << 5, bwh_mask);
+}
+
+void test_defer_queue_full(void){
+    bwh_calls = 0;
+    for (uint8_t i=0; i < UCDM_DEFER_QUEUE_LENGTH + 2; i++){
+        ucdm_set_bit(ADDR_BW << 4 | 1);
+    }
+    // Overflowing executions run inline rather than being dropped
+    TEST_ASSERT_EQUAL(2, bwh_calls);
+    TEST_ASSERT_EQUAL(UCDM_DEFER_QUEUE_LENGTH, ucdm_defer_pending());
+    TEST_ASSERT_EQUAL(UCDM_DEFER_QUEUE_LENGTH, ucdm_defer_poll());
+}
+
+void test_defer_priority(void){
+    TEST_ASSERT_EQUAL(1, ucdm_defer_set_priority((void *)rwh_urgent, UCDM_DEFER_PRIORITIES));
+    rwh_duration = APP_UCDM_HANDLER_BUDGET + 1;
+    ucdm_set_register(ADDR_RW, 1);
+    ucdm_set_register(ADDR_HI, 1);
+    TEST_ASSERT_EQUAL(1, ucdm_defer_is_deferred((void *)rwh_variable));
+    TEST_ASSERT_EQUAL(1, ucdm_defer_is_deferred((void *)rwh_urgent));
+    
+    norder = 0;
+    ucdm_set_register(ADDR_RW, 2);
+    ucdm_set_register(ADDR_RW, 3);
+    ucdm_set_register(ADDR_HI, 2);
+    TEST_ASSERT_EQUAL(2, ucdm_defer_pending_class(0));
+    TEST_ASSERT_EQUAL(1, ucdm_defer_pending_class(2));
+    TEST_ASSERT_EQUAL(0, norder);
+    
+    TEST_ASSERT_EQUAL(3, ucdm_defer_poll());
+    TEST_ASSERT_EQUAL(3, norder);
+    TEST_ASSERT_EQUAL(ADDR_HI, order[0]);
+    TEST_ASSERT_EQUAL(ADDR_RW, order[1]);
+    TEST_ASSERT_EQUAL(ADDR_RW, order[2]);
+}
+
+void test_defer_poll_budget(void){
+    rwh_duration = APP_UCDM_DEFER_POLL_BUDGET / 2;
+    for (uint8_t i=0; i < 4; i++){
+        ucdm_set_register(ADDR_RW, i);
+    }
+    TEST_ASSERT_EQUAL(4, ucdm_defer_pending());
+    // Stops once the pass has used up its budget
+    TEST_ASSERT_EQUAL(2, ucdm_defer_poll());
+    TEST_ASSERT_EQUAL(2, ucdm_defer_poll());
+    TEST_ASSERT_EQUAL(0, ucdm_defer_pending());
+}
+
+void test_defer_priority_install(void){
+    // A handler whose priority can't be assigned is not installed
+    ucdm_enable_regw(ADDR_BADPRIO);
+    TEST_ASSERT_EQUAL(1, ucdm_install_regw_handler_prio(UCDM_MAX_REGISTERS, &badprio_node, rwh_variable, 0));
+    TEST_ASSERT_EQUAL(2, ucdm_install_regw_handler_prio(ADDR_BADPRIO, &badprio_node, rwh_variable, UCDM_DEFER_PRIORITIES));
+    TEST_ASSERT_FALSE(ucdm_acctype[ADDR_BADPRIO] & UCDM_AT_REGW_HF);
+    rwh_calls = 0;
+    rwh_duration = 0;
+    ucdm_set_register(ADDR_BADPRIO, 1);
+    TEST_ASSERT_EQUAL(0, rwh_calls);
+}
+
+void test_defer_pool_removal(void){
+    while (ucdm_defer_pending()){
+        ucdm_defer_poll();
+    }
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_POOL, rwh_pool_a));
+    ucdm_set_register(ADDR_POOL, 1);
+    TEST_ASSERT_EQUAL(1, ucdm_defer_is_deferred((void *)rwh_pool_a));
+    ucdm_set_register(ADDR_POOL, 2);
+    ucdm_set_register(ADDR_POOL, 3);
+    TEST_ASSERT_EQUAL(2, ucdm_defer_pending());
+    
+    // Queued executions of a removed handler are dropped
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_remove_regw(ADDR_POOL, rwh_pool_a));
+    TEST_ASSERT_EQUAL(0, ucdm_defer_pending());
+    pool_a_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_defer_poll());
+    TEST_ASSERT_EQUAL(0, pool_a_calls);
+    
+    // and those of a replaced handler go to its replacement
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_POOL, rwh_pool_a));
+    ucdm_set_register(ADDR_POOL, 4);
+    TEST_ASSERT_EQUAL(1, ucdm_defer_pending());
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_replace_regw(ADDR_POOL, rwh_pool_a, rwh_pool_b));
+    TEST_ASSERT_EQUAL(1, ucdm_defer_poll());
+    TEST_ASSERT_EQUAL(0, pool_a_calls);
+    TEST_ASSERT_EQUAL(1, pool_b_calls);
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_regw(ADDR_POOL));
+}
+
+void test_defer_removal_during_poll(void){
+    while (ucdm_defer_pending()){
+        ucdm_defer_poll();
+    }
+    ucdm_enable_regw(ADDR_REMOVER);
+    ucdm_install_regw_handler(ADDR_REMOVER, &remover_node, rwh_remover);
+    remover_armed = 0;
+    ucdm_set_register(ADDR_REMOVER, 1);
+    TEST_ASSERT_EQUAL(1, ucdm_defer_is_deferred((void *)rwh_remover));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_POOL, rwh_pool_a));
+    TEST_ASSERT_EQUAL(1, ucdm_defer_is_deferred((void *)rwh_pool_a));
+    
+    // The remover is queued ahead of two runs of the pool handler
+    ucdm_set_register(ADDR_REMOVER, 2);
+    ucdm_set_register(ADDR_POOL, 1);
+    ucdm_set_register(ADDR_POOL, 2);
+    TEST_ASSERT_EQUAL(3, ucdm_defer_pending_class(0));
+    
+    remover_armed = 1;
+    pool_a_calls = 0;
+    TEST_ASSERT_EQUAL(1, ucdm_defer_poll());
+    TEST_ASSERT_EQUAL(0, pool_a_calls);
+    TEST_ASSERT_EQUAL(0, ucdm_defer_pending());
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_defer_fast_inline);
+    RUN_TEST(test_defer_slow_deferred);
+    RUN_TEST(test_defer_recovery);
+    RUN_TEST(test_defer_bit_handler);
+    RUN_TEST(test_defer_queue_full);
+    RUN_TEST(test_defer_priority);
+    RUN_TEST(test_defer_poll_budget);
+    RUN_TEST(test_defer_priority_install);
+    RUN_TEST(test_defer_pool_removal);
+    RUN_TEST(test_defer_removal_during_poll);
+    return UNITY_END();
+}
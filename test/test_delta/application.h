@@ -0,0 +1,8 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_ENABLE_UCDM_DELTA
+#define APP_ENABLE_UCDM_DELTA               1
+#endif
+
+#include "../include/application.h"
@@ -0,0 +1,189 @@
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/delta.h>
+#include <scaffold.h>
+#include <string.h>
+
+#define ADDR_NORM       0x10
+#define ADDR_FUNC       0x11
+
+uint16_t rfunc_value(ucdm_addr_t addr){
+    return 0x1234;
+}
+
+void setup(void){
+    ucdm_enable_regr(ADDR_NORM);
+    ucdm_redirect_regr_func(ADDR_FUNC, rfunc_value);
+}
+
+uint8_t buffer[UCDM_DELTA_MAX_LENGTH(16)];
+
+void test_delta_roundtrip(void){
+    uint16_t prev[16] = {0};
+    uint16_t curr[16] = {0};
+    uint16_t snap[16];
+    curr[3] = 5;            // Small difference
+    curr[4] = 0xFFFF;       // -1
+    curr[6] = 0x0100;       // Absorbed unchanged register before this
+    curr[15] = 0x8000;
+    memcpy(snap, prev, sizeof(snap));
+    uint32_t len = ucdm_delta_encode(prev, curr, 16, buffer, sizeof(buffer));
+    TEST_ASSERT_NOT_EQUAL(0, len);
+    TEST_ASSERT_EQUAL(0, ucdm_delta_decode(buffer, len, snap, 16));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(curr, snap, 16);
+    
+    // count, skip 3, diff 4 {5, -1, 0, 0x100}, skip 8, diff 1 {0x8000}
+    TEST_ASSERT_EQUAL(1 + 1 + 1 + (1 + 1 + 1 + 2) + 1 + 1 + 3, len);
+    TEST_ASSERT_EQUAL_HEX8(16, buffer[0]);
+    TEST_ASSERT_EQUAL_HEX8((3 << 2) | UCDM_DELTA_RUN_SKIP, buffer[1]);
+    TEST_ASSERT_EQUAL_HEX8((4 << 2) | UCDM_DELTA_RUN_DIFF, buffer[2]);
+    TEST_ASSERT_EQUAL_HEX8(10, buffer[3]);
+    TEST_ASSERT_EQUAL_HEX8(1, buffer[4]);
+    
+    // Unchanged snapshots encode to a single skip run
+    TEST_ASSERT_EQUAL(2, ucdm_delta_encode(curr, curr, 16, buffer, sizeof(buffer)));
+}
+
+void test_delta_xor(void){
+    // Flags set in bit 6 are 2 byte differences, but 1 byte XORs
+    uint16_t prev[4] = {0x0000, 0x0001, 0x0000, 0x0010};
+    uint16_t curr[4] = {0x0040, 0x0041, 0x0060, 0x0050};
+    uint16_t snap[4];
+    memcpy(snap, prev, sizeof(snap));
+    uint32_t len = ucdm_delta_encode(prev, curr, 4, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_HEX8((4 << 2) | UCDM_DELTA_RUN_XOR, buffer[1]);
+    TEST_ASSERT_EQUAL(6, len);
+    TEST_ASSERT_EQUAL(0, ucdm_delta_decode(buffer, len, snap, 4));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(curr, snap, 4);
+}
+
+void test_delta_errors(void){
+    uint16_t prev[16] = {0};
+    uint16_t curr[16];
+    for (uint8_t i=0; i < 16; i++){
+        curr[i] = 0x4000 + i;
+    }
+    TEST_ASSERT_EQUAL(0, ucdm_delta_encode(prev, curr, 16, buffer, 10));
+    uint32_t len = ucdm_delta_encode(prev, curr, 16, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(2, ucdm_delta_decode(buffer, len, prev, 15));
+    TEST_ASSERT_EQUAL(1, ucdm_delta_decode(buffer, len - 1, prev, 16));
+    TEST_ASSERT_EQUAL(1, ucdm_delta_decode(buffer, len + 1, prev, 16));
+    // Malformed deltas leave the snapshot as it was
+    const uint16_t zero[16] = {0};
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(zero, prev, 16);
+}
+
+void test_delta_capture(void){
+    uint16_t snap[3];
+    ucdm_register[ADDR_NORM].data = 0xABCD;
+    TEST_ASSERT_EQUAL(0, ucdm_delta_capture(ADDR_NORM, 3, snap));
+    TEST_ASSERT_EQUAL_HEX16(0xABCD, snap[0]);
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, snap[1]);
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, snap[2]);
+    TEST_ASSERT_EQUAL(1, ucdm_delta_capture(UCDM_MAX_REGISTERS - 1, 2, snap));
+}
+
+#ifdef PIO_NATIVE
+
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_REGISTERS     4096
+#define BENCH_ROUNDS        2000
+
+uint16_t bench_prev[BENCH_REGISTERS];
+uint16_t bench_curr[BENCH_REGISTERS];
+uint16_t bench_snap[BENCH_REGISTERS];
+uint8_t bench_buffer[UCDM_DELTA_MAX_LENGTH(BENCH_REGISTERS)];
+uint32_t bench_seed = 12345;
+
+static uint16_t bench_rand(void){
+    bench_seed = bench_seed * 1103515245 + 12345;
+    return bench_seed >> 16;
+}
+
+static double bench_now(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Realistic maps : configuration which rarely changes, measurements 
+// drifting by small amounts, counters, and status words with a few 
+// changing flags.
+static void bench_step(uint8_t scenario){
+    for (uint16_t i=0; i < BENCH_REGISTERS; i++){
+        uint16_t r = bench_rand();
+        switch (scenario){
+            case 0:
+                // Mostly static : 1% of registers change slightly
+                if (r % 100 == 0){
+                    bench_curr[i] += (r >> 8) % 5 - 2;
+                }
+                break;
+            case 1:
+                // Telemetry : a quarter of the map are measurements, with 
+                // counters and status flags in between
+                if (i % 4 == 0){
+                    bench_curr[i] += (r >> 8) % 21 - 10;
+                } else if (i % 64 == 1){
+                    bench_curr[i]++;
+                } else if (i % 64 == 2 && r % 8 == 0){
+                    bench_curr[i] ^= 1 << (r % 4);
+                }
+                break;
+            default:
+                // Worst case : everything changes at random
+                bench_curr[i] = r;
+                break;
+        }
+    }
+}
+
+static void bench_scenario(uint8_t scenario, const char * name){
+    double encode_time = 0, decode_time = 0, t;
+    uint64_t total = 0;
+    for (uint16_t i=0; i < BENCH_REGISTERS; i++){
+        bench_curr[i] = bench_rand();
+    }
+    memcpy(bench_snap, bench_curr, sizeof(bench_snap));
+    for (uint16_t round=0; round < BENCH_ROUNDS; round++){
+        memcpy(bench_prev, bench_curr, sizeof(bench_prev));
+        bench_step(scenario);
+        t = bench_now();
+        uint32_t len = ucdm_delta_encode(bench_prev, bench_curr, BENCH_REGISTERS, 
+                                         bench_buffer, sizeof(bench_buffer));
+        encode_time += bench_now() - t;
+        TEST_ASSERT_NOT_EQUAL(0, len);
+        t = bench_now();
+        TEST_ASSERT_EQUAL(0, ucdm_delta_decode(bench_buffer, len, bench_snap, BENCH_REGISTERS));
+        decode_time += bench_now() - t;
+        total += len;
+    }
+    TEST_ASSERT_EQUAL(0, memcmp(bench_snap, bench_curr, sizeof(bench_snap)));
+    double raw = (double)BENCH_ROUNDS * BENCH_REGISTERS * 2;
+    printf("%-12s ratio %7.2f  encode %8.1f MB/s  decode %8.1f MB/s\n", name, 
+           raw / total, raw / encode_time / 1e6, raw / decode_time / 1e6);
+}
+
+void test_delta_benchmark(void){
+    bench_scenario(0, "static");
+    bench_scenario(1, "telemetry");
+    bench_scenario(2, "random");
+}
+
+#endif
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_delta_roundtrip);
+    RUN_TEST(test_delta_xor);
+    RUN_TEST(test_delta_errors);
+    RUN_TEST(test_delta_capture);
+    #ifdef PIO_NATIVE
+    RUN_TEST(test_delta_benchmark);
+    #endif
+    return UNITY_END();
+}
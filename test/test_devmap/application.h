@@ -0,0 +1,16 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_ENABLE_UCDM_DEVMAP
+#define APP_ENABLE_UCDM_DEVMAP              1
+#endif
+
+#ifndef APP_UCDM_DEVMAP_MAX_DESCRIPTORS
+#define APP_UCDM_DEVMAP_MAX_DESCRIPTORS     16
+#endif
+
+#ifndef APP_UCDM_SPAN_MAX_COUNT
+#define APP_UCDM_SPAN_MAX_COUNT             8
+#endif
+
+#include "../include/application.h"
@@ -0,0 +1,239 @@
+
+#include <unity.h>
+#include <string.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/span.h>
+#include <ucdm/descriptor.h>
+#include <ucdm/devmap.h>
+#include <scaffold.h>
+
+#define ADDR_NORM       0x10
+#define ADDR_PTR        0x14
+#define ADDR_RFUNC      0x18
+#define ADDR_WFUNC      0x19
+#define ADDR_SPANR      0x20
+#define ADDR_SPANW      0x24
+#define DESC_TAG        0x42
+
+uint16_t ptr_target[4] = {0xA0, 0xA1, 0xA2, 0xA3};
+uint32_t spanr_target = 0x12345678;
+uint32_t spanw_target;
+uint16_t wfunc_target;
+
+uint16_t rfunc_fixed(ucdm_addr_t addr){
+    return 0xBEEF;
+}
+
+void wfunc_store(ucdm_addr_t addr, uint16_t value){
+    wfunc_target = value;
+}
+
+void spanw_store(ucdm_addr_t addr, void * value){
+    memcpy(&spanw_target, value, sizeof(uint32_t));
+}
+
+const char desc_content[] = "devmap";
+descriptor_custom_t desc_node = {NULL, DESC_TAG, sizeof(desc_content), 
+                                 DESCRIPTOR_ACCTYPE_PTR, {(void *)desc_content}};
+
+const ucdm_devmap_binding_t bindings[] = {
+    {.ptr = &ptr_target[0]},
+    {.rfunc = rfunc_fixed},
+    {.wfunc = wfunc_store},
+    {.buf = &spanr_target},
+    {.spanw = spanw_store},
+};
+
+uint8_t image[512];
+uint32_t image_len;
+
+uint16_t crc16(const uint8_t * data, uint32_t len){
+    uint16_t crc = 0xFFFF;
+    while (len--){
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i=0; i < 8; i++){
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+uint32_t build_image(uint8_t * target, const uint8_t * records, uint32_t rlen){
+    const uint8_t header[8] = {'U', 'C', 'M', 'P', UCDM_DEVMAP_VERSION, 0, 
+                               UCDM_MAX_REGISTERS & 0xFF, UCDM_MAX_REGISTERS >> 8};
+    memcpy(target, header, 8);
+    memcpy(target + UCDM_DEVMAP_HEADER_LENGTH, records, rlen);
+    uint16_t crc = crc16(records, rlen);
+    target[8] = rlen & 0xFF;
+    target[9] = (rlen >> 8) & 0xFF;
+    target[10] = (rlen >> 16) & 0xFF;
+    target[11] = rlen >> 24;
+    target[12] = crc & 0xFF;
+    target[13] = crc >> 8;
+    return UCDM_DEVMAP_HEADER_LENGTH + rlen;
+}
+
+void configure(void){
+    for (uint8_t i=0; i < 3; i++){
+        ucdm_enable_regr(ADDR_NORM + i);
+        ucdm_enable_regw(ADDR_NORM + i);
+        ucdm_set_register(ADDR_NORM + i, 0x100 + i);
+    }
+    ucdm_enable_bitw(ADDR_NORM);
+    for (uint8_t i=0; i < 4; i++){
+        ucdm_redirect_regr_ptr(ADDR_PTR + i, &ptr_target[i]);
+        ucdm_redirect_regw_ptr(ADDR_PTR + i, &ptr_target[i]);
+    }
+    ucdm_redirect_regr_func(ADDR_RFUNC, rfunc_fixed);
+    ucdm_redirect_regw_func(ADDR_WFUNC, wfunc_store);
+    ucdm_redirect_spanr_buf(ADDR_SPANR, &spanr_target, 4);
+    ucdm_redirect_spanw_func(ADDR_SPANW, 4, spanw_store);
+    ucdm_set_span_order(ADDR_SPANR, UCDM_SPAN_ORDER_ABCD);
+    descriptor_install(&desc_node);
+}
+
+void test_devmap_export(void){
+    uint8_t small[16];
+    configure();
+    TEST_ASSERT_EQUAL(0, ucdm_devmap_export(small, sizeof(small), bindings, 5));
+    image_len = ucdm_devmap_export(image, sizeof(image), bindings, 5);
+    TEST_ASSERT_NOT_EQUAL(0, image_len);
+    TEST_ASSERT_EQUAL_HEX8('U', image[0]);
+    TEST_ASSERT_EQUAL(UCDM_DEVMAP_VERSION, image[4]);
+}
+
+void test_devmap_load(void){
+    ucdm_init();
+    TEST_ASSERT_EQUAL(0, ucdm_devmap_load(image, image_len, bindings, 5));
+    
+    TEST_ASSERT_EQUAL_HEX16(0x101, ucdm_get_register(ADDR_NORM + 1));
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_NORM << 4 | 15));
+    TEST_ASSERT_EQUAL(2, ucdm_set_bit((ADDR_NORM + 1) << 4 | 15));
+    
+    TEST_ASSERT_EQUAL_HEX16(0xA2, ucdm_get_register(ADDR_PTR + 2));
+    ucdm_set_register(ADDR_PTR + 3, 0xB3);
+    TEST_ASSERT_EQUAL_HEX16(0xB3, ptr_target[3]);
+    
+    TEST_ASSERT_EQUAL_HEX16(0xBEEF, ucdm_get_register(ADDR_RFUNC));
+    ucdm_set_register(ADDR_WFUNC, 0x55);
+    TEST_ASSERT_EQUAL_HEX16(0x55, wfunc_target);
+    
+    TEST_ASSERT_EQUAL_HEX16(0x1234, ucdm_get_register(ADDR_SPANR));
+    TEST_ASSERT_EQUAL_HEX16(0x5678, ucdm_get_register(ADDR_SPANR + 1));
+    ucdm_set_register(ADDR_SPANW, 0x4321);
+    ucdm_set_register(ADDR_SPANW + 1, 0x8765);
+    TEST_ASSERT_EQUAL_HEX32(0x87654321, spanw_target);
+    
+    descriptor_custom_t * dptr = descriptor_find(DESC_TAG);
+    TEST_ASSERT_NOT_EQUAL(&desc_node, dptr);
+    TEST_ASSERT_EQUAL(sizeof(desc_content), dptr->length);
+    TEST_ASSERT_EQUAL_STRING(desc_content, (const char *)dptr->value.ptr);
+}
+
+void test_devmap_roundtrip(void){
+    uint8_t again[512];
+    ucdm_init();
+    ucdm_devmap_load(image, image_len, bindings, 5);
+    uint32_t len = ucdm_devmap_export(again, sizeof(again), bindings, 5);
+    // Loaded descriptors shadow the existing ones rather than replacing 
+    // them, so the image grows. The register configuration is unchanged.
+    TEST_ASSERT_GREATER_THAN(image_len, len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&image[UCDM_DEVMAP_HEADER_LENGTH], 
+                                  &again[UCDM_DEVMAP_HEADER_LENGTH], 76);
+}
+
+void test_devmap_bad_image(void){
+    uint8_t corrupt[512];
+    memcpy(corrupt, image, image_len);
+    corrupt[image_len - 1] ^= 0xFF;
+    TEST_ASSERT_EQUAL(2, ucdm_devmap_load(corrupt, image_len, bindings, 5));
+    corrupt[image_len - 1] ^= 0xFF;
+    corrupt[4] = UCDM_DEVMAP_VERSION + 1;
+    TEST_ASSERT_EQUAL(2, ucdm_devmap_load(corrupt, image_len, bindings, 5));
+    TEST_ASSERT_EQUAL(2, ucdm_devmap_load(image, image_len - 1, bindings, 5));
+    // Nothing is applied from an image with a bad record
+    uint8_t acctype = ucdm_acctype[ADDR_NORM];
+    ucdm_acctype[ADDR_NORM] = 0;
+    TEST_ASSERT_EQUAL(3, ucdm_devmap_load(image, image_len, bindings, 2));
+    TEST_ASSERT_EQUAL(0, ucdm_acctype[ADDR_NORM]);
+    ucdm_acctype[ADDR_NORM] = acctype;
+}
+
+void test_devmap_bad_data(void){
+    uint8_t bad[64];
+    // Data records may only address plain registers, including those made 
+    // plain by an earlier record in the same image.
+    const uint8_t records[] = {
+        UCDM_DEVMAP_REC_RANGE, 8, ADDR_NORM, 0, 1, 0, 
+            UCDM_AT_READ_NORM | UCDM_AT_REGW_TYPE_NORMAL, UCDM_DEVMAP_UNBOUND, 0, 0,
+        UCDM_DEVMAP_REC_RANGE, 8, ADDR_PTR, 0, 1, 0, 
+            UCDM_AT_READ_PTR | UCDM_AT_REGW_TYPE_PTR, 0, 0, 0,
+        UCDM_DEVMAP_REC_DATA, 4, ADDR_NORM, 0, 0x34, 0x12,
+        UCDM_DEVMAP_REC_DATA, 4, ADDR_PTR, 0, 0x78, 0x56,
+    };
+    ucdm_init();
+    uint32_t len = build_image(bad, records, sizeof(records));
+    TEST_ASSERT_EQUAL(3, ucdm_devmap_load(bad, len, bindings, 5));
+    TEST_ASSERT_EQUAL(0, ucdm_acctype[ADDR_NORM]);
+    TEST_ASSERT_EQUAL(0, ucdm_acctype[ADDR_PTR]);
+    len = build_image(bad, records, sizeof(records) - 6);
+    TEST_ASSERT_EQUAL(0, ucdm_devmap_load(bad, len, bindings, 5));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, ucdm_get_register(ADDR_NORM));
+    TEST_ASSERT_EQUAL_HEX16(0xA0, ucdm_get_register(ADDR_PTR));
+}
+
+void test_devmap_unbound(void){
+    uint8_t unbound[64];
+    // Unbound registers lose the targets they were redirected to before
+    const uint8_t records[] = {
+        UCDM_DEVMAP_REC_RANGE, 8, ADDR_PTR, 0, 1, 0, 
+            UCDM_AT_READ_PTR | UCDM_AT_REGW_TYPE_PTR, UCDM_DEVMAP_UNBOUND, 0, 0,
+        UCDM_DEVMAP_REC_RANGE, 8, ADDR_WFUNC, 0, 1, 0, 
+            UCDM_AT_REGW_TYPE_FUNC, UCDM_DEVMAP_UNBOUND, 0, 0,
+    };
+    ucdm_redirect_regr_ptr(ADDR_PTR, &ptr_target[0]);
+    ucdm_redirect_regw_ptr(ADDR_PTR, &ptr_target[0]);
+    ucdm_redirect_regw_func(ADDR_WFUNC, wfunc_store);
+    ptr_target[0] = 0xA0;
+    wfunc_target = 0;
+    uint32_t len = build_image(unbound, records, sizeof(records));
+    TEST_ASSERT_EQUAL(0, ucdm_devmap_load(unbound, len, bindings, 5));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, ucdm_get_register(ADDR_PTR));
+    TEST_ASSERT_EQUAL(3, ucdm_set_register(ADDR_PTR, 0x1111));
+    TEST_ASSERT_EQUAL_HEX16(0xA0, ptr_target[0]);
+    TEST_ASSERT_EQUAL(3, ucdm_set_register(ADDR_WFUNC, 0x2222));
+    TEST_ASSERT_EQUAL_HEX16(0, wfunc_target);
+}
+
+void test_devmap_file(void){
+    const char * path = "/tmp/ucdm_test_devmap.img";
+    TEST_ASSERT_EQUAL(0, ucdm_devmap_export_file(path, bindings, 5));
+    ucdm_init();
+    TEST_ASSERT_EQUAL(0, ucdm_devmap_load_file(path, bindings, 5));
+    TEST_ASSERT_EQUAL_HEX16(0xBEEF, ucdm_get_register(ADDR_RFUNC));
+    remove(path);
+}
+
+uint8_t long_content[255];
+descriptor_custom_t long_node = {NULL, DESC_TAG + 1, sizeof(long_content), 
+                                 DESCRIPTOR_ACCTYPE_PTR, {(void *)long_content}};
+
+void test_devmap_long_descriptor(void){
+    // A descriptor and its tag must fit in a record
+    descriptor_install(&long_node);
+    TEST_ASSERT_EQUAL(0, ucdm_devmap_export(image, sizeof(image), bindings, 5));
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    RUN_TEST(test_devmap_export);
+    RUN_TEST(test_devmap_load);
+    RUN_TEST(test_devmap_roundtrip);
+    RUN_TEST(test_devmap_bad_image);
+    RUN_TEST(test_devmap_file);
+    RUN_TEST(test_devmap_bad_data);
+    RUN_TEST(test_devmap_unbound);
+    RUN_TEST(test_devmap_long_descriptor);
+    return UNITY_END();
+}
@@ -0,0 +1,110 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/diag.h>
+#include <scaffold.h>
+
+#define ADDR_RW         0x10
+#define ADDR_RO         0x11
+#define ADDR_NULLPTR    0x12
+
+void rwh_null(ucdm_addr_t addr){
+    return;
+}
+
+avlt_node_t rwh_node;
+
+void setup(void){
+    ucdm_enable_regr(ADDR_RW);
+    ucdm_enable_regw(ADDR_RW);
+    ucdm_enable_bitw(ADDR_RW);
+    ucdm_enable_regr(ADDR_RO);
+    ucdm_redirect_regw_ptr(ADDR_NULLPTR, NULL);
+    ucdm_install_regw_handler(ADDR_RW, &rwh_node, rwh_null);
+}
+
+void test_diag_accesses(void){
+    ucdm_diag_clear();
+    ucdm_set_register(ADDR_RW, 1);
+    ucdm_get_register(ADDR_RW);
+    ucdm_set_bit(ADDR_RW << 4);
+    ucdm_get_bit(ADDR_RW << 4);
+    TEST_ASSERT_EQUAL(4, ucdm_diag.accesses);
+    TEST_ASSERT_EQUAL(4, ucdm_diag.messages);
+    TEST_ASSERT_EQUAL(0, ucdm_diag.exceptions);
+    // The register write handler also runs for bit writes
+    TEST_ASSERT_EQUAL(2, ucdm_diag.handler_calls);
+    // Internal reads are not counted
+    _ucdm_get_register(ADDR_RW);
+    TEST_ASSERT_EQUAL(4, ucdm_diag.accesses);
+}
+
+void test_diag_rejected(void){
+    ucdm_diag_clear();
+    ucdm_exception_status = 0;
+    ucdm_get_register(UCDM_MAX_REGISTERS);
+    ucdm_get_register(ADDR_NULLPTR);
+    TEST_ASSERT_EQUAL(2, ucdm_diag.rejected_reads);
+    TEST_ASSERT_EQUAL_HEX8(UCDM_EXST_READ_REJECTED, ucdm_exception_status);
+    
+    ucdm_set_register(ADDR_RO, 1);
+    ucdm_set_bit(ADDR_RO << 4);
+    ucdm_set_register(ADDR_NULLPTR, 1);
+    TEST_ASSERT_EQUAL(3, ucdm_diag.rejected_writes);
+    TEST_ASSERT_EQUAL_HEX8(UCDM_EXST_READ_REJECTED | UCDM_EXST_WRITE_REJECTED, 
+                           ucdm_exception_status);
+    
+    TEST_ASSERT_EQUAL(5, ucdm_diag.exceptions);
+    TEST_ASSERT_EQUAL(4, ucdm_diag.exception_codes[UCDM_EXCEPTION_ILLEGAL_ADDRESS - 1]);
+    TEST_ASSERT_EQUAL(1, ucdm_diag.exception_codes[UCDM_EXCEPTION_DEVICE_FAILURE - 1]);
+    
+    ucdm_diag_exception(UCDM_EXCEPTION_ILLEGAL_FUNCTION);
+    TEST_ASSERT_EQUAL(1, ucdm_diag.exception_codes[UCDM_EXCEPTION_ILLEGAL_FUNCTION - 1]);
+}
+
+void test_diag_fc08(void){
+    uint16_t value;
+    ucdm_diag_clear();
+    ucdm_exception_status = 0;
+    uint16_t values[3];
+    ucdm_get_register(ADDR_RW);
+    ucdm_get_register(ADDR_NULLPTR);
+    ucdm_set_register(ADDR_RO, 1);
+    // Bulk accesses count once as messages, whatever their length
+    ucdm_get_registers(ADDR_RW, 2, values);
+    ucdm_get_registers(ADDR_RW, 3, values);
+    ucdm_get_registers(UCDM_MAX_REGISTERS - 1, 2, values);
+    ucdm_diag_exception(UCDM_EXCEPTION_ILLEGAL_FUNCTION);
+    TEST_ASSERT_EQUAL(8, ucdm_diag.accesses);
+    TEST_ASSERT_EQUAL(6, ucdm_diag.messages);
+    ucdm_exception_status |= UCDM_EXST_KEEPALIVE_REQ;
+    ucdm_diagnostic_register = 0x1234;
+    TEST_ASSERT_EQUAL(0, ucdm_diag_fc08(0x0002, &value));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, value);
+    TEST_ASSERT_EQUAL(0, ucdm_diag_fc08(0x000B, &value));
+    TEST_ASSERT_EQUAL(6, value);
+    TEST_ASSERT_EQUAL(0, ucdm_diag_fc08(0x000E, &value));
+    TEST_ASSERT_EQUAL(6, value);
+    TEST_ASSERT_EQUAL(0, ucdm_diag_fc08(0x000D, &value));
+    TEST_ASSERT_EQUAL(5, value);
+    TEST_ASSERT_EQUAL(1, ucdm_diag_fc08(0x000C, &value));
+    
+    TEST_ASSERT_EQUAL(0, ucdm_diag_fc08(0x000A, &value));
+    TEST_ASSERT_EQUAL(0, ucdm_diag.accesses);
+    TEST_ASSERT_EQUAL(0, ucdm_diag.messages);
+    TEST_ASSERT_EQUAL(0, ucdm_diag.exception_messages);
+    TEST_ASSERT_EQUAL(0, ucdm_diag.exceptions);
+    TEST_ASSERT_EQUAL(0, ucdm_diagnostic_register);
+    // Application requests are not cleared along with the counters
+    TEST_ASSERT_EQUAL_HEX8(UCDM_EXST_KEEPALIVE_REQ, ucdm_exception_status);
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_diag_accesses);
+    RUN_TEST(test_diag_rejected);
+    RUN_TEST(test_diag_fc08);
+    return UNITY_END();
+}
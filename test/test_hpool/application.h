@@ -0,0 +1,12 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_UCDM_MAX_HANDLERS
+#define APP_UCDM_MAX_HANDLERS               4
+#endif
+
+#ifndef APP_UCDM_HPOOL_MAX_CHAIN
+#define APP_UCDM_HPOOL_MAX_CHAIN            3
+#endif
+
+#include "../include/application.h"
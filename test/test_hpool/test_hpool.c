@@ -0,0 +1,324 @@
+#include <unity.h>
+#include <string.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/hpool.h>
+#include <scaffold.h>
+
+#define ADDR_REG1       0x30
+#define ADDR_REG2       0x31
+#define ADDR_REG3       0x32
+#define ADDR_BITS       0x33
+#define ADDR_BOTH       0x34
+
+typedef struct SIGNALS_t{
+    uint8_t rwh1;
+    uint8_t rwh2;
+    uint8_t appnode;
+    uint8_t bwh1;
+    uint16_t bwh1_mask;
+    uint8_t calls;
+    uint8_t order[4];
+} signals_t;
+
+signals_t signals;
+
+void reset_signals(void){
+    memset(&signals, 0, sizeof(signals));
+}
+
+void log_call(uint8_t id){
+    if (signals.calls < sizeof(signals.order)){
+        signals.order[signals.calls] = id;
+    }
+    signals.calls++;
+}
+
+void rwh_1(ucdm_addr_t addr){
+    signals.rwh1 = addr;
+    log_call(1);
+}
+
+void rwh_2(ucdm_addr_t addr){
+    signals.rwh2 = addr;
+    log_call(2);
+}
+
+void rwh_3(ucdm_addr_t addr){
+    log_call(3);
+}
+
+void rwh_appnode(ucdm_addr_t addr){
+    signals.appnode = addr;
+}
+
+void bwh_1(ucdm_addr_t addr, uint16_t mask){
+    signals.bwh1 = addr;
+    signals.bwh1_mask = mask;
+}
+
+void bwh_low(ucdm_addr_t addr, uint16_t mask){
+    log_call(4);
+}
+
+void bwh_high(ucdm_addr_t addr, uint16_t mask){
+    log_call(5);
+}
+
+void rwh_self_remove(ucdm_addr_t addr){
+    log_call(6);
+    ucdm_hpool_remove_regw(addr, rwh_self_remove);
+}
+
+void rwh_installer(ucdm_addr_t addr){
+    log_call(7);
+    // A chain at a lower address moves this entry up the pool, and a 
+    // handler added to this chain lands after it.
+    ucdm_hpool_install_regw(ADDR_REG1, rwh_1);
+    ucdm_hpool_install_regw(addr, rwh_2);
+}
+
+avlt_node_t app_node;
+
+void setup(void){
+    for (ucdm_addr_t addr=ADDR_REG1; addr <= ADDR_BOTH; addr++){
+        ucdm_enable_regw(addr);
+        ucdm_enable_bitw(addr);
+    }
+}
+
+void test_hpool_install(void){
+    TEST_ASSERT_EQUAL(4, ucdm_hpool_free());
+    // Installed out of address order, to exercise the sorted insert.
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_REG2, rwh_2));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_REG1, rwh_1));
+    TEST_ASSERT_EQUAL(3, ucdm_hpool_install_regw(ADDR_REG1, rwh_1));
+    TEST_ASSERT_EQUAL(1, ucdm_hpool_install_regw(UCDM_MAX_REGISTERS, rwh_1));
+    TEST_ASSERT_EQUAL(2, ucdm_hpool_free());
+
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG1, 0x1234));
+    TEST_ASSERT_EQUAL_UINT8(ADDR_REG1, signals.rwh1);
+    TEST_ASSERT_EQUAL_UINT8(0, signals.rwh2);
+
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG2, 0x1234));
+    TEST_ASSERT_EQUAL_UINT8(0, signals.rwh1);
+    TEST_ASSERT_EQUAL_UINT8(ADDR_REG2, signals.rwh2);
+
+    // A bit write without a bit write handler falls back to the 
+    // register write handler.
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_REG1 << 4 | 3));
+    TEST_ASSERT_EQUAL_UINT8(ADDR_REG1, signals.rwh1);
+}
+
+void test_hpool_replace(void){
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_replace_regw(ADDR_REG1, rwh_1, rwh_2));
+    TEST_ASSERT_EQUAL(2, ucdm_hpool_replace_regw(ADDR_REG1, rwh_1, rwh_2));
+    TEST_ASSERT_EQUAL(2, ucdm_hpool_replace_regw(ADDR_REG3, rwh_1, rwh_2));
+    TEST_ASSERT_EQUAL(2, ucdm_hpool_free());
+
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG1, 0x4321));
+    TEST_ASSERT_EQUAL_UINT8(0, signals.rwh1);
+    TEST_ASSERT_EQUAL_UINT8(ADDR_REG1, signals.rwh2);
+}
+
+void test_hpool_uninstall(void){
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_regw(ADDR_REG1));
+    TEST_ASSERT_EQUAL(2, ucdm_hpool_uninstall_regw(ADDR_REG1));
+    TEST_ASSERT_EQUAL(3, ucdm_hpool_free());
+    TEST_ASSERT_FALSE(ucdm_acctype[ADDR_REG1] & UCDM_AT_REGW_HF);
+
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG1, 0x1111));
+    TEST_ASSERT_EQUAL_UINT8(0, signals.rwh2);
+
+    // The remaining handler is unaffected.
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG2, 0x1111));
+    TEST_ASSERT_EQUAL_UINT8(ADDR_REG2, signals.rwh2);
+}
+
+void test_hpool_bitw(void){
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_bitw(ADDR_BITS, bwh_1));
+    TEST_ASSERT_EQUAL(3, ucdm_hpool_install_bitw(ADDR_BITS, bwh_1));
+
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_BITS << 4 | 5));
+    TEST_ASSERT_EQUAL_UINT8(ADDR_BITS, signals.bwh1);
+    TEST_ASSERT_EQUAL_UINT16(1 << 5, signals.bwh1_mask);
+
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_bitw(ADDR_BITS));
+    TEST_ASSERT_FALSE(ucdm_acctype[ADDR_BITS] & UCDM_AT_BITW_HF);
+}
+
+void test_hpool_with_app_node(void){
+    TEST_ASSERT_EQUAL(0, ucdm_install_regw_handler(ADDR_BOTH, &app_node, rwh_appnode));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_BOTH, rwh_1));
+
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_BOTH, 0x2222));
+    TEST_ASSERT_EQUAL_UINT8(ADDR_BOTH, signals.appnode);
+    TEST_ASSERT_EQUAL_UINT8(ADDR_BOTH, signals.rwh1);
+
+    // The handler flag stays for the handler in the application's node.
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_regw(ADDR_BOTH));
+    TEST_ASSERT_TRUE(ucdm_acctype[ADDR_BOTH] & UCDM_AT_REGW_HF);
+
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_BOTH, 0x3333));
+    TEST_ASSERT_EQUAL_UINT8(ADDR_BOTH, signals.appnode);
+    TEST_ASSERT_EQUAL_UINT8(0, signals.rwh1);
+}
+
+void test_hpool_full(void){
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_REG1, rwh_1));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_REG3, rwh_1));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_bitw(ADDR_REG3, bwh_1));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_free());
+    TEST_ASSERT_EQUAL(2, ucdm_hpool_install_regw(ADDR_BITS, rwh_1));
+
+    // Replacing does not need a free entry.
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_replace_regw(ADDR_REG3, rwh_1, rwh_2));
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG3, 0x4444));
+    TEST_ASSERT_EQUAL_UINT8(ADDR_REG3, signals.rwh2);
+}
+
+void test_hpool_chain(void){
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_regw(ADDR_REG1));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_regw(ADDR_REG2));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_regw(ADDR_REG3));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_bitw(ADDR_REG3));
+    TEST_ASSERT_EQUAL(4, ucdm_hpool_free());
+
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_REG2, rwh_1));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_REG2, rwh_2));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_REG2, rwh_3));
+    // The chain is full even though the pool is not
+    TEST_ASSERT_EQUAL(4, ucdm_hpool_install_regw(ADDR_REG2, rwh_appnode));
+    TEST_ASSERT_EQUAL(1, ucdm_hpool_free());
+    // Entries of a neighbouring chain are not part of the walk.
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_bitw(ADDR_REG2, bwh_1));
+
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG2, 0x5555));
+    TEST_ASSERT_EQUAL_UINT8(3, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(1, signals.order[0]);
+    TEST_ASSERT_EQUAL_UINT8(2, signals.order[1]);
+    TEST_ASSERT_EQUAL_UINT8(3, signals.order[2]);
+    TEST_ASSERT_EQUAL_UINT8(0, signals.bwh1);
+
+    // Removing one handler leaves the others in place and in order.
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_remove_regw(ADDR_REG2, rwh_2));
+    TEST_ASSERT_EQUAL(2, ucdm_hpool_remove_regw(ADDR_REG2, rwh_2));
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG2, 0x6666));
+    TEST_ASSERT_EQUAL_UINT8(2, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(1, signals.order[0]);
+    TEST_ASSERT_EQUAL_UINT8(3, signals.order[1]);
+
+    // A bit write with a bit write handler only runs the bit write chain.
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_REG2 << 4 | 1));
+    TEST_ASSERT_EQUAL_UINT8(0, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(ADDR_REG2, signals.bwh1);
+
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_remove_regw(ADDR_REG2, rwh_1));
+    TEST_ASSERT_TRUE(ucdm_acctype[ADDR_REG2] & UCDM_AT_REGW_HF);
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_remove_regw(ADDR_REG2, rwh_3));
+    TEST_ASSERT_FALSE(ucdm_acctype[ADDR_REG2] & UCDM_AT_REGW_HF);
+    TEST_ASSERT_TRUE(ucdm_acctype[ADDR_REG2] & UCDM_AT_BITW_HF);
+    TEST_ASSERT_EQUAL(3, ucdm_hpool_free());
+}
+
+void test_hpool_bit_mask(void){
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_bitw_mask(ADDR_BITS, bwh_low, 0x00FF));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_bitw_mask(ADDR_BITS, bwh_high, 0x0F00));
+
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_BITS << 4 | 2));
+    TEST_ASSERT_EQUAL_UINT8(1, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(4, signals.order[0]);
+
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_clear_bit(ADDR_BITS << 4 | 9));
+    TEST_ASSERT_EQUAL_UINT8(1, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(5, signals.order[0]);
+
+    // Bits outside all interest masks run no handler.
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_BITS << 4 | 14));
+    TEST_ASSERT_EQUAL_UINT8(0, signals.calls);
+
+    // A handler without a mask sees every bit, alongside the masked ones.
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_bitw(ADDR_BITS, bwh_1));
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_BITS << 4 | 3));
+    TEST_ASSERT_EQUAL_UINT8(1, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(ADDR_BITS, signals.bwh1);
+    TEST_ASSERT_EQUAL_UINT16(1 << 3, signals.bwh1_mask);
+
+    // Replacing a handler keeps its mask.
+    TEST_ASSERT_EQUAL(3, ucdm_hpool_replace_bitw(ADDR_BITS, bwh_high, bwh_low));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_remove_bitw(ADDR_BITS, bwh_low));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_remove_bitw(ADDR_BITS, bwh_1));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_replace_bitw(ADDR_BITS, bwh_high, bwh_low));
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_BITS << 4 | 2));
+    TEST_ASSERT_EQUAL_UINT8(0, signals.calls);
+    TEST_ASSERT_EQUAL(0, ucdm_set_bit(ADDR_BITS << 4 | 10));
+    TEST_ASSERT_EQUAL_UINT8(1, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(4, signals.order[0]);
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_bitw(ADDR_BITS));
+}
+
+void test_hpool_modify_in_handler(void){
+    TEST_ASSERT_EQUAL(3, ucdm_hpool_free());
+
+    // A handler removing itself does not cause the next one to be skipped
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_REG3, rwh_self_remove));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_REG3, rwh_3));
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG3, 0x1111));
+    TEST_ASSERT_EQUAL_UINT8(2, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(6, signals.order[0]);
+    TEST_ASSERT_EQUAL_UINT8(3, signals.order[1]);
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG3, 0x2222));
+    TEST_ASSERT_EQUAL_UINT8(1, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(3, signals.order[0]);
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_regw(ADDR_REG3));
+
+    // Handlers installed by a handler run from the next write, and the 
+    // handler itself is not called again
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_install_regw(ADDR_REG3, rwh_installer));
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG3, 0x3333));
+    TEST_ASSERT_EQUAL_UINT8(1, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(7, signals.order[0]);
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_free());
+    reset_signals();
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_REG3, 0x4444));
+    TEST_ASSERT_EQUAL_UINT8(2, signals.calls);
+    TEST_ASSERT_EQUAL_UINT8(7, signals.order[0]);
+    TEST_ASSERT_EQUAL_UINT8(2, signals.order[1]);
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_regw(ADDR_REG3));
+    TEST_ASSERT_EQUAL(0, ucdm_hpool_uninstall_regw(ADDR_REG1));
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_hpool_install);
+    RUN_TEST(test_hpool_replace);
+    RUN_TEST(test_hpool_uninstall);
+    RUN_TEST(test_hpool_bitw);
+    RUN_TEST(test_hpool_with_app_node);
+    RUN_TEST(test_hpool_full);
+    RUN_TEST(test_hpool_chain);
+    RUN_TEST(test_hpool_bit_mask);
+    RUN_TEST(test_hpool_modify_in_handler);
+    return UNITY_END();
+}
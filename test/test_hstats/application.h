@@ -0,0 +1,8 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_UCDM_HSTATS_MAX_HANDLERS
+#define APP_UCDM_HSTATS_MAX_HANDLERS        4
+#endif
+
+#include "../include/application.h"
@@ -0,0 +1,88 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/hstats.h>
+#include <scaffold.h>
+
+#define ADDR_FAST       0x20
+#define ADDR_SLOW       0x21
+#define ADDR_BIT        0x22
+
+ucdm_tick_t fake_tick;
+ucdm_tick_t slow_duration;
+
+ucdm_tick_t fake_tick_source(void){
+    return fake_tick;
+}
+
+void rwh_fast(ucdm_addr_t addr){
+    fake_tick += 1;
+}
+
+void rwh_slow(ucdm_addr_t addr){
+    fake_tick += slow_duration;
+}
+
+void bwh_medium(ucdm_addr_t addr, uint16_t mask){
+    fake_tick += 20;
+}
+
+avlt_node_t fast_node, slow_node, bit_node;
+
+void setup(void){
+    ucdm_install_tick_source(fake_tick_source);
+    ucdm_enable_regw(ADDR_FAST);
+    ucdm_enable_regw(ADDR_SLOW);
+    ucdm_enable_regw(ADDR_BIT);
+    ucdm_enable_bitw(ADDR_BIT);
+    ucdm_install_regw_handler(ADDR_FAST, &fast_node, rwh_fast);
+    ucdm_install_regw_handler(ADDR_SLOW, &slow_node, rwh_slow);
+    ucdm_install_bitw_handler(ADDR_BIT, &bit_node, bwh_medium);
+}
+
+void test_hstats_histogram(void){
+    ucdm_hstats_entry_t * entry;
+    slow_duration = 100;
+    ucdm_set_register(ADDR_SLOW, 1);
+    slow_duration = 5;
+    ucdm_set_register(ADDR_SLOW, 2);
+    ucdm_set_register(ADDR_SLOW, 3);
+
+    entry = ucdm_hstats_find((void *)rwh_slow);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL(3, entry->count);
+    TEST_ASSERT_EQUAL(100, entry->max);
+    TEST_ASSERT_EQUAL(110, entry->total);
+    TEST_ASSERT_EQUAL(ADDR_SLOW, entry->addr);
+    // 5 is in [4, 8), 100 is in [64, 128)
+    TEST_ASSERT_EQUAL(2, entry->buckets[3]);
+    TEST_ASSERT_EQUAL(1, entry->buckets[7]);
+    TEST_ASSERT_NULL(ucdm_hstats_find((void *)rwh_fast));
+}
+
+void test_hstats_worst(void){
+    ucdm_hstats_entry_t * worst[2];
+    ucdm_set_register(ADDR_FAST, 1);
+    ucdm_set_bit(ADDR_BIT << 4 | 2);
+    TEST_ASSERT_EQUAL(2, ucdm_hstats_worst(worst, 2));
+    TEST_ASSERT_EQUAL_PTR((void *)rwh_slow, worst[0]->handler);
+    TEST_ASSERT_EQUAL_PTR((void *)bwh_medium, worst[1]->handler);
+    TEST_ASSERT_EQUAL(ADDR_BIT, worst[1]->addr);
+    TEST_ASSERT_EQUAL(1, ucdm_hstats_find((void *)rwh_fast)->buckets[1]);
+}
+
+void test_hstats_reset(void){
+    ucdm_hstats_entry_t * worst[2];
+    ucdm_hstats_reset();
+    TEST_ASSERT_EQUAL(0, ucdm_hstats_worst(worst, 2));
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_hstats_histogram);
+    RUN_TEST(test_hstats_worst);
+    RUN_TEST(test_hstats_reset);
+    return UNITY_END();
+}
@@ -67,6 +67,45 @@ void test_wh_maxrange(void){
     TEST_ASSERT_EQUAL_MESSAGE(1, result, "bwh");
 }
 
+void test_range_readable(void){
+    // Range straddling several bitmap words
+    for (ucdm_addr_t i=30; i < 100; i++){
+        ucdm_enable_regr(i);
+    }
+    TEST_ASSERT_EQUAL(1, ucdm_range_readable(30, 70));
+    TEST_ASSERT_EQUAL(1, ucdm_range_readable(33, 2));
+    TEST_ASSERT_EQUAL(0, ucdm_range_readable(29, 2));
+    TEST_ASSERT_EQUAL(0, ucdm_range_readable(99, 2));
+    ucdm_disable_regr(64);
+    TEST_ASSERT_EQUAL(0, ucdm_range_readable(30, 70));
+    TEST_ASSERT_EQUAL(1, ucdm_range_readable(65, 35));
+    ucdm_redirect_regr_ptr(64, NULL);
+    TEST_ASSERT_EQUAL(1, ucdm_range_readable(30, 70));
+    TEST_ASSERT_EQUAL(0, ucdm_range_readable(30, 0));
+    TEST_ASSERT_EQUAL(0, ucdm_range_readable(UCDM_MAX_REGISTERS - 1, 2));
+}
+
+void test_range_writable(void){
+    for (ucdm_addr_t i=30; i < 100; i++){
+        ucdm_enable_regw(i);
+    }
+    TEST_ASSERT_EQUAL(1, ucdm_range_writable(30, 70));
+    ucdm_redirect_regr_func(40, NULL);
+    TEST_ASSERT_EQUAL(0, ucdm_range_writable(30, 70));
+    TEST_ASSERT_EQUAL(1, ucdm_range_writable(41, 59));
+}
+
+void test_range_bit_writable(void){
+    ucdm_enable_bitw(50);
+    ucdm_enable_bitw(51);
+    TEST_ASSERT_EQUAL(1, ucdm_range_bit_writable(50 << 4, 32));
+    TEST_ASSERT_EQUAL(1, ucdm_range_bit_writable((50 << 4) + 8, 16));
+    TEST_ASSERT_EQUAL(0, ucdm_range_bit_writable((50 << 4) + 8, 32));
+    ucdm_disable_bitw(51);
+    TEST_ASSERT_EQUAL(0, ucdm_range_bit_writable(50 << 4, 32));
+    TEST_ASSERT_EQUAL(0, ucdm_range_bit_writable(UCDM_MAX_BITS - 1, 2));
+}
+
 int main( int argc, char **argv) {
     init();
     UNITY_BEGIN();
@@ -78,5 +117,8 @@ int main( int argc, char **argv) {
     RUN_TEST(test_bitr_maxrange);
     RUN_TEST(test_bitw_maxrange);
     RUN_TEST(test_wh_maxrange);
+    RUN_TEST(test_range_readable);
+    RUN_TEST(test_range_writable);
+    RUN_TEST(test_range_bit_writable);
     UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/rbe.h>
+#include <scaffold.h>
+
+#define ADDR_RBE_ABS        0x20
+#define ADDR_RBE_PCT        0x21
+#define ADDR_RBE_SIGNED     0x22
+#define ADDR_RBE_PTR        0x23
+#define ADDR_RBE_NONE       0x24
+
+uint16_t ptr_target;
+
+void setup(void){
+    ucdm_enable_regr(ADDR_RBE_ABS);
+    ucdm_enable_regw(ADDR_RBE_ABS);
+    ucdm_enable_regr(ADDR_RBE_PCT);
+    ucdm_enable_regw(ADDR_RBE_PCT);
+    ucdm_enable_regr(ADDR_RBE_SIGNED);
+    ucdm_enable_regw(ADDR_RBE_SIGNED);
+    ucdm_enable_bitw(ADDR_RBE_SIGNED);
+    ucdm_redirect_regr_ptr(ADDR_RBE_PTR, &ptr_target);
+    ucdm_enable_regr(ADDR_RBE_NONE);
+    ucdm_enable_regw(ADDR_RBE_NONE);
+
+    ucdm_register[ADDR_RBE_ABS].data = 100;
+    ucdm_register[ADDR_RBE_PCT].data = 1000;
+    ucdm_register[ADDR_RBE_SIGNED].data = (uint16_t)(-10);
+    ptr_target = 500;
+
+    ucdm_rbe_install(ADDR_RBE_ABS, UCDM_RBE_DB_ABSOLUTE, 5);
+    ucdm_rbe_install(ADDR_RBE_PCT, UCDM_RBE_DB_PERCENT, 10);
+    ucdm_rbe_install(ADDR_RBE_SIGNED, UCDM_RBE_DB_ABSOLUTE | UCDM_RBE_SIGNED, 5);
+    ucdm_rbe_install(ADDR_RBE_PTR, UCDM_RBE_DB_ABSOLUTE, 0);
+}
+
+void test_rbe_install_full(void){
+    HAL_BASE_t result = ucdm_rbe_install(ADDR_RBE_NONE, UCDM_RBE_DB_ABSOLUTE, 0);
+    TEST_ASSERT_EQUAL(2, result);
+    result = ucdm_rbe_install(UCDM_MAX_REGISTERS, UCDM_RBE_DB_ABSOLUTE, 0);
+    TEST_ASSERT_EQUAL(1, result);
+}
+
+void test_rbe_reinstall(void){
+    // Reinstalling a monitored register updates it in place, even when full
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_install(ADDR_RBE_ABS, UCDM_RBE_DB_ABSOLUTE, 50));
+    ucdm_set_register(ADDR_RBE_ABS, 140);
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pending());
+    ucdm_set_register(ADDR_RBE_ABS, 100);
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_install(ADDR_RBE_ABS, UCDM_RBE_DB_ABSOLUTE, 5));
+    TEST_ASSERT_EQUAL(2, ucdm_rbe_install(ADDR_RBE_NONE, UCDM_RBE_DB_ABSOLUTE, 0));
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pending());
+}
+
+void test_rbe_absolute(void){
+    ucdm_addr_t addr;
+    uint16_t value;
+
+    ucdm_set_register(ADDR_RBE_ABS, 104);
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pending());
+    ucdm_set_register(ADDR_RBE_ABS, 95);
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pending());
+    ucdm_set_register(ADDR_RBE_ABS, 106);
+    TEST_ASSERT_EQUAL(1, ucdm_rbe_pending());
+    // Coalesced while still in the queue
+    ucdm_set_register(ADDR_RBE_ABS, 120);
+    TEST_ASSERT_EQUAL(1, ucdm_rbe_pending());
+
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pop(&addr, &value));
+    TEST_ASSERT_EQUAL(ADDR_RBE_ABS, addr);
+    TEST_ASSERT_EQUAL(120, value);
+    TEST_ASSERT_EQUAL(1, ucdm_rbe_pop(&addr, &value));
+
+    // Reference is now the reported value
+    ucdm_set_register(ADDR_RBE_ABS, 116);
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pending());
+}
+
+void test_rbe_percent(void){
+    ucdm_addr_t addr;
+    uint16_t value;
+
+    ucdm_set_register(ADDR_RBE_PCT, 1100);
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pending());
+    ucdm_set_register(ADDR_RBE_PCT, 899);
+    TEST_ASSERT_EQUAL(1, ucdm_rbe_pending());
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pop(&addr, &value));
+    TEST_ASSERT_EQUAL(ADDR_RBE_PCT, addr);
+    TEST_ASSERT_EQUAL(899, value);
+}
+
+void test_rbe_signed_bitw(void){
+    ucdm_addr_t addr;
+    uint16_t value;
+
+    ucdm_set_register(ADDR_RBE_SIGNED, (uint16_t)(-6));
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pending());
+    // Clearing the sign bit takes -6 to 32762
+    ucdm_clear_bit(ADDR_RBE_SIGNED << 4 | 15);
+    TEST_ASSERT_EQUAL(1, ucdm_rbe_pending());
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pop(&addr, &value));
+    TEST_ASSERT_EQUAL(ADDR_RBE_SIGNED, addr);
+    TEST_ASSERT_EQUAL(0x7FFA, value);
+}
+
+void test_rbe_internal(void){
+    ucdm_addr_t addr;
+    uint16_t value;
+
+    ptr_target = 501;
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pending());
+    ucdm_rbe_check(ADDR_RBE_PTR);
+    TEST_ASSERT_EQUAL(1, ucdm_rbe_pending());
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pop(&addr, &value));
+    TEST_ASSERT_EQUAL(ADDR_RBE_PTR, addr);
+    TEST_ASSERT_EQUAL(501, value);
+
+    ptr_target = 502;
+    ucdm_register[ADDR_RBE_ABS].data = 200;
+    ucdm_rbe_poll();
+    TEST_ASSERT_EQUAL(2, ucdm_rbe_pending());
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pop(&addr, &value));
+    TEST_ASSERT_EQUAL(ADDR_RBE_ABS, addr);
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pop(&addr, &value));
+    TEST_ASSERT_EQUAL(ADDR_RBE_PTR, addr);
+}
+
+void test_rbe_unmonitored(void){
+    ucdm_set_register(ADDR_RBE_NONE, 0x1234);
+    ucdm_rbe_check(ADDR_RBE_NONE);
+    TEST_ASSERT_EQUAL(0, ucdm_rbe_pending());
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_rbe_install_full);
+    RUN_TEST(test_rbe_reinstall);
+    RUN_TEST(test_rbe_absolute);
+    RUN_TEST(test_rbe_percent);
+    RUN_TEST(test_rbe_signed_bitw);
+    RUN_TEST(test_rbe_internal);
+    RUN_TEST(test_rbe_unmonitored);
+    return UNITY_END();
+}
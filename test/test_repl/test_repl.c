@@ -0,0 +1,234 @@
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/repl.h>
+#include <scaffold.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define ADDR_NORM       0x10
+#define ADDR_PTR        0x11
+#define ADDR_FUNC       0x12
+#define ADDR_NORM2      0x13
+#define ADDR_NORM3      0x14
+
+#define MAX_FRAMES      128
+
+uint8_t frames[MAX_FRAMES][UCDM_REPL_FRAME_LENGTH];
+uint16_t frame_lens[MAX_FRAMES];
+uint8_t nframes;
+
+void sink_capture(const uint8_t * frame, uint16_t len){
+    if (nframes < MAX_FRAMES){
+        memcpy(frames[nframes], frame, len);
+        frame_lens[nframes] = len;
+    }
+    nframes++;
+}
+
+uint16_t ptr_target;
+uint16_t func_value = 0x5A5A;
+
+uint16_t rfunc_value(ucdm_addr_t addr){
+    return func_value;
+}
+
+void configure(void){
+    ucdm_enable_regr(ADDR_NORM);
+    ucdm_enable_regw(ADDR_NORM);
+    ucdm_enable_bitw(ADDR_NORM);
+    ucdm_enable_regr(ADDR_NORM2);
+    ucdm_enable_regw(ADDR_NORM2);
+    ucdm_enable_regr(ADDR_NORM3);
+    ucdm_enable_regw(ADDR_NORM3);
+    ucdm_redirect_regr_ptr(ADDR_PTR, &ptr_target);
+    ucdm_redirect_regw_ptr(ADDR_PTR, &ptr_target);
+    ucdm_redirect_regr_func(ADDR_FUNC, rfunc_value);
+}
+
+static void clear_standby(void){
+    ucdm_register[ADDR_NORM].data = 0;
+    ucdm_register[ADDR_NORM2].data = 0;
+    ptr_target = 0;
+}
+
+static uint8_t apply_all(uint8_t from, uint8_t to){
+    uint8_t rval = UCDM_REPL_APPLIED;
+    for (uint8_t i=from; i < to; i++){
+        rval = ucdm_repl_apply(frames[i], frame_lens[i]);
+        if (rval != UCDM_REPL_APPLIED){
+            break;
+        }
+    }
+    return rval;
+}
+
+void test_repl_batching(void){
+    nframes = 0;
+    ucdm_repl_start(sink_capture);
+    uint8_t nsnapshot = nframes;
+    TEST_ASSERT_EQUAL(UCDM_REPL_FRAME_SNAPSHOT, frames[0][0]);
+    TEST_ASSERT_EQUAL(UCDM_REPL_FLAG_LAST, frames[nsnapshot - 1][1]);
+    
+    // Repeated writes within a batch are coalesced
+    ucdm_set_register(ADDR_NORM, 1);
+    ucdm_set_register(ADDR_NORM, 2);
+    ucdm_set_bit(ADDR_NORM << 4 | 4);
+    // Function registers are not replicated
+    ucdm_set_register(ADDR_FUNC, 3);
+    TEST_ASSERT_EQUAL(nsnapshot, nframes);
+    ucdm_repl_flush();
+    TEST_ASSERT_EQUAL(nsnapshot + 1, nframes);
+    TEST_ASSERT_EQUAL(UCDM_REPL_FRAME_DELTA, frames[nsnapshot][0]);
+    TEST_ASSERT_EQUAL(UCDM_REPL_HEADER_LENGTH + 4 + 2, frame_lens[nsnapshot]);
+    TEST_ASSERT_EQUAL(ADDR_NORM, frames[nsnapshot][8]);
+    TEST_ASSERT_EQUAL_HEX8(0x12, frames[nsnapshot][10]);
+    
+    // A full batch is emitted right away
+    ucdm_set_register(ADDR_NORM, 5);
+    ucdm_set_register(ADDR_NORM2, 6);
+    ucdm_set_register(ADDR_NORM3, 7);
+    ucdm_set_register(ADDR_PTR, 8);
+    TEST_ASSERT_EQUAL(nsnapshot + 2, nframes);
+    ucdm_repl_flush();
+    TEST_ASSERT_EQUAL(nsnapshot + 2, nframes);
+    ucdm_repl_stop();
+}
+
+void test_repl_gap_resync(void){
+    clear_standby();
+    nframes = 0;
+    ucdm_repl_start(sink_capture);
+    uint8_t nsnapshot = nframes;
+    ucdm_set_register(ADDR_NORM, 0x1111);
+    ucdm_repl_flush();
+    ucdm_set_register(ADDR_NORM2, 0x2222);
+    ucdm_repl_flush();
+    ucdm_set_register(ADDR_PTR, 0x3333);
+    ucdm_repl_flush();
+    uint8_t nresync = nframes;
+    ucdm_repl_resync();
+    uint8_t nend = nframes;
+    
+    clear_standby();
+    TEST_ASSERT_EQUAL(0, ucdm_repl_synced());
+    // Deltas are discarded until a snapshot has been received
+    TEST_ASSERT_EQUAL(UCDM_REPL_WAITING, ucdm_repl_apply(frames[nsnapshot], frame_lens[nsnapshot]));
+    TEST_ASSERT_EQUAL(UCDM_REPL_APPLIED, apply_all(0, nsnapshot + 1));
+    TEST_ASSERT_EQUAL(1, ucdm_repl_synced());
+    TEST_ASSERT_EQUAL_HEX16(0x1111, ucdm_register[ADDR_NORM].data);
+    
+    // Lose a frame
+    TEST_ASSERT_EQUAL(UCDM_REPL_GAP, ucdm_repl_apply(frames[nsnapshot + 2], frame_lens[nsnapshot + 2]));
+    TEST_ASSERT_EQUAL(0, ucdm_repl_synced());
+    TEST_ASSERT_EQUAL_HEX16(0, ptr_target);
+    
+    TEST_ASSERT_EQUAL(UCDM_REPL_APPLIED, apply_all(nresync, nend));
+    TEST_ASSERT_EQUAL(1, ucdm_repl_synced());
+    TEST_ASSERT_EQUAL_HEX16(0x2222, ucdm_register[ADDR_NORM2].data);
+    TEST_ASSERT_EQUAL_HEX16(0x3333, ptr_target);
+    
+    // Corrupted frames are rejected
+    ucdm_set_register(ADDR_NORM, 0x4444);
+    ucdm_repl_flush();
+    frames[nframes - 1][9] ^= 0x01;
+    TEST_ASSERT_EQUAL(UCDM_REPL_MALFORMED, ucdm_repl_apply(frames[nframes - 1], frame_lens[nframes - 1]));
+    ucdm_repl_stop();
+}
+
+void test_repl_pipe(void){
+    int fds[2];
+    TEST_ASSERT_EQUAL(0, pipe(fds));
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    
+    ucdm_repl_start_fd(fds[1]);
+    ucdm_set_register(ADDR_NORM, 0xA001);
+    ucdm_set_register(ADDR_PTR, 0xA002);
+    ucdm_set_bit(ADDR_NORM2 << 4 | 15);
+    ucdm_repl_flush();
+    uint16_t expected = ucdm_register[ADDR_NORM2].data;
+    
+    // Bring up the standby from scratch
+    ucdm_init();
+    configure();
+    clear_standby();
+    uint8_t applied = 0;
+    while (ucdm_repl_receive_fd(fds[0]) == UCDM_REPL_APPLIED){
+        applied++;
+    }
+    TEST_ASSERT_NOT_EQUAL(0, applied);
+    TEST_ASSERT_EQUAL(1, ucdm_repl_synced());
+    TEST_ASSERT_EQUAL_HEX16(0xA001, ucdm_register[ADDR_NORM].data);
+    TEST_ASSERT_EQUAL_HEX16(0xA002, ptr_target);
+    TEST_ASSERT_EQUAL_HEX16(expected, ucdm_register[ADDR_NORM2].data);
+    TEST_ASSERT_EQUAL(UCDM_REPL_INCOMPLETE, ucdm_repl_receive_fd(fds[0]));
+    close(fds[0]);
+    close(fds[1]);
+    ucdm_repl_stop();
+}
+
+void test_repl_pipe_partial(void){
+    int fds[2];
+    TEST_ASSERT_EQUAL(0, pipe(fds));
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    
+    nframes = 0;
+    ucdm_repl_start(sink_capture);
+    ucdm_set_register(ADDR_NORM, 0xB001);
+    ucdm_repl_flush();
+    ucdm_repl_stop();
+    TEST_ASSERT_EQUAL(UCDM_REPL_APPLIED, apply_all(0, nframes - 1));
+    clear_standby();
+    
+    // Frames split across reads are reassembled
+    uint8_t * frame = frames[nframes - 1];
+    uint16_t len = frame_lens[nframes - 1];
+    TEST_ASSERT_EQUAL(3, write(fds[1], frame, 3));
+    TEST_ASSERT_EQUAL(UCDM_REPL_INCOMPLETE, ucdm_repl_receive_fd(fds[0]));
+    TEST_ASSERT_EQUAL(7, write(fds[1], frame + 3, 7));
+    TEST_ASSERT_EQUAL(UCDM_REPL_INCOMPLETE, ucdm_repl_receive_fd(fds[0]));
+    TEST_ASSERT_EQUAL(0, ucdm_register[ADDR_NORM].data);
+    TEST_ASSERT_EQUAL(len - 10, write(fds[1], frame + 10, len - 10));
+    TEST_ASSERT_EQUAL(UCDM_REPL_APPLIED, ucdm_repl_receive_fd(fds[0]));
+    TEST_ASSERT_EQUAL_HEX16(0xB001, ucdm_register[ADDR_NORM].data);
+    
+    // A frame with an invalid length ends the stream
+    uint8_t header[UCDM_REPL_HEADER_LENGTH];
+    memcpy(header, frame, UCDM_REPL_HEADER_LENGTH);
+    header[6] = 0xFF;
+    header[7] = 0xFF;
+    TEST_ASSERT_EQUAL(UCDM_REPL_HEADER_LENGTH, write(fds[1], header, UCDM_REPL_HEADER_LENGTH));
+    TEST_ASSERT_EQUAL(UCDM_REPL_MALFORMED, ucdm_repl_receive_fd(fds[0]));
+    TEST_ASSERT_EQUAL(0, ucdm_repl_synced());
+    TEST_ASSERT_EQUAL(-1, fcntl(fds[0], F_GETFD));
+    close(fds[1]);
+}
+
+void test_repl_pipe_write_error(void){
+    int fds[2];
+    uint8_t fill[256] = {0};
+    TEST_ASSERT_EQUAL(0, pipe(fds));
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    while (write(fds[1], fill, sizeof(fill)) > 0);
+    
+    // The snapshot can't be written. The stream is closed and the 
+    // producer stopped rather than left with a torn frame.
+    ucdm_repl_start_fd(fds[1]);
+    TEST_ASSERT_EQUAL(0, ucdm_repl_running());
+    TEST_ASSERT_EQUAL(-1, fcntl(fds[1], F_GETFD));
+    ucdm_set_register(ADDR_NORM, 0xB001);
+    ucdm_repl_flush();
+    close(fds[0]);
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    configure();
+    RUN_TEST(test_repl_batching);
+    RUN_TEST(test_repl_gap_resync);
+    RUN_TEST(test_repl_pipe);
+    RUN_TEST(test_repl_pipe_partial);
+    RUN_TEST(test_repl_pipe_write_error);
+    return UNITY_END();
+}
@@ -0,0 +1,16 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_UCDM_SAMPLER_MAX_CHANNELS
+#define APP_UCDM_SAMPLER_MAX_CHANNELS       5
+#endif
+
+#ifndef APP_UCDM_SAMPLER_DEPTH
+#define APP_UCDM_SAMPLER_DEPTH              3
+#endif
+
+#ifndef APP_UCDM_SAMPLER_FIFO_WINDOW
+#define APP_UCDM_SAMPLER_FIFO_WINDOW        6
+#endif
+
+#include "../include/application.h"
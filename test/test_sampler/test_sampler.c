@@ -0,0 +1,125 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/sampler.h>
+#include <scaffold.h>
+
+#define ADDR_CH_NORM        0x20
+#define ADDR_CH_PTR         0x21
+#define ADDR_CH_FUNC        0x22
+#define ADDR_FIFO           0x30
+
+#define RECLEN              5
+
+uint16_t ptr_target;
+ucdm_tick_t fake_tick;
+
+ucdm_tick_t fake_tick_source(void){
+    return fake_tick;
+}
+
+uint16_t func_target(ucdm_addr_t addr){
+    return (uint16_t)(fake_tick * 2);
+}
+
+void setup(void){
+    ucdm_install_tick_source(fake_tick_source);
+    ucdm_enable_regr(ADDR_CH_NORM);
+    ucdm_redirect_regr_ptr(ADDR_CH_PTR, &ptr_target);
+    ucdm_redirect_regr_func(ADDR_CH_FUNC, func_target);
+    ucdm_sampler_add_channel(ADDR_CH_NORM);
+    ucdm_sampler_add_channel(ADDR_CH_PTR);
+    ucdm_sampler_add_channel(ADDR_CH_FUNC);
+    ucdm_sampler_set_period(100);
+    ucdm_sampler_install_fifo(ADDR_FIFO);
+}
+
+void test_sampler_conf_range(void){
+    TEST_ASSERT_EQUAL(1, ucdm_sampler_add_channel(UCDM_MAX_REGISTERS));
+    TEST_ASSERT_EQUAL(1, ucdm_sampler_install_fifo(UCDM_MAX_REGISTERS - 2));
+}
+
+void test_sampler_poll_period(void){
+    uint16_t records[2 * RECLEN];
+    fake_tick = 1000;
+    ucdm_sampler_start();
+    
+    ucdm_register[ADDR_CH_NORM].data = 0x1111;
+    ptr_target = 0x2222;
+    TEST_ASSERT_EQUAL(1, ucdm_sampler_poll());
+    fake_tick = 1050;
+    TEST_ASSERT_EQUAL(0, ucdm_sampler_poll());
+    
+    fake_tick = 0x10100;
+    ucdm_register[ADDR_CH_NORM].data = 0x3333;
+    TEST_ASSERT_EQUAL(1, ucdm_sampler_poll());
+    ucdm_sampler_stop();
+    fake_tick = 0x20000;
+    TEST_ASSERT_EQUAL(0, ucdm_sampler_poll());
+    
+    TEST_ASSERT_EQUAL(2, ucdm_sampler_available());
+    TEST_ASSERT_EQUAL(2, ucdm_sampler_drain(records, 4));
+    TEST_ASSERT_EQUAL(0, ucdm_sampler_available());
+    
+    TEST_ASSERT_EQUAL_HEX16(1000, records[0]);
+    TEST_ASSERT_EQUAL_HEX16(0, records[1]);
+    TEST_ASSERT_EQUAL_HEX16(0x1111, records[2]);
+    TEST_ASSERT_EQUAL_HEX16(0x2222, records[3]);
+    TEST_ASSERT_EQUAL_HEX16(2000, records[4]);
+
+    TEST_ASSERT_EQUAL_HEX16(0x0100, records[5]);
+    TEST_ASSERT_EQUAL_HEX16(0x0001, records[6]);
+    TEST_ASSERT_EQUAL_HEX16(0x3333, records[7]);
+}
+
+void test_sampler_overrun(void){
+    uint16_t records[RECLEN];
+    for (uint8_t i=0; i < 6; i++){
+        fake_tick = i;
+        ucdm_sampler_trigger();
+    }
+    // 4 records of 5 words fit in the buffer
+    TEST_ASSERT_EQUAL(4, ucdm_sampler_available());
+    TEST_ASSERT_EQUAL(2, ucdm_sampler_overrun);
+    TEST_ASSERT_EQUAL(1, ucdm_sampler_drain(records, 1));
+    TEST_ASSERT_EQUAL(2, records[0]);
+}
+
+void test_sampler_fifo(void){
+    // 3 records left over from the last test. 1 record fits in the window.
+    TEST_ASSERT_EQUAL(3, ucdm_sampler_available());
+    TEST_ASSERT_EQUAL(RECLEN, ucdm_get_register(ADDR_FIFO));
+    TEST_ASSERT_EQUAL(3, ucdm_get_register(ADDR_FIFO + 1));
+    TEST_ASSERT_EQUAL(6, ucdm_get_register(ADDR_FIFO + 1 + 4));
+    
+    TEST_ASSERT_EQUAL(RECLEN, ucdm_get_register(ADDR_FIFO));
+    TEST_ASSERT_EQUAL(4, ucdm_get_register(ADDR_FIFO + 1));
+    TEST_ASSERT_EQUAL(RECLEN, ucdm_get_register(ADDR_FIFO));
+    TEST_ASSERT_EQUAL(5, ucdm_get_register(ADDR_FIFO + 1));
+    
+    TEST_ASSERT_EQUAL(0, ucdm_get_register(ADDR_FIFO));
+}
+
+void test_sampler_fifo_record_fit(void){
+    // A record of 2 + 4 words still fits in the window of 6.
+    TEST_ASSERT_EQUAL(0, ucdm_sampler_add_channel(ADDR_CH_NORM));
+    TEST_ASSERT_EQUAL(3, ucdm_sampler_add_channel(ADDR_CH_PTR));
+    
+    ucdm_init();
+    for (uint8_t i=0; i < 5; i++){
+        TEST_ASSERT_EQUAL(0, ucdm_sampler_add_channel(ADDR_CH_NORM));
+    }
+    TEST_ASSERT_EQUAL(2, ucdm_sampler_install_fifo(ADDR_FIFO));
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_sampler_conf_range);
+    RUN_TEST(test_sampler_poll_period);
+    RUN_TEST(test_sampler_overrun);
+    RUN_TEST(test_sampler_fifo);
+    RUN_TEST(test_sampler_fifo_record_fit);
+    return UNITY_END();
+}
@@ -0,0 +1,118 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/shm.h>
+#include <scaffold.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define ADDR_NORM       0x10
+#define ADDR_PTR        0x11
+#define ADDR_FUNC       0x12
+
+char shm_name[32];
+char shm_path[64];
+uint16_t ptr_target;
+uint16_t func_value;
+uint8_t rfunc_reads;
+
+uint16_t rfunc_value(ucdm_addr_t addr){
+    rfunc_reads++;
+    return func_value;
+}
+
+void setup(void){
+    snprintf(shm_name, sizeof(shm_name), "/ucdm_test_%d", (int)getpid());
+    snprintf(shm_path, sizeof(shm_path), "/tmp/ucdm_test_%d.img", (int)getpid());
+    ucdm_enable_regr(ADDR_NORM);
+    ucdm_enable_regw(ADDR_NORM);
+    ucdm_redirect_regr_ptr(ADDR_PTR, &ptr_target);
+    ucdm_redirect_regw_ptr(ADDR_PTR, &ptr_target);
+    ucdm_redirect_regr_func(ADDR_FUNC, rfunc_value);
+    ucdm_set_register(ADDR_NORM, 0x1111);
+}
+
+void test_shm_open(void){
+    const ucdm_shm_image_t * image;
+    uint16_t value;
+    TEST_ASSERT_NULL(ucdm_shm_attach(shm_name));
+    TEST_ASSERT_EQUAL(0, ucdm_shm_open(shm_name));
+    image = ucdm_shm_attach(shm_name);
+    TEST_ASSERT_NOT_NULL(image);
+    TEST_ASSERT_EQUAL_HEX32(UCDM_SHM_MAGIC, image->magic);
+    TEST_ASSERT_EQUAL(UCDM_MAX_REGISTERS, image->nregs);
+    TEST_ASSERT_EQUAL(0, image->seq & 1);
+    TEST_ASSERT_EQUAL(0, ucdm_shm_snapshot(image, ADDR_NORM, 1, &value));
+    TEST_ASSERT_EQUAL_HEX16(0x1111, value);
+    ucdm_shm_detach(image);
+}
+
+void test_shm_write_through(void){
+    const ucdm_shm_image_t * image = ucdm_shm_attach(shm_name);
+    uint16_t values[2];
+    uint32_t seq = image->seq;
+    ucdm_set_register(ADDR_NORM, 0x2222);
+    ucdm_set_register(ADDR_PTR, 0x3333);
+    TEST_ASSERT_EQUAL(seq + 4, image->seq);
+    TEST_ASSERT_EQUAL(0, ucdm_shm_snapshot(image, ADDR_NORM, 2, values));
+    TEST_ASSERT_EQUAL_HEX16(0x2222, values[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x3333, values[1]);
+    ucdm_shm_detach(image);
+}
+
+void test_shm_publish(void){
+    const ucdm_shm_image_t * image = ucdm_shm_attach(shm_name);
+    uint16_t values[2];
+    ptr_target = 0x4444;
+    func_value = 0x5555;
+    TEST_ASSERT_EQUAL(0, ucdm_shm_snapshot(image, ADDR_PTR, 2, values));
+    TEST_ASSERT_EQUAL_HEX16(0x3333, values[0]);
+    ucdm_shm_publish();
+    TEST_ASSERT_EQUAL(0, ucdm_shm_snapshot(image, ADDR_PTR, 2, values));
+    TEST_ASSERT_EQUAL_HEX16(0x4444, values[0]);
+    // Function-read registers are only published on request
+    TEST_ASSERT_EQUAL_HEX16(0x0000, values[1]);
+    TEST_ASSERT_EQUAL(0, rfunc_reads);
+    TEST_ASSERT_EQUAL(0, ucdm_shm_publish_range(ADDR_FUNC, 1));
+    TEST_ASSERT_EQUAL(1, rfunc_reads);
+    TEST_ASSERT_EQUAL(0, ucdm_shm_snapshot(image, ADDR_PTR, 2, values));
+    TEST_ASSERT_EQUAL_HEX16(0x5555, values[1]);
+    TEST_ASSERT_EQUAL(1, ucdm_shm_publish_range(UCDM_MAX_REGISTERS - 1, 2));
+    ucdm_shm_detach(image);
+}
+
+void test_shm_snapshot_range(void){
+    const ucdm_shm_image_t * image = ucdm_shm_attach(shm_name);
+    uint16_t values[2];
+    TEST_ASSERT_EQUAL(1, ucdm_shm_snapshot(image, UCDM_MAX_REGISTERS - 1, 2, values));
+    ucdm_shm_detach(image);
+    ucdm_shm_close();
+    shm_unlink(shm_name);
+}
+
+void test_shm_file(void){
+    const ucdm_shm_image_t * image;
+    uint16_t value;
+    TEST_ASSERT_EQUAL(0, ucdm_shm_open_file(shm_path));
+    image = ucdm_shm_attach_file(shm_path);
+    TEST_ASSERT_NOT_NULL(image);
+    ucdm_set_register(ADDR_NORM, 0x6666);
+    TEST_ASSERT_EQUAL(0, ucdm_shm_snapshot(image, ADDR_NORM, 1, &value));
+    TEST_ASSERT_EQUAL_HEX16(0x6666, value);
+    ucdm_shm_detach(image);
+    ucdm_shm_close();
+    unlink(shm_path);
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_shm_open);
+    RUN_TEST(test_shm_write_through);
+    RUN_TEST(test_shm_publish);
+    RUN_TEST(test_shm_snapshot_range);
+    RUN_TEST(test_shm_file);
+    return UNITY_END();
+}
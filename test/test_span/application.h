@@ -0,0 +1,12 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_UCDM_SPAN_MAX_COUNT
+#define APP_UCDM_SPAN_MAX_COUNT             8
+#endif
+
+#ifndef APP_UCDM_SPAN_TIMEOUT
+#define APP_UCDM_SPAN_TIMEOUT               100
+#endif
+
+#include "../include/application.h"
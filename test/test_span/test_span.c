@@ -0,0 +1,211 @@
+
+#include <unity.h>
+#include <string.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/span.h>
+#include <scaffold.h>
+
+#define ADDR_SPANR_CDAB     0x20
+#define ADDR_SPANR_ABCD     0x22
+#define ADDR_SPANR_DCBA     0x24
+#define ADDR_SPANR_BADC     0x26
+#define ADDR_SPANR_64       0x28
+#define ADDR_SPANW_CDAB     0x30
+#define ADDR_SPANW_BADC     0x32
+#define ADDR_SPANW_64       0x34
+
+uint32_t read_source = 0xAABBCCDD;
+uint64_t read_source_64 = 0x1122334455667788;
+
+ucdm_addr_t written_addr;
+uint32_t written_value;
+uint64_t written_value_64;
+
+ucdm_tick_t fake_tick;
+
+ucdm_tick_t fake_tick_source(void){
+    return fake_tick;
+}
+
+void span_write_32(ucdm_addr_t addr, void * param){
+    written_addr = addr;
+    memcpy(&written_value, param, sizeof(written_value));
+}
+
+void span_write_64(ucdm_addr_t addr, void * param){
+    written_addr = addr;
+    memcpy(&written_value_64, param, sizeof(written_value_64));
+}
+
+void setup(void){
+    ucdm_install_tick_source(fake_tick_source);
+    ucdm_redirect_spanr_buf(ADDR_SPANR_CDAB, &read_source, 4);
+    ucdm_redirect_spanr_buf(ADDR_SPANR_ABCD, &read_source, 4);
+    ucdm_set_span_order(ADDR_SPANR_ABCD, UCDM_SPAN_ORDER_ABCD);
+    ucdm_redirect_spanr_buf(ADDR_SPANR_DCBA, &read_source, 4);
+    ucdm_set_span_order(ADDR_SPANR_DCBA, UCDM_SPAN_ORDER_DCBA);
+    ucdm_redirect_spanr_buf(ADDR_SPANR_BADC, &read_source, 4);
+    ucdm_set_span_order(ADDR_SPANR_BADC, UCDM_SPAN_ORDER_BADC);
+    ucdm_redirect_spanr_buf(ADDR_SPANR_64, &read_source_64, 8);
+    ucdm_set_span_order(ADDR_SPANR_64, UCDM_SPAN_ORDER_ABCD);
+
+    ucdm_redirect_spanw_func(ADDR_SPANW_CDAB, 4, span_write_32);
+    ucdm_redirect_spanw_func(ADDR_SPANW_BADC, 4, span_write_32);
+    ucdm_set_span_order(ADDR_SPANW_BADC, UCDM_SPAN_ORDER_BADC);
+    ucdm_redirect_spanw_func(ADDR_SPANW_64, 8, span_write_64);
+    ucdm_set_span_order(ADDR_SPANW_64, UCDM_SPAN_ORDER_ABCD);
+}
+
+void test_span_conf(void){
+    TEST_ASSERT_EQUAL(2, ucdm_redirect_spanr_buf(0x40, &read_source, 3));
+    TEST_ASSERT_EQUAL(2, ucdm_redirect_spanr_buf(0x40, &read_source, 2));
+    TEST_ASSERT_EQUAL(2, ucdm_redirect_spanr_buf(0x40, &read_source, 2 * UCDM_SPAN_MAX_LENGTH + 2));
+    TEST_ASSERT_EQUAL(1, ucdm_redirect_spanr_buf(UCDM_MAX_REGISTERS - 1, &read_source, 4));
+    TEST_ASSERT_EQUAL(1, ucdm_redirect_spanw_func(UCDM_MAX_REGISTERS - 1, 4, span_write_32));
+    TEST_ASSERT_EQUAL(1, ucdm_set_span_order(0x40, UCDM_SPAN_ORDER_ABCD));
+    // Read and write spans may not share registers
+    TEST_ASSERT_EQUAL(4, ucdm_redirect_spanw_func(ADDR_SPANR_CDAB, 4, span_write_32));
+    TEST_ASSERT_EQUAL(4, ucdm_redirect_spanr_buf(ADDR_SPANW_CDAB + 1, &read_source, 4));
+}
+
+void test_span_read_orders(void){
+    TEST_ASSERT_EQUAL_HEX16(0xCCDD, ucdm_get_register(ADDR_SPANR_CDAB));
+    TEST_ASSERT_EQUAL_HEX16(0xAABB, ucdm_get_register(ADDR_SPANR_CDAB + 1));
+    TEST_ASSERT_EQUAL_HEX16(0xAABB, ucdm_get_register(ADDR_SPANR_ABCD));
+    TEST_ASSERT_EQUAL_HEX16(0xCCDD, ucdm_get_register(ADDR_SPANR_ABCD + 1));
+    TEST_ASSERT_EQUAL_HEX16(0xDDCC, ucdm_get_register(ADDR_SPANR_DCBA));
+    TEST_ASSERT_EQUAL_HEX16(0xBBAA, ucdm_get_register(ADDR_SPANR_DCBA + 1));
+    TEST_ASSERT_EQUAL_HEX16(0xBBAA, ucdm_get_register(ADDR_SPANR_BADC));
+    TEST_ASSERT_EQUAL_HEX16(0xDDCC, ucdm_get_register(ADDR_SPANR_BADC + 1));
+}
+
+void test_span_read_64(void){
+    TEST_ASSERT_EQUAL_HEX16(0x1122, ucdm_get_register(ADDR_SPANR_64));
+    TEST_ASSERT_EQUAL_HEX16(0x3344, ucdm_get_register(ADDR_SPANR_64 + 1));
+    TEST_ASSERT_EQUAL_HEX16(0x5566, ucdm_get_register(ADDR_SPANR_64 + 2));
+    TEST_ASSERT_EQUAL_HEX16(0x7788, ucdm_get_register(ADDR_SPANR_64 + 3));
+}
+
+void test_span_read_snapshot(void){
+    // The value is captured when the first register is read
+    read_source = 0xAABBCCDD;
+    TEST_ASSERT_EQUAL_HEX16(0xCCDD, ucdm_get_register(ADDR_SPANR_CDAB));
+    read_source = 0x11223344;
+    TEST_ASSERT_EQUAL_HEX16(0xAABB, ucdm_get_register(ADDR_SPANR_CDAB + 1));
+    read_source = 0xAABBCCDD;
+}
+
+void test_span_write_orders(void){
+    written_addr = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_SPANW_CDAB, 0xCCDD));
+    TEST_ASSERT_EQUAL(0, written_addr);
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_SPANW_CDAB + 1, 0xAABB));
+    TEST_ASSERT_EQUAL(ADDR_SPANW_CDAB, written_addr);
+    TEST_ASSERT_EQUAL_HEX32(0xAABBCCDD, written_value);
+
+    ucdm_set_register(ADDR_SPANW_BADC, 0x2211);
+    ucdm_set_register(ADDR_SPANW_BADC + 1, 0x4433);
+    TEST_ASSERT_EQUAL(ADDR_SPANW_BADC, written_addr);
+    TEST_ASSERT_EQUAL_HEX32(0x11223344, written_value);
+}
+
+void test_span_write_64(void){
+    ucdm_set_register(ADDR_SPANW_64, 0x1122);
+    ucdm_set_register(ADDR_SPANW_64 + 1, 0x3344);
+    ucdm_set_register(ADDR_SPANW_64 + 2, 0x5566);
+    ucdm_set_register(ADDR_SPANW_64 + 3, 0x7788);
+    TEST_ASSERT_EQUAL(ADDR_SPANW_64, written_addr);
+    TEST_ASSERT_EQUAL_UINT64(0x1122334455667788, written_value_64);
+}
+
+void test_span_write_out_of_order(void){
+    written_addr = 0;
+    ucdm_set_register(ADDR_SPANW_64 + 0, 0x1122);
+    ucdm_set_register(ADDR_SPANW_64 + 2, 0x5566);
+    ucdm_set_register(ADDR_SPANW_64 + 3, 0x7788);
+    TEST_ASSERT_EQUAL(0, written_addr);
+    ucdm_set_register(ADDR_SPANW_64 + 1, 0x3344);
+    TEST_ASSERT_EQUAL(ADDR_SPANW_64, written_addr);
+    TEST_ASSERT_EQUAL_UINT64(0x1122334455667788, written_value_64);
+}
+
+void test_span_write_timeout(void){
+    uint16_t dropped = ucdm_span_dropped;
+    written_addr = 0;
+    fake_tick = 1000;
+    ucdm_set_register(ADDR_SPANW_CDAB + 1, 0x1111);
+    fake_tick = 1101;
+    // The stale high word is dropped, and this starts a new transaction
+    ucdm_set_register(ADDR_SPANW_CDAB, 0x4444);
+    TEST_ASSERT_EQUAL(0, written_addr);
+    TEST_ASSERT_EQUAL(dropped + 1, ucdm_span_dropped);
+    fake_tick = 1150;
+    ucdm_set_register(ADDR_SPANW_CDAB + 1, 0x3333);
+    TEST_ASSERT_EQUAL(ADDR_SPANW_CDAB, written_addr);
+    TEST_ASSERT_EQUAL_HEX32(0x33334444, written_value);
+}
+
+void test_span_write_abort(void){
+    written_addr = 0;
+    ucdm_set_register(ADDR_SPANW_CDAB, 0x1111);
+    TEST_ASSERT_EQUAL(0, ucdm_span_abort(ADDR_SPANW_CDAB));
+    TEST_ASSERT_EQUAL(1, ucdm_span_abort(ADDR_SPANW_CDAB + 1));
+    ucdm_set_register(ADDR_SPANW_CDAB + 1, 0x2222);
+    TEST_ASSERT_EQUAL(0, written_addr);
+    ucdm_span_abort(ADDR_SPANW_CDAB);
+}
+
+void test_span_write_restart(void){
+    uint16_t dropped = ucdm_span_dropped;
+    written_addr = 0;
+    fake_tick = 2000;
+    // A partial write is discarded when the next write starts over
+    ucdm_set_register(ADDR_SPANW_64 + 0, 0x1111);
+    ucdm_set_register(ADDR_SPANW_64 + 1, 0x2222);
+    ucdm_set_register(ADDR_SPANW_64 + 0, 0x1122);
+    TEST_ASSERT_EQUAL(dropped + 1, ucdm_span_dropped);
+    ucdm_set_register(ADDR_SPANW_64 + 1, 0x3344);
+    ucdm_set_register(ADDR_SPANW_64 + 2, 0x5566);
+    ucdm_set_register(ADDR_SPANW_64 + 3, 0x7788);
+    TEST_ASSERT_EQUAL(ADDR_SPANW_64, written_addr);
+    TEST_ASSERT_EQUAL_UINT64(0x1122334455667788, written_value_64);
+    TEST_ASSERT_EQUAL(dropped + 1, ucdm_span_dropped);
+
+    // The tail of a partial write does not leak into the next one
+    written_addr = 0;
+    ucdm_set_register(ADDR_SPANW_64 + 2, 0xAAAA);
+    ucdm_set_register(ADDR_SPANW_64 + 3, 0xBBBB);
+    ucdm_set_register(ADDR_SPANW_64 + 0, 0x1122);
+    TEST_ASSERT_EQUAL(dropped + 2, ucdm_span_dropped);
+    ucdm_set_register(ADDR_SPANW_64 + 1, 0x3344);
+    TEST_ASSERT_EQUAL(0, written_addr);
+    ucdm_set_register(ADDR_SPANW_64 + 2, 0x5566);
+    ucdm_set_register(ADDR_SPANW_64 + 3, 0x7788);
+    TEST_ASSERT_EQUAL(ADDR_SPANW_64, written_addr);
+    TEST_ASSERT_EQUAL_UINT64(0x1122334455667788, written_value_64);
+
+    // A repeated word also starts a new transaction
+    written_addr = 0;
+    ucdm_set_register(ADDR_SPANW_CDAB + 1, 0x1111);
+    ucdm_set_register(ADDR_SPANW_CDAB + 1, 0xAABB);
+    TEST_ASSERT_EQUAL(dropped + 3, ucdm_span_dropped);
+    TEST_ASSERT_EQUAL(0, written_addr);
+    ucdm_span_abort(ADDR_SPANW_CDAB);
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_span_conf);
+    RUN_TEST(test_span_read_orders);
+    RUN_TEST(test_span_read_64);
+    RUN_TEST(test_span_read_snapshot);
+    RUN_TEST(test_span_write_orders);
+    RUN_TEST(test_span_write_64);
+    RUN_TEST(test_span_write_out_of_order);
+    RUN_TEST(test_span_write_timeout);
+    RUN_TEST(test_span_write_abort);
+    RUN_TEST(test_span_write_restart);
+    return UNITY_END();
+}
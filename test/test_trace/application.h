@@ -0,0 +1,8 @@
+
+// Configuration local to this test, on top of the common test configuration.
+
+#ifndef APP_UCDM_TRACE_DEPTH
+#define APP_UCDM_TRACE_DEPTH                8
+#endif
+
+#include "../include/application.h"
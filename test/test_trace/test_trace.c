@@ -0,0 +1,122 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/trace.h>
+#include <scaffold.h>
+
+#define ADDR_TRACE_RW       0x20
+#define ADDR_TRACE_RO       0x21
+
+ucdm_tick_t fake_tick;
+
+ucdm_tick_t fake_tick_source(void){
+    return fake_tick;
+}
+
+void setup(void){
+    ucdm_install_tick_source(fake_tick_source);
+    ucdm_enable_regr(ADDR_TRACE_RW);
+    ucdm_enable_regw(ADDR_TRACE_RW);
+    ucdm_enable_bitw(ADDR_TRACE_RW);
+    ucdm_enable_regr(ADDR_TRACE_RO);
+}
+
+void test_trace_disarmed(void){
+    ucdm_set_register(ADDR_TRACE_RW, 0x1234);
+    ucdm_get_register(ADDR_TRACE_RW);
+    TEST_ASSERT_EQUAL(0, ucdm_trace_available());
+}
+
+void test_trace_accesses(void){
+    ucdm_trace_record_t records[8];
+    ucdm_trace_enable(1);
+    fake_tick = 100;
+    ucdm_set_register(ADDR_TRACE_RW, 0x00F0);
+    fake_tick = 101;
+    ucdm_set_register(ADDR_TRACE_RO, 0x1111);
+    fake_tick = 102;
+    ucdm_get_register(ADDR_TRACE_RW);
+    fake_tick = 103;
+    ucdm_set_bit(ADDR_TRACE_RW << 4 | 1);
+    fake_tick = 104;
+    ucdm_clear_bit(ADDR_TRACE_RW << 4 | 4);
+    fake_tick = 105;
+    ucdm_get_bit(ADDR_TRACE_RW << 4 | 1);
+    ucdm_trace_enable(0);
+
+    TEST_ASSERT_EQUAL(6, ucdm_trace_available());
+    TEST_ASSERT_EQUAL(6, ucdm_trace_dump(records, 8));
+    TEST_ASSERT_EQUAL(0, ucdm_trace_available());
+
+    TEST_ASSERT_EQUAL(UCDM_TRACE_OP_REGW, records[0].op);
+    TEST_ASSERT_EQUAL(ADDR_TRACE_RW, records[0].addr);
+    TEST_ASSERT_EQUAL_HEX16(0x00F0, records[0].value);
+    TEST_ASSERT_EQUAL(0, records[0].result);
+    TEST_ASSERT_EQUAL(100, records[0].tick);
+
+    TEST_ASSERT_EQUAL(UCDM_TRACE_OP_REGW, records[1].op);
+    TEST_ASSERT_EQUAL(2, records[1].result);
+    TEST_ASSERT_EQUAL(records[0].seq + 1, records[1].seq);
+
+    TEST_ASSERT_EQUAL(UCDM_TRACE_OP_REGR, records[2].op);
+    TEST_ASSERT_EQUAL_HEX16(0x00F0, records[2].value);
+
+    TEST_ASSERT_EQUAL(UCDM_TRACE_OP_BITS, records[3].op);
+    TEST_ASSERT_EQUAL_HEX16(0x0002, records[3].value);
+    TEST_ASSERT_EQUAL(UCDM_TRACE_OP_BITC, records[4].op);
+    TEST_ASSERT_EQUAL_HEX16(0x0010, records[4].value);
+    TEST_ASSERT_EQUAL(UCDM_TRACE_OP_BITR, records[5].op);
+    TEST_ASSERT_EQUAL(0xFF, records[5].result);
+    TEST_ASSERT_EQUAL(105, records[5].tick);
+}
+
+void test_trace_overflow(void){
+    ucdm_trace_record_t records[8];
+    uint16_t dropped = ucdm_trace_dropped;
+    ucdm_trace_enable(1);
+    for (uint8_t i=0; i < 10; i++){
+        ucdm_get_register(ADDR_TRACE_RO);
+    }
+    ucdm_trace_enable(0);
+    TEST_ASSERT_EQUAL(8, ucdm_trace_available());
+    TEST_ASSERT_EQUAL(dropped + 2, ucdm_trace_dropped);
+    TEST_ASSERT_EQUAL(3, ucdm_trace_dump(records, 3));
+    TEST_ASSERT_EQUAL(5, ucdm_trace_dump(records, 8));
+    TEST_ASSERT_EQUAL(0, ucdm_trace_dump(records, 8));
+}
+
+void test_trace_wire(void){
+    ucdm_trace_record_t record = {
+        .tick = 0x12345678, .seq = 0xABCD, .addr = 0x0102, 
+        .value = 0xBEEF, .op = UCDM_TRACE_OP_REGW, .result = 2
+    };
+    ucdm_trace_record_t decoded;
+    uint8_t buf[UCDM_TRACE_WIRE_LENGTH];
+    char text[64];
+    ucdm_trace_pack(&record, buf);
+    TEST_ASSERT_EQUAL_HEX8(0x78, buf[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xCD, buf[4]);
+    TEST_ASSERT_EQUAL_HEX8(0xEF, buf[8]);
+    ucdm_trace_unpack(buf, &decoded);
+    TEST_ASSERT_EQUAL_HEX32(record.tick, decoded.tick);
+    TEST_ASSERT_EQUAL_HEX16(record.seq, decoded.seq);
+    TEST_ASSERT_EQUAL_HEX16(record.addr, decoded.addr);
+    TEST_ASSERT_EQUAL_HEX16(record.value, decoded.value);
+    TEST_ASSERT_EQUAL(record.op, decoded.op);
+    TEST_ASSERT_EQUAL(record.result, decoded.result);
+    #ifdef PIO_NATIVE
+    ucdm_trace_format(&decoded, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING(" 305419896 43981 REGW 0x0102 0xBEEF 2", text);
+    #endif
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_trace_disarmed);
+    RUN_TEST(test_trace_accesses);
+    RUN_TEST(test_trace_overflow);
+    RUN_TEST(test_trace_wire);
+    return UNITY_END();
+}
@@ -0,0 +1,86 @@
+
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/value.hpp>
+#include <scaffold.h>
+
+#define ADDR_VALUE_LE       0x20
+#define ADDR_VALUE_BE       0x24
+#define ADDR_VALUE_FLOAT    0x28
+#define ADDR_VALUE_RO       0x2A
+
+#define EXAMPLE_VALUE   0x5678901234567890
+#define EXAMPLE_INPUT   0x9876543210987654
+
+ucdm::value<int64_t, ADDR_VALUE_LE> value_le;
+ucdm::value<uint64_t, ADDR_VALUE_BE, ucdm::WordOrder::BigEndian> value_be;
+ucdm::value<float, ADDR_VALUE_FLOAT> value_float;
+ucdm::value<uint32_t, ADDR_VALUE_RO> value_ro(0x12345678);
+
+void setup(void){
+    value_le.bind();
+    value_be.bind();
+    value_float.bind();
+    value_ro.bind_read();
+}
+
+void test_value_layout(void){
+    TEST_ASSERT_EQUAL(ADDR_VALUE_LE, value_le.address);
+    TEST_ASSERT_EQUAL(4, value_le.length);
+    TEST_ASSERT_EQUAL(2, value_float.length);
+}
+
+void test_value_read_le(void){
+    value_le = EXAMPLE_VALUE;
+    TEST_ASSERT_EQUAL_HEX16(0x7890, ucdm_get_register(ADDR_VALUE_LE + 0));
+    TEST_ASSERT_EQUAL_HEX16(0x3456, ucdm_get_register(ADDR_VALUE_LE + 1));
+    TEST_ASSERT_EQUAL_HEX16(0x9012, ucdm_get_register(ADDR_VALUE_LE + 2));
+    TEST_ASSERT_EQUAL_HEX16(0x5678, ucdm_get_register(ADDR_VALUE_LE + 3));
+    TEST_ASSERT_EQUAL_HEX16(0x5678, value_le.word<3>());
+}
+
+void test_value_read_be(void){
+    value_be = EXAMPLE_VALUE;
+    TEST_ASSERT_EQUAL_HEX16(0x5678, ucdm_get_register(ADDR_VALUE_BE + 0));
+    TEST_ASSERT_EQUAL_HEX16(0x9012, ucdm_get_register(ADDR_VALUE_BE + 1));
+    TEST_ASSERT_EQUAL_HEX16(0x3456, ucdm_get_register(ADDR_VALUE_BE + 2));
+    TEST_ASSERT_EQUAL_HEX16(0x7890, ucdm_get_register(ADDR_VALUE_BE + 3));
+    TEST_ASSERT_EQUAL_HEX16(0x5678, value_be.word<0>());
+}
+
+void test_value_write(void){
+    uint64_t source = EXAMPLE_INPUT;
+    for (uint8_t i=0; i < 4; i++){
+        ucdm_set_register(ADDR_VALUE_LE + i, source & 0xFFFF);
+        ucdm_set_register(ADDR_VALUE_BE + 3 - i, source & 0xFFFF);
+        source = source >> 16;
+    }
+    TEST_ASSERT_EQUAL_INT64((int64_t)EXAMPLE_INPUT, value_le.get());
+    TEST_ASSERT_EQUAL_UINT64(EXAMPLE_INPUT, (uint64_t)value_be);
+}
+
+void test_value_float(void){
+    // 1.5f is 0x3FC00000
+    ucdm_set_register(ADDR_VALUE_FLOAT, 0x0000);
+    ucdm_set_register(ADDR_VALUE_FLOAT + 1, 0x3FC0);
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, (float)value_float);
+}
+
+void test_value_readonly(void){
+    TEST_ASSERT_EQUAL_HEX16(0x5678, ucdm_get_register(ADDR_VALUE_RO));
+    TEST_ASSERT_EQUAL(2, ucdm_set_register(ADDR_VALUE_RO, 0x0000));
+    TEST_ASSERT_EQUAL_HEX32(0x12345678, value_ro.get());
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_value_layout);
+    RUN_TEST(test_value_read_le);
+    RUN_TEST(test_value_read_be);
+    RUN_TEST(test_value_write);
+    RUN_TEST(test_value_float);
+    RUN_TEST(test_value_readonly);
+    return UNITY_END();
+}
@@ -0,0 +1,109 @@
+#include <unity.h>
+#include <ucdm/ucdm.h>
+#include <ucdm/view.h>
+#include <scaffold.h>
+
+#define ADDR_WINDOW     0x80
+#define ADDR_A          0x10
+#define ADDR_B          0x25
+#define ADDR_RO         0x31
+#define ADDR_FLAGS      0x40
+
+const uint32_t dashboard[] = {
+    UCDM_VIEW_REG(ADDR_B),
+    UCDM_VIEW_REG(ADDR_A),
+    UCDM_VIEW_BIT(ADDR_FLAGS << 4 | 3),
+    UCDM_VIEW_REG(ADDR_RO),
+};
+
+#define DASHBOARD_COUNT     (sizeof(dashboard) / sizeof(dashboard[0]))
+
+uint8_t rwh_calls;
+
+void rwh_counting(ucdm_addr_t addr){
+    rwh_calls++;
+}
+
+avlt_node_t rwh_node;
+
+void setup(void){
+    ucdm_enable_regr(ADDR_A);
+    ucdm_enable_regw(ADDR_A);
+    ucdm_enable_regr(ADDR_B);
+    ucdm_enable_regw(ADDR_B);
+    ucdm_enable_regr(ADDR_RO);
+    ucdm_enable_regr(ADDR_FLAGS);
+    ucdm_enable_regw(ADDR_FLAGS);
+    ucdm_enable_bitw(ADDR_FLAGS);
+    ucdm_install_regw_handler(ADDR_A, &rwh_node, rwh_counting);
+    TEST_ASSERT_EQUAL(0, ucdm_install_view(ADDR_WINDOW, DASHBOARD_COUNT, dashboard));
+}
+
+void test_view_install(void){
+    const uint32_t into_window[] = {UCDM_VIEW_REG(ADDR_WINDOW + 1)};
+    const uint32_t out_of_range[] = {UCDM_VIEW_BIT(UCDM_MAX_BITS)};
+    TEST_ASSERT_EQUAL(1, ucdm_install_view(UCDM_MAX_REGISTERS - 1, 2, dashboard));
+    TEST_ASSERT_EQUAL(2, ucdm_install_view(0x90, 0, dashboard));
+    TEST_ASSERT_EQUAL(2, ucdm_install_view(0x90, 1, into_window));
+    TEST_ASSERT_EQUAL(2, ucdm_install_view(0x90, 1, out_of_range));
+    // A window may not cover registers other views stand in for
+    TEST_ASSERT_EQUAL(2, ucdm_install_view(ADDR_A, 1, dashboard));
+    // nor overlap the window of another view
+    TEST_ASSERT_EQUAL(2, ucdm_install_view(ADDR_WINDOW + 2, DASHBOARD_COUNT, dashboard));
+    TEST_ASSERT_EQUAL(2, ucdm_install_view(ADDR_WINDOW - 1, 2, dashboard));
+    TEST_ASSERT_EQUAL(0, ucdm_install_view(ADDR_WINDOW - 1, 1, dashboard));
+    TEST_ASSERT_EQUAL(1, ucdm_range_readable(ADDR_WINDOW, DASHBOARD_COUNT));
+    TEST_ASSERT_EQUAL(1, ucdm_range_writable(ADDR_WINDOW, DASHBOARD_COUNT));
+}
+
+void test_view_read(void){
+    uint16_t values[DASHBOARD_COUNT + 1];
+    ucdm_register[ADDR_A].data = 0xAAAA;
+    ucdm_register[ADDR_B].data = 0xBBBB;
+    ucdm_register[ADDR_RO].data = 0x1234;
+    ucdm_register[ADDR_FLAGS].data = 1 << 3;
+    TEST_ASSERT_EQUAL(0, ucdm_get_registers(ADDR_WINDOW, DASHBOARD_COUNT, values));
+    TEST_ASSERT_EQUAL_HEX16(0xBBBB, values[0]);
+    TEST_ASSERT_EQUAL_HEX16(0xAAAA, values[1]);
+    TEST_ASSERT_EQUAL_HEX16(1, values[2]);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, values[3]);
+    
+    ucdm_register[ADDR_FLAGS].data = 0;
+    TEST_ASSERT_EQUAL_HEX16(0, ucdm_get_register(ADDR_WINDOW + 2));
+    TEST_ASSERT_EQUAL_HEX16(0xAAAA, ucdm_get_register(ADDR_WINDOW + 1));
+    
+    // Reads spanning past the end of the window
+    TEST_ASSERT_EQUAL(0, ucdm_get_registers(ADDR_WINDOW + 3, 2, values));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, values[0]);
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, values[1]);
+}
+
+void test_view_write(void){
+    const uint16_t values[] = {0x1111, 0x2222, 0x0001};
+    rwh_calls = 0;
+    TEST_ASSERT_EQUAL(0, ucdm_set_registers(ADDR_WINDOW, 3, values));
+    TEST_ASSERT_EQUAL_HEX16(0x1111, ucdm_register[ADDR_B].data);
+    TEST_ASSERT_EQUAL_HEX16(0x2222, ucdm_register[ADDR_A].data);
+    TEST_ASSERT_EQUAL_HEX16(1 << 3, ucdm_register[ADDR_FLAGS].data);
+    // Handlers of the underlying register run
+    TEST_ASSERT_EQUAL(1, rwh_calls);
+    
+    TEST_ASSERT_EQUAL(0, ucdm_set_register(ADDR_WINDOW + 2, 0));
+    TEST_ASSERT_EQUAL_HEX16(0, ucdm_register[ADDR_FLAGS].data);
+    
+    // Permissions of the underlying register apply
+    TEST_ASSERT_EQUAL(2, ucdm_set_register(ADDR_WINDOW + 3, 5));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, ucdm_register[ADDR_RO].data);
+    const uint16_t more[] = {0x3333, 0x4444};
+    TEST_ASSERT_EQUAL(2, ucdm_set_registers(ADDR_WINDOW + 2, 2, more));
+}
+
+int main(void) {
+    init();
+    UNITY_BEGIN();
+    setup();
+    RUN_TEST(test_view_install);
+    RUN_TEST(test_view_read);
+    RUN_TEST(test_view_write);
+    return UNITY_END();
+}